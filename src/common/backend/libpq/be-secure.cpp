@@ -51,6 +51,7 @@
 #include "knl/knl_variable.h"
 
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #ifdef HAVE_NETINET_TCP_H
 #include <netinet/tcp.h>
@@ -415,6 +416,45 @@ ssize_t secure_write(Port* port, void* ptr, size_t len)
     return n;
 }
 
+/*
+ *  Gather-write data to a connection.
+ *
+ *  Plain TCP connections send all of iov with a single writev(); SSL, logic
+ *  and stream connections have no gather-write primitive, so we fall back to
+ *  secure_write() of the first non-empty element.  Either way the return
+ *  value is the number of bytes written from the start of iov, or -1, so
+ *  callers have to be prepared for partial writes.
+ */
+ssize_t secure_writev(Port* port, struct iovec* iov, int iovcnt)
+{
+    ssize_t n;
+    int i;
+
+    for (i = 0; i < iovcnt && iov[i].iov_len == 0; i++);
+    if (i == iovcnt)
+        return 0;
+
+#ifdef USE_SSL
+    if (port->ssl != NULL)
+        return secure_write(port, iov[i].iov_base, iov[i].iov_len);
+#endif
+    if (StreamThreadAmI() || port->is_logic_conn)
+        return secure_write(port, iov[i].iov_base, iov[i].iov_len);
+
+    StreamTimeSendStart(t_thrd.pgxc_cxt.GlobalNetInstr);
+    PGSTAT_INIT_TIME_RECORD();
+    PGSTAT_START_TIME_RECORD();
+    n = writev(port->sock, iov + i, iovcnt - i);
+    PGSTAT_END_TIME_RECORD(NET_SEND_TIME);
+
+    /* for log printing, send message; only the first element is accounted */
+    IPC_PERFORMANCE_LOG_COLLECT(port->msgLog, iov[i].iov_base, Min(n, (ssize_t)iov[i].iov_len), port->remote_hostname,
+        NULL, SECURE_WRITE);
+    StreamTimeSendEnd(t_thrd.pgxc_cxt.GlobalNetInstr);
+
+    return n;
+}
+
 /* ------------------------------------------------------------ */
 /*                        SSL specific code                     */
 /* ------------------------------------------------------------ */
@@ -134,6 +134,8 @@ void pq_close(int code, Datum arg);
 /* Internal functions */
 static int internal_putbytes(const char* s, size_t len);
 static int internal_flush(void);
+static int internal_flush_with(const char* extra, size_t extralen);
+static int internal_put_pending_rows(void);
 static void pq_set_nonblocking(bool nonblocking);
 static void pq_disk_generate_checking_header(
     const char* src_data, StringInfo dest_data, uint32 data_len, uint32 seq_num);
@@ -462,6 +464,9 @@ void pq_comm_reset(void)
 {
     /* Do not throw away pending data, but do reset the busy flag */
     t_thrd.libpq_cxt.PqCommBusy = false;
+    /* Rows produced before an error still go out ahead of the error report */
+    (void)internal_put_pending_rows();
+    t_thrd.libpq_cxt.PqPendingRows = NULL;
     /* We can abort any old-style COPY OUT, too */
     pq_endcopyout(true);
 }
@@ -1622,6 +1627,7 @@ int pq_flush(void)
     }
     t_thrd.libpq_cxt.PqCommBusy = true;
     pq_set_nonblocking(false);
+    (void)internal_put_pending_rows();
 
     if (t_thrd.libpq_cxt.save_query_result_to_disk &&
         (t_thrd.libpq_cxt.PqTempFileContextInfo->file_state == TEMPFILE_FLUSHED)) {
@@ -1656,6 +1662,20 @@ int pq_flush(void)
  * --------------------------------
  */
 static int internal_flush(void)
+{
+    return internal_flush_with(NULL, 0);
+}
+
+/* --------------------------------
+ *		internal_flush_with - flush pending output followed by extra data
+ *
+ * The send buffer and extra are handed to the kernel together with
+ * secure_writev(), so a large block of messages goes out without first being
+ * copied through the send buffer.  extra is only allowed in blocking mode,
+ * since we have nowhere to keep an unsent tail of it.
+ * --------------------------------
+ */
+static int internal_flush_with(const char* extra, size_t extralen)
 {
     static THR_LOCAL int last_reported_send_errno = 0;
 
@@ -1674,10 +1694,20 @@ static int internal_flush(void)
             global_node_definition ? global_node_definition->num_nodes : -1);
     }
 
-    while (bufptr < bufend) {
+    while (bufptr < bufend || extralen > 0) {
         int r;
 
-        r = secure_write(u_sess->proc_cxt.MyProcPort, bufptr, bufend - bufptr);
+        if (extralen == 0) {
+            r = secure_write(u_sess->proc_cxt.MyProcPort, bufptr, bufend - bufptr);
+        } else {
+            struct iovec iov[2];
+
+            iov[0].iov_base = bufptr;
+            iov[0].iov_len = bufend - bufptr;
+            iov[1].iov_base = (void*)extra;
+            iov[1].iov_len = extralen;
+            r = secure_writev(u_sess->proc_cxt.MyProcPort, iov, 2);
+        }
         if (unlikely(r == 0 && (StreamThreadAmI() == true || u_sess->proc_cxt.MyProcPort->is_logic_conn))) {
             /* Stop query when cancel happend */
             if (t_thrd.int_cxt.QueryCancelPending) {
@@ -1710,6 +1740,9 @@ static int internal_flush(void)
              * non-blocking mode.
              */
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (extralen > 0) {
+                    continue; /* blocking mode only, see above */
+                }
                 (void)pgstat_report_waitstatus(oldStatus);
                 return 0;
             }
@@ -1754,8 +1787,15 @@ static int internal_flush(void)
         }
 
         last_reported_send_errno = 0; /* reset after any successful send */
-        bufptr += r;
-        t_thrd.libpq_cxt.PqSendStart += r;
+        if (bufptr < bufend) {
+            int sent = Min(r, (int)(bufend - bufptr));
+
+            bufptr += sent;
+            t_thrd.libpq_cxt.PqSendStart += sent;
+            r -= sent;
+        }
+        extra += r;
+        extralen -= r;
     }
 
     t_thrd.libpq_cxt.PqSendStart = t_thrd.libpq_cxt.PqSendPointer = 0;
@@ -1911,6 +1951,9 @@ int pq_putmessage(char msgtype, const char* s, size_t len)
         return 0;
     }
     t_thrd.libpq_cxt.PqCommBusy = true;
+    if (internal_put_pending_rows()) {
+        goto fail;
+    }
     if (msgtype) {
         if (internal_putbytes(&msgtype, 1)) {
             goto fail;
@@ -1935,6 +1978,74 @@ fail:
     return EOF;
 }
 
+/* --------------------------------
+ *		pq_putmessages	- send a block of complete protocol messages
+ *
+ *		s holds one or more messages that already carry their type code and
+ *		length word, as built by printtup for DataRow batches.  If the block
+ *		does not fit into the send buffer, it is written out together with
+ *		the buffered data instead of being copied through the buffer in
+ *		buffer-sized pieces.
+ *
+ *		returns 0 if OK, EOF if trouble
+ * --------------------------------
+ */
+int pq_putmessages(const char* s, size_t len)
+{
+    int res;
+
+    if (t_thrd.libpq_cxt.DoingCopyOut || t_thrd.libpq_cxt.PqCommBusy) {
+        return 0;
+    }
+    t_thrd.libpq_cxt.PqCommBusy = true;
+    if (len <= (size_t)(t_thrd.libpq_cxt.PqSendBufferSize - t_thrd.libpq_cxt.PqSendPointer) ||
+        pq_disk_is_temp_file_enabled()) {
+        res = internal_putbytes(s, len);
+    } else {
+        StmtRetrySetFileExceededFlag(); /* once flush data to frontend, can not retry this query anymore */
+        pq_set_nonblocking(false);
+        res = internal_flush_with(s, len);
+    }
+    t_thrd.libpq_cxt.PqCommBusy = false;
+    return res;
+}
+
+/* --------------------------------
+ *		pq_register_pending_rows	- announce messages batched outside libpq
+ *
+ *		printtup collects DataRow messages in rows before handing them to
+ *		pq_putmessages().  While rows is registered, any other message (a
+ *		NOTICE or ParameterStatus raised mid-query, or an error report) first
+ *		pushes out whatever rows holds, so the client sees everything in the
+ *		order it was produced.  pq_comm_reset() drops the registration, since
+ *		rows goes away with the aborted portal.
+ * --------------------------------
+ */
+void pq_register_pending_rows(StringInfo rows)
+{
+    t_thrd.libpq_cxt.PqPendingRows = rows;
+}
+
+void pq_unregister_pending_rows(StringInfo rows)
+{
+    if (t_thrd.libpq_cxt.PqPendingRows == rows) {
+        t_thrd.libpq_cxt.PqPendingRows = NULL;
+    }
+}
+
+static int internal_put_pending_rows(void)
+{
+    StringInfo rows = t_thrd.libpq_cxt.PqPendingRows;
+    int res;
+
+    if (rows == NULL || rows->len == 0) {
+        return 0;
+    }
+    res = internal_putbytes(rows->data, rows->len);
+    resetStringInfo(rows);
+    return res;
+}
+
 /* --------------------------------
  *		pq_putmessage_noblock	- like pq_putmessage, but never blocks
  *
@@ -483,6 +483,7 @@ static BucketInfo* _copyBucketInfo(const BucketInfo* from)
     BucketInfo* newnode = makeNode(BucketInfo);
 
     COPY_NODE_FIELD(buckets);
+    COPY_NODE_FIELD(pruningExpr);
 
     return newnode;
 }
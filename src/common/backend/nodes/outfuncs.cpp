@@ -873,6 +873,7 @@ static void _outBucketInfo(StringInfo str, BucketInfo* node)
     WRITE_NODE_TYPE("BUCKETINFO");
 
     WRITE_NODE_FIELD(buckets);
+    WRITE_NODE_FIELD(pruningExpr);
 }
 
 static void _outScan(StringInfo str, Scan* node)
@@ -2873,6 +2873,9 @@ static BucketInfo* _readBucketInfo(BucketInfo* local_node)
     READ_TEMP_LOCALS();
 
     READ_NODE_FIELD(buckets);
+    IF_EXIST(pruningExpr) {
+        READ_NODE_FIELD(pruningExpr);
+    }
 
     READ_DONE();
 }
@@ -53,6 +53,12 @@ static THR_LOCAL NgramZhParserState ngram_parser_state;
 /* char type defined for ngram text search */
 #define NGRAM_TOKEN_NUM 6
 
+/*
+ * The character class tables below are plain process-wide data used by both
+ * the ngram and the pound parser; there is one copy no matter how many
+ * sessions run.  Neither parser loads a dictionary.
+ */
+
 /********************************ASCII encoding Info******************************/
 /*
  *  Get character type in graphic symbol  region
@@ -65,7 +71,7 @@ static THR_LOCAL NgramZhParserState ngram_parser_state;
  * 6 for punctuation
  * 7 for graphic symbol
  */
-uint8 ascii_matrix[8][16] = {
+const uint8 ascii_matrix[8][16] = {
     /*     0    1   2    3   4    5   6    7   8    9    A   B   C   D   E    F */
     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, /* 0x0X */
     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, /* 0x1X */
@@ -104,7 +110,7 @@ uint8 ascii_matrix[8][16] = {
  * value 0x00 means map to invalid GBK encoding region
  * value 0xX0 means map to graphic symbol region
  */
-uint8 gbk_high_byte_matrix[8][16] = {
+const uint8 gbk_high_byte_matrix[8][16] = {
     /* 0    1    2    3    4    5    6    7    8    9    A    B    C    D    E    F */
     {0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01}, /* 0x8X */
     {0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01}, /* 0x9X */
@@ -122,7 +128,7 @@ uint8 gbk_high_byte_matrix[8][16] = {
  * 1 for Chinese word
  * 0 for invalid GBK encoding
  */
-uint8 gbk_zh_word_matrix[3][16][16] = {
+const uint8 gbk_zh_word_matrix[3][16][16] = {
     {
         /* just for easy map */
         /* 0    1    2    3    4    5    6    7    8    9    A    B    C   D    E    F */
@@ -197,7 +203,7 @@ uint8 gbk_zh_word_matrix[3][16][16] = {
  * 7 for graphic symbol
  * 8 for uppercase english letter
  */
-uint8 gbk_grap_symbol_matrix[10][16][16] = {
+const uint8 gbk_grap_symbol_matrix[10][16][16] = {
     /* just for easy map */
     {
         /* 0    1    2    3    4    5    6    7    8    9    A    B    C   D    E    F */
@@ -399,7 +405,7 @@ uint8 gbk_grap_symbol_matrix[10][16][16] = {
         {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}  /* 0xFX */
     }};
 
-uint8 utf8_symbols_punctuation_matrix[4][16] = {
+const uint8 utf8_symbols_punctuation_matrix[4][16] = {
     /* 0    1    2    3    4    5    6    7    8    9    A    B    C   D    E    F */
     {0, 6, 6, 6, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6}, /* 0x300X */
     {6, 6, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6}, /* 0x301X */
@@ -407,7 +413,7 @@ uint8 utf8_symbols_punctuation_matrix[4][16] = {
     {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 0}  /* 0x303X */
 };
 
-uint8 fullwidth_ascii_variants_matrix[4][4][16] = {
+const uint8 fullwidth_ascii_variants_matrix[4][4][16] = {
 
     {
         /* 0    1    2    3    4    5    6    7    8    9    A    B    C   D    E    F */
@@ -579,8 +585,6 @@ void zhParserStateInit(char* str, int len, ZhParserState* parserState)
 
     parserState->cache = NULL;
     parserState->max_cached_num = MAX_CACHED_CHAR;
-    parserState->char_width = (uint8*)palloc0(parserState->max_cached_num + 1);
-    parserState->char_flag = (uint8*)palloc0(parserState->max_cached_num + 1);
 
     parserState->cached_size = 0;
     parserState->cached_counter = 0;
@@ -764,14 +768,6 @@ void zhParserStateDestroy(ZhParserState* parserState)
 
     parserState->cache = NULL;
     parserState->max_cached_num = 0;
-    if (parserState->char_width != NULL) {
-        pfree_ext(parserState->char_width);
-        parserState->char_width = NULL;
-    }
-    if (parserState->char_flag != NULL) {
-        pfree_ext(parserState->char_flag);
-        parserState->char_flag = NULL;
-    }
 
     parserState->cached_size = 0;
     parserState->cached_counter = 0;
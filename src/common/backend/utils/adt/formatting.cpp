@@ -1789,7 +1789,7 @@ static int from_char_seq_search(int* dest, char** src, char** array, int type, i
 /*
  * exposed for bulkload datetime formatting.
  */
-static void do_to_timestamp(text* date_txt, text* fmt, struct pg_tm* tm, fsec_t* fsec);
+static void do_to_timestamp(text* date_txt, text* fmt, struct pg_tm* tm, fsec_t* fsec, FmgrInfo* flinfo);
 static char* fill_str(char* str, int c, int max);
 static FormatNode* NUM_cache(int len, NUMDesc* Num, text* pars_str, bool* shouldFree);
 static char* int_to_roman(int number);
@@ -4113,6 +4113,104 @@ static DCHCacheEntry* DCH_cache_search(const char* str)
     return NULL;
 }
 
+/*
+ * Format picture of a single to_char(), to_timestamp() or to_date() call
+ * site.  The format argument is nearly always a constant, so keeping the
+ * parsed picture in fn_extra saves the conversion to C string and the search
+ * of the DCH cache for every row.
+ */
+typedef struct DCHFnCacheEntry {
+    text* fmt;          /* format the picture was parsed from, or NULL */
+    int fmt_len;        /* its length as a C string */
+    FormatNode* format; /* fmt_len + 1 nodes, terminated by NODE_TYPE_END */
+} DCHFnCacheEntry;
+
+static FormatNode* DCH_fn_cache_format(FmgrInfo* flinfo, text* fmt, int* fmt_len, int type)
+{
+    DCHFnCacheEntry* ent = (DCHFnCacheEntry*)flinfo->fn_extra;
+    MemoryContext oldcontext;
+    FormatNode* format = NULL;
+    char* fmt_str = NULL;
+    int len;
+    errno_t rc;
+
+    if (ent != NULL && ent->fmt != NULL && VARSIZE(ent->fmt) == VARSIZE(fmt) &&
+        memcmp(ent->fmt, fmt, VARSIZE(fmt)) == 0) {
+        *fmt_len = ent->fmt_len;
+        return ent->format;
+    }
+
+    if (ent == NULL) {
+        ent = (DCHFnCacheEntry*)MemoryContextAllocZero(flinfo->fn_mcxt, sizeof(DCHFnCacheEntry));
+        flinfo->fn_extra = ent;
+    } else {
+        pfree_ext(ent->fmt);
+        pfree_ext(ent->format);
+    }
+
+    oldcontext = MemoryContextSwitchTo(flinfo->fn_mcxt);
+
+    fmt_str = text_to_cstring(fmt);
+    len = strlen(fmt_str);
+    format = (FormatNode*)palloc((len + 1) * sizeof(FormatNode));
+    parse_format(format, fmt_str, DCH_keywords, DCH_suff, DCH_index, type, NULL);
+    (format + len)->type = NODE_TYPE_END; /* Paranoia? */
+    pfree_ext(fmt_str);
+
+    /* remember the format only once it has been parsed successfully */
+    ent->fmt = (text*)palloc(VARSIZE(fmt));
+    rc = memcpy_s(ent->fmt, VARSIZE(fmt), fmt, VARSIZE(fmt));
+    securec_check(rc, "\0", "\0");
+    ent->fmt_len = len;
+    ent->format = format;
+
+    (void)MemoryContextSwitchTo(oldcontext);
+
+    *fmt_len = len;
+    return format;
+}
+
+/*
+ * Run a parsed format picture over tmtc and return the result as text.
+ */
+static text* DCH_format_to_text(FormatNode* format, int fmt_len, TmToChar* tmtc, bool is_interval, Oid collid)
+{
+    char* result = NULL;
+    text* res = NULL;
+
+    /*
+     * Allocate workspace for result as C string
+     */
+    result = (char*)palloc((fmt_len * DCH_MAX_ITEM_SIZ) + 1);
+    *result = '\0';
+
+    /* The real work is here */
+    DCH_to_char(format, is_interval, tmtc, result, (fmt_len * DCH_MAX_ITEM_SIZ) + 1, collid);
+
+    /* convert C-string result to TEXT format */
+    res = cstring_to_text(result);
+
+    pfree_ext(result);
+    return res;
+}
+
+/*
+ * datetime_to_char_body() for a to_char() call made through fmgr; the parsed
+ * format picture is kept with the call site.
+ */
+static text* datetime_to_char_fn(FunctionCallInfo fcinfo, TmToChar* tmtc, text* fmt, bool is_interval)
+{
+    FormatNode* format = NULL;
+    int fmt_len;
+
+    if (fcinfo->flinfo == NULL) {
+        return datetime_to_char_body(tmtc, fmt, is_interval, PG_GET_COLLATION());
+    }
+
+    format = DCH_fn_cache_format(fcinfo->flinfo, fmt, &fmt_len, DCH_TO_CHAR_TYPE);
+    return DCH_format_to_text(format, fmt_len, tmtc, is_interval, PG_GET_COLLATION());
+}
+
 /*
  * Format a date/time or interval into a string according to fmt.
  * We parse fmt into a list of FormatNodes.  This is then passed to DCH_to_char
@@ -4122,7 +4220,6 @@ text* datetime_to_char_body(TmToChar* tmtc, text* fmt, bool is_interval, Oid col
 {
     FormatNode* format = NULL;
     char* fmt_str = NULL;
-    char* result = NULL;
     bool incache = false;
     int fmt_len;
     text* res = NULL;
@@ -4133,12 +4230,6 @@ text* datetime_to_char_body(TmToChar* tmtc, text* fmt, bool is_interval, Oid col
     fmt_str = text_to_cstring(fmt);
     fmt_len = strlen(fmt_str);
 
-    /*
-     * Allocate workspace for result as C string
-     */
-    result = (char*)palloc((fmt_len * DCH_MAX_ITEM_SIZ) + 1);
-    *result = '\0';
-
     /*
      * Allocate new memory if format picture is bigger than static cache and
      * not use cache (call parser always)
@@ -4172,8 +4263,7 @@ text* datetime_to_char_body(TmToChar* tmtc, text* fmt, bool is_interval, Oid col
         format = ent->format;
     }
 
-    /* The real work is here */
-    DCH_to_char(format, is_interval, tmtc, result, (fmt_len * DCH_MAX_ITEM_SIZ) + 1, collid);
+    res = DCH_format_to_text(format, fmt_len, tmtc, is_interval, collid);
 
     if (!incache) {
         pfree_ext(format);
@@ -4181,10 +4271,6 @@ text* datetime_to_char_body(TmToChar* tmtc, text* fmt, bool is_interval, Oid col
 
     pfree_ext(fmt_str);
 
-    /* convert C-string result to TEXT format */
-    res = cstring_to_text(result);
-
-    pfree_ext(result);
     return res;
 }
 
@@ -4220,7 +4306,7 @@ Datum timestamp_to_char(PG_FUNCTION_ARGS)
     tm->tm_wday = (thisdate + 1) % 7;
     tm->tm_yday = thisdate - date2j(tm->tm_year, 1, 1) + 1;
 
-    if (!(res = datetime_to_char_body(&tmtc, fmt, false, PG_GET_COLLATION()))) {
+    if (!(res = datetime_to_char_fn(fcinfo, &tmtc, fmt, false))) {
         PG_RETURN_NULL();
     }
 
@@ -4252,7 +4338,7 @@ Datum timestamptz_to_char(PG_FUNCTION_ARGS)
     tm->tm_wday = (thisdate + 1) % 7;
     tm->tm_yday = thisdate - date2j(tm->tm_year, 1, 1) + 1;
 
-    if (!(res = datetime_to_char_body(&tmtc, fmt, false, PG_GET_COLLATION()))) {
+    if (!(res = datetime_to_char_fn(fcinfo, &tmtc, fmt, false))) {
         PG_RETURN_NULL();
     }
 
@@ -4315,7 +4401,7 @@ Datum interval_to_char(PG_FUNCTION_ARGS)
     /* wday is meaningless, yday approximates the total span in days */
     tm->tm_yday = (tm->tm_year * MONTHS_PER_YEAR + tm->tm_mon) * DAYS_PER_MONTH + tm->tm_mday;
 
-    if (!(res = datetime_to_char_body(&tmtc, fmt, true, PG_GET_COLLATION()))) {
+    if (!(res = datetime_to_char_fn(fcinfo, &tmtc, fmt, true))) {
         PG_RETURN_NULL();
     }
 
@@ -4339,7 +4425,7 @@ Datum to_timestamp(PG_FUNCTION_ARGS)
     struct pg_tm tm;
     fsec_t fsec;
 
-    do_to_timestamp(date_txt, fmt, &tm, &fsec);
+    do_to_timestamp(date_txt, fmt, &tm, &fsec, fcinfo->flinfo);
 
     if (tm2timestamp(&tm, fsec, &tz, &result) != 0)
         ereport(ERROR, (errcode(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE), errmsg("timestamp out of range")));
@@ -4360,7 +4446,7 @@ Datum to_date(PG_FUNCTION_ARGS)
     struct pg_tm tm;
     fsec_t fsec;
 
-    do_to_timestamp(date_txt, fmt, &tm, &fsec);
+    do_to_timestamp(date_txt, fmt, &tm, &fsec, fcinfo->flinfo);
 
     if (!IS_VALID_JULIAN(tm.tm_year, tm.tm_mon, tm.tm_mday)) {
         ereport(ERROR,
@@ -5090,10 +5176,13 @@ static
  * The TmFromChar is then analysed and converted into the final results in
  * struct 'tm' and 'fsec'.
  *
+ * When called through fmgr, 'flinfo' keeps the parsed 'fmt' with the call
+ * site, see DCH_fn_cache_format().
+ *
  * This function does very little error checking, e.g.
  * to_timestamp('20096040','YYYYMMDD') works
  */
-static void do_to_timestamp(text* date_txt, text* fmt, struct pg_tm* tm, fsec_t* fsec)
+static void do_to_timestamp(text* date_txt, text* fmt, struct pg_tm* tm, fsec_t* fsec, FmgrInfo* flinfo)
 {
     FormatNode* format = NULL;
     TmFromChar tmfc;
@@ -5127,8 +5216,12 @@ static void do_to_timestamp(text* date_txt, text* fmt, struct pg_tm* tm, fsec_t*
         char* date_str = NULL;
         bool incache = true;
 
-        fmt_str = text_to_cstring(fmt);
-        format = get_format(fmt_str, fmt_len, &incache);
+        if (flinfo != NULL) {
+            format = DCH_fn_cache_format(flinfo, fmt, &fmt_len, DCH_TO_TIMESTAMP_TYPE);
+        } else {
+            fmt_str = text_to_cstring(fmt);
+            format = get_format(fmt_str, fmt_len, &incache);
+        }
         date_str = text_to_cstring(date_txt);
         DCH_from_char(format, date_str, &tmfc, &non_match, &tmfc_flag);
 
@@ -7215,7 +7308,7 @@ Datum to_timestamp_default_format(PG_FUNCTION_ARGS)
     struct pg_tm tm;
     fsec_t fsec = 0;
 
-    do_to_timestamp(date_txt, fmt, &tm, &fsec);
+    do_to_timestamp(date_txt, fmt, &tm, &fsec, fcinfo->flinfo);
 
     if (tm2timestamp(&tm, fsec, &tz, &result) != 0) {
         ereport(ERROR, (errcode(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE), errmsg("timestamp out of range")));
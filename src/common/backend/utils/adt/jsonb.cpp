@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jsonb.cpp
+ *	  I/O routines for the binary JSON data type jsonb.
+ *
+ * Text input is first checked by the json validator, so that jsonb reports
+ * exactly the same syntax errors as json, and then parsed into a JsonbValue
+ * tree which is serialized in one pass.  Values of type json have already
+ * been validated, which makes the json -> jsonb cast a single parse.
+ *
+ * IDENTIFICATION
+ *	  src/common/backend/utils/adt/jsonb.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "libpq/pqformat.h"
+#include "mb/pg_wchar.h"
+#include "miscadmin.h"
+#include "utils/builtins.h"
+#include "utils/json.h"
+#include "utils/jsonb.h"
+
+typedef struct JsonbParseState {
+    char* pos; /* next input byte */
+    char* end; /* end of input */
+} JsonbParseState;
+
+static void JsonbParseValue(JsonbParseState* state, JsonbValue* result);
+
+static void JsonbReportSyntaxError(void)
+{
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION), errmsg("invalid input syntax for type json")));
+}
+
+static void JsonbSkipWhitespace(JsonbParseState* state)
+{
+    while (state->pos < state->end &&
+           (*state->pos == ' ' || *state->pos == '\t' || *state->pos == '\n' || *state->pos == '\r')) {
+        state->pos++;
+    }
+}
+
+static int JsonbParseHex4(JsonbParseState* state)
+{
+    int ch = 0;
+
+    if (state->end - state->pos < 4) {
+        JsonbReportSyntaxError();
+    }
+    for (int i = 0; i < 4; i++) {
+        char c = *state->pos++;
+
+        if (c >= '0' && c <= '9') {
+            ch = (ch * 16) + (c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            ch = (ch * 16) + (c - 'a') + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            ch = (ch * 16) + (c - 'A') + 10;
+        } else {
+            JsonbReportSyntaxError();
+        }
+    }
+    return ch;
+}
+
+/* append the code point of a \u escape in the database encoding */
+static void JsonbAppendUnicode(StringInfo buf, int ch)
+{
+    if (ch == 0) {
+        ereport(ERROR, (errcode(ERRCODE_UNTRANSLATABLE_CHARACTER),
+            errmsg("unsupported Unicode escape sequence"),
+            errdetail("\\u0000 cannot be converted to text.")));
+    }
+
+    if (GetDatabaseEncoding() == PG_UTF8) {
+        unsigned char utf8str[5];
+
+        (void)unicode_to_utf8((pg_wchar)ch, utf8str);
+        appendBinaryStringInfo(buf, (const char*)utf8str, pg_utf_mblen(utf8str));
+    } else if (ch <= 0x007f) {
+        appendStringInfoChar(buf, (char)ch);
+    } else {
+        ereport(ERROR, (errcode(ERRCODE_UNTRANSLATABLE_CHARACTER),
+            errmsg("unsupported Unicode escape sequence"),
+            errdetail("Unicode escape values cannot be used for code point values above 007F "
+                      "when the server encoding is not UTF8.")));
+    }
+}
+
+/*
+ * Parse a string token.  If it has no escapes the result points into the
+ * input, otherwise at a de-escaped copy.
+ */
+static void JsonbParseString(JsonbParseState* state, JsonbValue* result)
+{
+    char* start = ++state->pos;
+    StringInfoData buf;
+
+    while (state->pos < state->end && *state->pos != '"' && *state->pos != '\\') {
+        state->pos++;
+    }
+    if (state->pos >= state->end) {
+        JsonbReportSyntaxError();
+    }
+
+    result->type = jbvString;
+    if (*state->pos == '"') {
+        result->val.string.val = start;
+        result->val.string.len = (int)(state->pos - start);
+        state->pos++;
+        return;
+    }
+
+    initStringInfo(&buf);
+    appendBinaryStringInfo(&buf, start, (int)(state->pos - start));
+    while (state->pos < state->end && *state->pos != '"') {
+        char c = *state->pos++;
+
+        if (c != '\\') {
+            appendStringInfoChar(&buf, c);
+            continue;
+        }
+        if (state->pos >= state->end) {
+            JsonbReportSyntaxError();
+        }
+
+        c = *state->pos++;
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                appendStringInfoChar(&buf, c);
+                break;
+            case 'b':
+                appendStringInfoChar(&buf, '\b');
+                break;
+            case 'f':
+                appendStringInfoChar(&buf, '\f');
+                break;
+            case 'n':
+                appendStringInfoChar(&buf, '\n');
+                break;
+            case 'r':
+                appendStringInfoChar(&buf, '\r');
+                break;
+            case 't':
+                appendStringInfoChar(&buf, '\t');
+                break;
+            case 'u': {
+                int ch = JsonbParseHex4(state);
+
+                if (ch >= 0xd800 && ch <= 0xdbff) {
+                    int lo;
+
+                    if (state->end - state->pos < 2 || state->pos[0] != '\\' || state->pos[1] != 'u') {
+                        ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+                            errmsg("invalid input syntax for type json"),
+                            errdetail("Unicode high surrogate must be followed by a Unicode low surrogate.")));
+                    }
+                    state->pos += 2;
+                    lo = JsonbParseHex4(state);
+                    if (lo < 0xdc00 || lo > 0xdfff) {
+                        ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+                            errmsg("invalid input syntax for type json"),
+                            errdetail("Unicode high surrogate must be followed by a Unicode low surrogate.")));
+                    }
+                    ch = 0x10000 + ((ch - 0xd800) << 10) + (lo - 0xdc00);
+                } else if (ch >= 0xdc00 && ch <= 0xdfff) {
+                    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+                        errmsg("invalid input syntax for type json"),
+                        errdetail("Unicode low surrogate must follow a high surrogate.")));
+                }
+                JsonbAppendUnicode(&buf, ch);
+                break;
+            }
+            default:
+                JsonbReportSyntaxError();
+        }
+    }
+    if (state->pos >= state->end) {
+        JsonbReportSyntaxError();
+    }
+    state->pos++;
+
+    result->val.string.val = buf.data;
+    result->val.string.len = buf.len;
+}
+
+static void JsonbParseNumber(JsonbParseState* state, JsonbValue* result)
+{
+    char* start = state->pos;
+    char* str = NULL;
+
+    while (state->pos < state->end && (isdigit((unsigned char)*state->pos) || *state->pos == '-' ||
+                                          *state->pos == '+' || *state->pos == '.' || *state->pos == 'e' ||
+                                          *state->pos == 'E')) {
+        state->pos++;
+    }
+    if (state->pos == start) {
+        JsonbReportSyntaxError();
+    }
+
+    str = pnstrdup(start, state->pos - start);
+    result->type = jbvNumeric;
+    result->val.numeric = DatumGetNumeric(
+        DirectFunctionCall3(numeric_in, CStringGetDatum(str), ObjectIdGetDatum(InvalidOid), Int32GetDatum(-1)));
+    pfree_ext(str);
+}
+
+static void JsonbParseKeyword(JsonbParseState* state, const char* keyword)
+{
+    int len = strlen(keyword);
+
+    if (state->end - state->pos < len || strncmp(state->pos, keyword, len) != 0) {
+        JsonbReportSyntaxError();
+    }
+    state->pos += len;
+}
+
+static void JsonbParseArray(JsonbParseState* state, JsonbValue* result)
+{
+    int nalloc = 4;
+
+    result->type = jbvArray;
+    result->val.array.nelems = 0;
+    result->val.array.elems = (JsonbValue*)palloc(nalloc * sizeof(JsonbValue));
+    result->val.array.rawScalar = false;
+
+    state->pos++;
+    JsonbSkipWhitespace(state);
+    if (state->pos < state->end && *state->pos == ']') {
+        state->pos++;
+        return;
+    }
+
+    for (;;) {
+        if (result->val.array.nelems == nalloc) {
+            nalloc *= 2;
+            result->val.array.elems = (JsonbValue*)repalloc(result->val.array.elems, nalloc * sizeof(JsonbValue));
+        }
+        JsonbParseValue(state, &result->val.array.elems[result->val.array.nelems++]);
+
+        JsonbSkipWhitespace(state);
+        if (state->pos >= state->end) {
+            JsonbReportSyntaxError();
+        }
+        if (*state->pos++ == ']') {
+            break;
+        }
+        if (state->pos[-1] != ',') {
+            JsonbReportSyntaxError();
+        }
+    }
+}
+
+static void JsonbParseObject(JsonbParseState* state, JsonbValue* result)
+{
+    int nalloc = 4;
+
+    result->type = jbvObject;
+    result->val.object.npairs = 0;
+    result->val.object.pairs = (JsonbPair*)palloc(nalloc * sizeof(JsonbPair));
+
+    state->pos++;
+    JsonbSkipWhitespace(state);
+    if (state->pos < state->end && *state->pos == '}') {
+        state->pos++;
+        return;
+    }
+
+    for (;;) {
+        JsonbPair* pair = NULL;
+
+        if (result->val.object.npairs == nalloc) {
+            nalloc *= 2;
+            result->val.object.pairs = (JsonbPair*)repalloc(result->val.object.pairs, nalloc * sizeof(JsonbPair));
+        }
+        pair = &result->val.object.pairs[result->val.object.npairs];
+        pair->order = (uint32)result->val.object.npairs++;
+
+        JsonbSkipWhitespace(state);
+        if (state->pos >= state->end || *state->pos != '"') {
+            JsonbReportSyntaxError();
+        }
+        JsonbParseString(state, &pair->key);
+
+        JsonbSkipWhitespace(state);
+        if (state->pos >= state->end || *state->pos != ':') {
+            JsonbReportSyntaxError();
+        }
+        state->pos++;
+        JsonbParseValue(state, &pair->value);
+
+        JsonbSkipWhitespace(state);
+        if (state->pos >= state->end) {
+            JsonbReportSyntaxError();
+        }
+        if (*state->pos++ == '}') {
+            break;
+        }
+        if (state->pos[-1] != ',') {
+            JsonbReportSyntaxError();
+        }
+    }
+
+    JsonbUniquifyObject(result);
+}
+
+static void JsonbParseValue(JsonbParseState* state, JsonbValue* result)
+{
+    check_stack_depth();
+
+    JsonbSkipWhitespace(state);
+    if (state->pos >= state->end) {
+        JsonbReportSyntaxError();
+    }
+
+    switch (*state->pos) {
+        case '{':
+            JsonbParseObject(state, result);
+            break;
+        case '[':
+            JsonbParseArray(state, result);
+            break;
+        case '"':
+            JsonbParseString(state, result);
+            break;
+        case 't':
+            JsonbParseKeyword(state, "true");
+            result->type = jbvBool;
+            result->val.boolean = true;
+            break;
+        case 'f':
+            JsonbParseKeyword(state, "false");
+            result->type = jbvBool;
+            result->val.boolean = false;
+            break;
+        case 'n':
+            JsonbParseKeyword(state, "null");
+            result->type = jbvNull;
+            break;
+        default:
+            JsonbParseNumber(state, result);
+            break;
+    }
+}
+
+/*
+ * JsonbFromCString - build a jsonb from len bytes of JSON text
+ *
+ * The input need not be null-terminated.  It is expected to have been
+ * validated; anything malformed gets a generic syntax error.
+ */
+Jsonb* JsonbFromCString(char* str, int len)
+{
+    JsonbParseState state;
+    JsonbValue value;
+
+    state.pos = str;
+    state.end = str + len;
+
+    JsonbParseValue(&state, &value);
+    JsonbSkipWhitespace(&state);
+    if (state.pos != state.end) {
+        JsonbReportSyntaxError();
+    }
+
+    return JsonbValueToJsonb(&value);
+}
+
+static void JsonbScalarToCString(StringInfo out, const JsonbValue* val)
+{
+    switch (val->type) {
+        case jbvNull:
+            appendBinaryStringInfo(out, "null", 4);
+            break;
+        case jbvBool:
+            if (val->val.boolean) {
+                appendBinaryStringInfo(out, "true", 4);
+            } else {
+                appendBinaryStringInfo(out, "false", 5);
+            }
+            break;
+        case jbvString: {
+            char* str = pnstrdup(val->val.string.val, val->val.string.len);
+
+            escape_json(out, str);
+            pfree_ext(str);
+            break;
+        }
+        case jbvNumeric: {
+            char* str = DatumGetCString(DirectFunctionCall1(numeric_out, NumericGetDatum(val->val.numeric)));
+
+            appendStringInfoString(out, str);
+            pfree_ext(str);
+            break;
+        }
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("jsonb value is not a scalar")));
+    }
+}
+
+/* JsonbValueToCString - append the JSON text of a scalar or container */
+void JsonbValueToCString(StringInfo out, const JsonbValue* val)
+{
+    if (val->type == jbvBinary) {
+        JsonbToCString(out, val->val.binary.data);
+    } else {
+        JsonbScalarToCString(out, val);
+    }
+}
+
+/* JsonbToCString - append the JSON text of container */
+void JsonbToCString(StringInfo out, const JsonbContainer* container)
+{
+    uint32 count = JsonbContainerSize(container);
+    JsonbValue value;
+
+    check_stack_depth();
+
+    if (JsonbContainerIsScalar(container)) {
+        JsonbGetIthValue(container, 0, &value);
+        JsonbScalarToCString(out, &value);
+        return;
+    }
+
+    if (JsonbContainerIsObject(container)) {
+        appendStringInfoCharMacro(out, '{');
+        for (uint32 i = 0; i < count; i++) {
+            JsonbValue key;
+
+            if (i > 0) {
+                appendBinaryStringInfo(out, ", ", 2);
+            }
+            JsonbGetIthKey(container, i, &key);
+            JsonbScalarToCString(out, &key);
+            appendBinaryStringInfo(out, ": ", 2);
+            JsonbGetIthValue(container, i, &value);
+            JsonbValueToCString(out, &value);
+        }
+        appendStringInfoCharMacro(out, '}');
+    } else {
+        appendStringInfoCharMacro(out, '[');
+        for (uint32 i = 0; i < count; i++) {
+            if (i > 0) {
+                appendBinaryStringInfo(out, ", ", 2);
+            }
+            JsonbGetIthValue(container, i, &value);
+            JsonbValueToCString(out, &value);
+        }
+        appendStringInfoCharMacro(out, ']');
+    }
+}
+
+/*
+ * Input.
+ */
+Datum jsonb_in(PG_FUNCTION_ARGS)
+{
+    char* json = PG_GETARG_CSTRING(0);
+
+    json_validate_cstring(json);
+
+    PG_RETURN_JSONB(JsonbFromCString(json, strlen(json)));
+}
+
+/*
+ * Output.
+ */
+Datum jsonb_out(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    StringInfoData out;
+
+    initStringInfo(&out);
+    JsonbToCString(&out, &jb->root);
+
+    PG_RETURN_CSTRING(out.data);
+}
+
+/*
+ * Binary receive.
+ *
+ * The binary format is a version byte followed by the JSON text, so that
+ * clients need not know the on-disk layout.
+ */
+Datum jsonb_recv(PG_FUNCTION_ARGS)
+{
+    StringInfo buf = (StringInfo)PG_GETARG_POINTER(0);
+    int version = (int)pq_getmsgint(buf, 1);
+    char* str = NULL;
+    int nbytes;
+
+    if (version != 1) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+            errmsg("unsupported jsonb version number %d", version)));
+    }
+
+    str = pq_getmsgtext(buf, buf->len - buf->cursor, &nbytes);
+    json_validate_cstring(str);
+
+    PG_RETURN_JSONB(JsonbFromCString(str, nbytes));
+}
+
+/*
+ * Binary send.
+ */
+Datum jsonb_send(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    StringInfoData out;
+    StringInfoData buf;
+
+    initStringInfo(&out);
+    JsonbToCString(&out, &jb->root);
+
+    pq_begintypsend(&buf);
+    pq_sendint(&buf, 1, 1);
+    pq_sendtext(&buf, out.data, out.len);
+    pfree_ext(out.data);
+
+    PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+}
+
+/*
+ * json -> jsonb cast.  json values are always valid, so skip the validator.
+ */
+Datum json_to_jsonb(PG_FUNCTION_ARGS)
+{
+    text* json = PG_GETARG_TEXT_PP(0);
+
+    PG_RETURN_JSONB(JsonbFromCString(VARDATA_ANY(json), VARSIZE_ANY_EXHDR(json)));
+}
+
+/*
+ * jsonb -> json cast.
+ */
+Datum jsonb_to_json(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    StringInfoData out;
+
+    initStringInfo(&out);
+    JsonbToCString(&out, &jb->root);
+
+    PG_RETURN_TEXT_P(cstring_to_text_with_len(out.data, out.len));
+}
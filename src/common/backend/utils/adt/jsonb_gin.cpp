@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jsonb_gin.cpp
+ *	  GIN support functions for jsonb_ops and jsonb_path_ops.
+ *
+ * jsonb_ops indexes every object key and every scalar of a value as a text
+ * entry made of a flag byte followed by the key or value.  Strings inside
+ * arrays are flagged as keys, so that ? finds array elements as well.  It
+ * supports @>, ?, ?| and ?&; all of them need a recheck because the entries
+ * do not record where in the document they were found.
+ *
+ * jsonb_path_ops indexes one int4 hash per scalar, combining the hashes of
+ * the object keys on the way down to it with the hash of the scalar itself.
+ * That gives far fewer and more selective entries, but only supports @>.
+ *
+ * IDENTIFICATION
+ *	  src/common/backend/utils/adt/jsonb_gin.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/gin.h"
+#include "access/hash.h"
+#include "access/skey.h"
+#include "catalog/pg_type.h"
+#include "miscadmin.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/jsonb.h"
+
+/* flag byte of a jsonb_ops entry */
+#define JGINFLAG_KEY 0x01
+#define JGINFLAG_NULL 0x02
+#define JGINFLAG_BOOL 0x03
+#define JGINFLAG_NUM 0x04
+#define JGINFLAG_STR 0x05
+#define JGINFLAG_HASHED 0x10 /* long string replaced by its hash */
+
+/* strings longer than this are indexed by hash to keep entries small */
+#define JGIN_MAXLENGTH 125
+
+typedef struct JsonbGinEntries {
+    Datum* entries;
+    int count;
+    int allocated;
+} JsonbGinEntries;
+
+static void JsonbGinInitEntries(JsonbGinEntries* entries, int preallocated)
+{
+    entries->allocated = Max(preallocated, 8);
+    entries->count = 0;
+    entries->entries = (Datum*)palloc(entries->allocated * sizeof(Datum));
+}
+
+static void JsonbGinAddEntry(JsonbGinEntries* entries, Datum entry)
+{
+    if (entries->count == entries->allocated) {
+        entries->allocated *= 2;
+        entries->entries = (Datum*)repalloc(entries->entries, entries->allocated * sizeof(Datum));
+    }
+    entries->entries[entries->count++] = entry;
+}
+
+static Datum JsonbGinMakeTextEntry(char flag, const char* str, int len)
+{
+    text* item = (text*)palloc(VARHDRSZ + len + 1);
+
+    SET_VARSIZE(item, VARHDRSZ + len + 1);
+    *VARDATA(item) = flag;
+    if (len > 0) {
+        errno_t rc = memcpy_s(VARDATA(item) + 1, len, str, len);
+        securec_check(rc, "\0", "\0");
+    }
+    return PointerGetDatum(item);
+}
+
+static Datum JsonbGinMakeStringEntry(char flag, const char* str, int len)
+{
+    if (len > JGIN_MAXLENGTH) {
+        char hashbuf[10];
+        uint32 hash = DatumGetUInt32(hash_any((const unsigned char*)str, len));
+        int rc = snprintf_s(hashbuf, sizeof(hashbuf), sizeof(hashbuf) - 1, "%08x", hash);
+
+        securec_check_ss(rc, "\0", "\0");
+        return JsonbGinMakeTextEntry(flag | JGINFLAG_HASHED, hashbuf, rc);
+    }
+    return JsonbGinMakeTextEntry(flag, str, len);
+}
+
+static Datum JsonbGinMakeScalarEntry(const JsonbValue* val, bool inArray)
+{
+    switch (val->type) {
+        case jbvNull:
+            return JsonbGinMakeTextEntry(JGINFLAG_NULL, NULL, 0);
+        case jbvBool:
+            return JsonbGinMakeTextEntry(JGINFLAG_BOOL, val->val.boolean ? "t" : "f", 1);
+        case jbvNumeric: {
+            /* equal numerics must give equal entries whatever their scale */
+            char hashbuf[10];
+            uint32 hash = DatumGetUInt32(DirectFunctionCall1(hash_numeric, NumericGetDatum(val->val.numeric)));
+            int rc = snprintf_s(hashbuf, sizeof(hashbuf), sizeof(hashbuf) - 1, "%08x", hash);
+
+            securec_check_ss(rc, "\0", "\0");
+            return JsonbGinMakeTextEntry(JGINFLAG_NUM, hashbuf, rc);
+        }
+        case jbvString:
+            return JsonbGinMakeStringEntry(
+                inArray ? JGINFLAG_KEY : JGINFLAG_STR, val->val.string.val, val->val.string.len);
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("jsonb value is not a scalar")));
+    }
+    return (Datum)0; /* keep compiler quiet */
+}
+
+/* collect the jsonb_ops entries of container and everything below it */
+static void JsonbGinExtractOps(const JsonbContainer* container, JsonbGinEntries* entries)
+{
+    uint32 count = JsonbContainerSize(container);
+    bool isObject = JsonbContainerIsObject(container);
+
+    check_stack_depth();
+
+    for (uint32 i = 0; i < count; i++) {
+        JsonbValue value;
+
+        if (isObject) {
+            JsonbGetIthKey(container, i, &value);
+            JsonbGinAddEntry(entries, JsonbGinMakeStringEntry(JGINFLAG_KEY, value.val.string.val,
+                value.val.string.len));
+        }
+
+        JsonbGetIthValue(container, i, &value);
+        if (value.type == jbvBinary) {
+            JsonbGinExtractOps(value.val.binary.data, entries);
+        } else {
+            JsonbGinAddEntry(entries, JsonbGinMakeScalarEntry(&value, !isObject));
+        }
+    }
+}
+
+Datum gin_compare_jsonb(PG_FUNCTION_ARGS)
+{
+    text* a = PG_GETARG_TEXT_PP(0);
+    text* b = PG_GETARG_TEXT_PP(1);
+    int alen = VARSIZE_ANY_EXHDR(a);
+    int blen = VARSIZE_ANY_EXHDR(b);
+    int cmp;
+
+    cmp = memcmp(VARDATA_ANY(a), VARDATA_ANY(b), Min(alen, blen));
+    if (cmp == 0) {
+        cmp = alen - blen;
+    }
+
+    PG_FREE_IF_COPY(a, 0);
+    PG_FREE_IF_COPY(b, 1);
+    PG_RETURN_INT32(cmp);
+}
+
+Datum gin_extract_jsonb(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    int32* nentries = (int32*)PG_GETARG_POINTER(1);
+    JsonbGinEntries entries;
+
+    if (JsonbContainerSize(&jb->root) == 0) {
+        *nentries = 0;
+        PG_RETURN_POINTER(NULL);
+    }
+
+    JsonbGinInitEntries(&entries, 2 * JsonbContainerSize(&jb->root));
+    JsonbGinExtractOps(&jb->root, &entries);
+
+    *nentries = entries.count;
+    PG_RETURN_POINTER(entries.entries);
+}
+
+Datum gin_extract_jsonb_query(PG_FUNCTION_ARGS)
+{
+    int32* nentries = (int32*)PG_GETARG_POINTER(1);
+    StrategyNumber strategy = PG_GETARG_UINT16(2);
+    int32* searchMode = (int32*)PG_GETARG_POINTER(6);
+    Datum* entries = NULL;
+
+    if (strategy == JsonbContainsStrategyNumber) {
+        entries = (Datum*)DatumGetPointer(
+            DirectFunctionCall2(gin_extract_jsonb, PG_GETARG_DATUM(0), PointerGetDatum(nentries)));
+        /* everything contains the empty object or array */
+        if (*nentries == 0) {
+            *searchMode = GIN_SEARCH_MODE_ALL;
+        }
+    } else if (strategy == JsonbExistsStrategyNumber) {
+        text* query = PG_GETARG_TEXT_PP(0);
+
+        *nentries = 1;
+        entries = (Datum*)palloc(sizeof(Datum));
+        entries[0] = JsonbGinMakeStringEntry(JGINFLAG_KEY, VARDATA_ANY(query), VARSIZE_ANY_EXHDR(query));
+    } else if (strategy == JsonbExistsAnyStrategyNumber || strategy == JsonbExistsAllStrategyNumber) {
+        ArrayType* query = PG_GETARG_ARRAYTYPE_P(0);
+        Datum* keys = NULL;
+        bool* keynulls = NULL;
+        int nkeys;
+        int j = 0;
+
+        deconstruct_array(query, TEXTOID, -1, false, 'i', &keys, &keynulls, &nkeys);
+
+        entries = (Datum*)palloc(sizeof(Datum) * Max(nkeys, 1));
+        for (int i = 0; i < nkeys; i++) {
+            /* null keys can never match */
+            if (keynulls[i]) {
+                continue;
+            }
+            entries[j++] = JsonbGinMakeStringEntry(JGINFLAG_KEY, VARDATA_ANY(DatumGetPointer(keys[i])),
+                VARSIZE_ANY_EXHDR(DatumGetPointer(keys[i])));
+        }
+        *nentries = j;
+
+        /* ?& with no keys matches everything */
+        if (j == 0 && strategy == JsonbExistsAllStrategyNumber) {
+            *searchMode = GIN_SEARCH_MODE_ALL;
+        }
+    } else {
+        ereport(ERROR, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE), errmsg("unrecognized strategy number: %d", strategy)));
+    }
+
+    PG_RETURN_POINTER(entries);
+}
+
+Datum gin_consistent_jsonb(PG_FUNCTION_ARGS)
+{
+    bool* check = (bool*)PG_GETARG_POINTER(0);
+    StrategyNumber strategy = PG_GETARG_UINT16(1);
+    int32 nkeys = PG_GETARG_INT32(3);
+    bool* recheck = (bool*)PG_GETARG_POINTER(5);
+    bool res = true;
+
+    /* the entries say nothing about where in the document they occur */
+    *recheck = true;
+
+    if (strategy == JsonbContainsStrategyNumber || strategy == JsonbExistsAllStrategyNumber) {
+        for (int32 i = 0; i < nkeys; i++) {
+            if (!check[i]) {
+                res = false;
+                break;
+            }
+        }
+    } else if (strategy == JsonbExistsStrategyNumber || strategy == JsonbExistsAnyStrategyNumber) {
+        res = false;
+        for (int32 i = 0; i < nkeys; i++) {
+            if (check[i]) {
+                res = true;
+                break;
+            }
+        }
+    } else {
+        ereport(ERROR, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE), errmsg("unrecognized strategy number: %d", strategy)));
+    }
+
+    PG_RETURN_BOOL(res);
+}
+
+Datum gin_triconsistent_jsonb(PG_FUNCTION_ARGS)
+{
+    GinTernaryValue* check = (GinTernaryValue*)PG_GETARG_POINTER(0);
+    StrategyNumber strategy = PG_GETARG_UINT16(1);
+    int32 nkeys = PG_GETARG_INT32(3);
+    GinTernaryValue res = GIN_MAYBE;
+
+    /* never answer GIN_TRUE: every match needs a recheck */
+    if (strategy == JsonbContainsStrategyNumber || strategy == JsonbExistsAllStrategyNumber) {
+        for (int32 i = 0; i < nkeys; i++) {
+            if (check[i] == GIN_FALSE) {
+                res = GIN_FALSE;
+                break;
+            }
+        }
+    } else if (strategy == JsonbExistsStrategyNumber || strategy == JsonbExistsAnyStrategyNumber) {
+        res = GIN_FALSE;
+        for (int32 i = 0; i < nkeys; i++) {
+            if (check[i] != GIN_FALSE) {
+                res = GIN_MAYBE;
+                break;
+            }
+        }
+    } else {
+        ereport(ERROR, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE), errmsg("unrecognized strategy number: %d", strategy)));
+    }
+
+    PG_RETURN_GIN_TERNARY_VALUE(res);
+}
+
+static inline uint32 JsonbGinCombineHash(uint32 hash, uint32 item)
+{
+    hash = (hash << 1) | (hash >> 31);
+    return hash ^ item;
+}
+
+static uint32 JsonbGinScalarHash(const JsonbValue* val)
+{
+    switch (val->type) {
+        case jbvNull:
+            return 0x01;
+        case jbvBool:
+            return val->val.boolean ? 0x02 : 0x04;
+        case jbvNumeric:
+            return DatumGetUInt32(DirectFunctionCall1(hash_numeric, NumericGetDatum(val->val.numeric)));
+        case jbvString:
+            return DatumGetUInt32(hash_any((const unsigned char*)val->val.string.val, val->val.string.len));
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("jsonb value is not a scalar")));
+    }
+    return 0; /* keep compiler quiet */
+}
+
+/* collect one path hash per scalar below container; pathHash covers the keys above it */
+static void JsonbGinExtractPath(const JsonbContainer* container, uint32 pathHash, JsonbGinEntries* entries)
+{
+    uint32 count = JsonbContainerSize(container);
+    bool isObject = JsonbContainerIsObject(container);
+
+    check_stack_depth();
+
+    for (uint32 i = 0; i < count; i++) {
+        uint32 hash = pathHash;
+        JsonbValue value;
+
+        /* array elements do not extend the path */
+        if (isObject) {
+            JsonbGetIthKey(container, i, &value);
+            hash = JsonbGinCombineHash(hash, JsonbGinScalarHash(&value));
+        }
+
+        JsonbGetIthValue(container, i, &value);
+        if (value.type == jbvBinary) {
+            JsonbGinExtractPath(value.val.binary.data, hash, entries);
+        } else {
+            hash = JsonbGinCombineHash(hash, JsonbGinScalarHash(&value));
+            JsonbGinAddEntry(entries, UInt32GetDatum(hash));
+        }
+    }
+}
+
+Datum gin_extract_jsonb_path(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    int32* nentries = (int32*)PG_GETARG_POINTER(1);
+    JsonbGinEntries entries;
+
+    if (JsonbContainerSize(&jb->root) == 0) {
+        *nentries = 0;
+        PG_RETURN_POINTER(NULL);
+    }
+
+    JsonbGinInitEntries(&entries, JsonbContainerSize(&jb->root));
+    JsonbGinExtractPath(&jb->root, 0, &entries);
+
+    *nentries = entries.count;
+    PG_RETURN_POINTER(entries.entries);
+}
+
+Datum gin_extract_jsonb_query_path(PG_FUNCTION_ARGS)
+{
+    int32* nentries = (int32*)PG_GETARG_POINTER(1);
+    StrategyNumber strategy = PG_GETARG_UINT16(2);
+    int32* searchMode = (int32*)PG_GETARG_POINTER(6);
+    Datum* entries = NULL;
+
+    if (strategy != JsonbContainsStrategyNumber) {
+        ereport(ERROR, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE), errmsg("unrecognized strategy number: %d", strategy)));
+    }
+
+    entries = (Datum*)DatumGetPointer(
+        DirectFunctionCall2(gin_extract_jsonb_path, PG_GETARG_DATUM(0), PointerGetDatum(nentries)));
+
+    /* a query without scalars, such as {} or {"a": []}, must scan everything */
+    if (*nentries == 0) {
+        *searchMode = GIN_SEARCH_MODE_ALL;
+    }
+
+    PG_RETURN_POINTER(entries);
+}
+
+Datum gin_consistent_jsonb_path(PG_FUNCTION_ARGS)
+{
+    bool* check = (bool*)PG_GETARG_POINTER(0);
+    StrategyNumber strategy = PG_GETARG_UINT16(1);
+    int32 nkeys = PG_GETARG_INT32(3);
+    bool* recheck = (bool*)PG_GETARG_POINTER(5);
+
+    if (strategy != JsonbContainsStrategyNumber) {
+        ereport(ERROR, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE), errmsg("unrecognized strategy number: %d", strategy)));
+    }
+
+    /* hashes may collide and do not capture array nesting */
+    *recheck = true;
+    for (int32 i = 0; i < nkeys; i++) {
+        if (!check[i]) {
+            PG_RETURN_BOOL(false);
+        }
+    }
+    PG_RETURN_BOOL(true);
+}
+
+Datum gin_triconsistent_jsonb_path(PG_FUNCTION_ARGS)
+{
+    GinTernaryValue* check = (GinTernaryValue*)PG_GETARG_POINTER(0);
+    StrategyNumber strategy = PG_GETARG_UINT16(1);
+    int32 nkeys = PG_GETARG_INT32(3);
+
+    if (strategy != JsonbContainsStrategyNumber) {
+        ereport(ERROR, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE), errmsg("unrecognized strategy number: %d", strategy)));
+    }
+
+    for (int32 i = 0; i < nkeys; i++) {
+        if (check[i] == GIN_FALSE) {
+            PG_RETURN_GIN_TERNARY_VALUE(GIN_FALSE);
+        }
+    }
+    PG_RETURN_GIN_TERNARY_VALUE(GIN_MAYBE);
+}
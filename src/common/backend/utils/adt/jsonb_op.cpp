@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jsonb_op.cpp
+ *	  Accessor, existence, containment and comparison operators for jsonb.
+ *
+ * All of these work directly on the serialized form: object keys are found
+ * by binary search and array elements by offset, without converting the
+ * value back to text.
+ *
+ * IDENTIFICATION
+ *	  src/common/backend/utils/adt/jsonb_op.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "catalog/pg_type.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/jsonb.h"
+
+/* the element at index of an array container, or false if there is none */
+static bool JsonbGetArrayElement(const JsonbContainer* container, int64 index, JsonbValue* result)
+{
+    if (!JsonbContainerIsArray(container) || JsonbContainerIsScalar(container)) {
+        return false;
+    }
+    if (index < 0 || index >= (int64)JsonbContainerSize(container)) {
+        return false;
+    }
+    JsonbGetIthValue(container, (uint32)index, result);
+    return true;
+}
+
+/* a JsonbValue as a jsonb datum of its own */
+static Datum JsonbValueGetJsonbDatum(JsonbValue* val)
+{
+    return JsonbGetDatum(JsonbValueToJsonb(val));
+}
+
+/*
+ * A JsonbValue as text for the ->> family: strings lose their quotes,
+ * JSON null becomes SQL NULL and everything else is its JSON text.
+ */
+static text* JsonbValueAsText(const JsonbValue* val)
+{
+    StringInfoData out;
+
+    if (val->type == jbvNull) {
+        return NULL;
+    }
+    if (val->type == jbvString) {
+        return cstring_to_text_with_len(val->val.string.val, val->val.string.len);
+    }
+
+    initStringInfo(&out);
+    JsonbValueToCString(&out, val);
+    return cstring_to_text_with_len(out.data, out.len);
+}
+
+/* follow a text[] path from the root; false if some step does not exist */
+static bool JsonbExtractPath(Jsonb* jb, ArrayType* path, JsonbValue* result)
+{
+    Datum* pathtext = NULL;
+    bool* pathnulls = NULL;
+    int npath;
+    const JsonbContainer* container = &jb->root;
+
+    if (ARR_NDIM(path) > 1) {
+        ereport(ERROR, (errcode(ERRCODE_ARRAY_SUBSCRIPT_ERROR), errmsg("wrong number of array subscripts")));
+    }
+
+    deconstruct_array(path, TEXTOID, -1, false, 'i', &pathtext, &pathnulls, &npath);
+
+    /* an empty path yields the whole value */
+    result->type = jbvBinary;
+    result->val.binary.data = (JsonbContainer*)container;
+    result->val.binary.len = VARSIZE(jb) - VARHDRSZ;
+
+    for (int i = 0; i < npath; i++) {
+        char* step = NULL;
+        int steplen;
+
+        if (pathnulls[i] || result->type != jbvBinary) {
+            return false;
+        }
+
+        container = result->val.binary.data;
+        step = VARDATA_ANY(DatumGetPointer(pathtext[i]));
+        steplen = VARSIZE_ANY_EXHDR(DatumGetPointer(pathtext[i]));
+
+        if (JsonbContainerIsObject(container)) {
+            if (!JsonbFindKey(container, step, steplen, result)) {
+                return false;
+            }
+        } else {
+            char* str = pnstrdup(step, steplen);
+            char* endptr = NULL;
+            long index;
+
+            errno = 0;
+            index = strtol(str, &endptr, 10);
+            if (endptr == str || *endptr != '\0' || errno != 0 || !JsonbGetArrayElement(container, index, result)) {
+                return false;
+            }
+        }
+    }
+
+    /* a top-level scalar is returned as itself, not as its wrapper */
+    if (result->type == jbvBinary && JsonbContainerIsScalar(result->val.binary.data)) {
+        JsonbGetIthValue(result->val.binary.data, 0, result);
+    }
+    return true;
+}
+
+/*
+ * jsonb -> text
+ */
+Datum jsonb_object_field(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    text* key = PG_GETARG_TEXT_PP(1);
+    JsonbValue value;
+
+    if (!JsonbFindKey(&jb->root, VARDATA_ANY(key), VARSIZE_ANY_EXHDR(key), &value)) {
+        PG_RETURN_NULL();
+    }
+    PG_RETURN_DATUM(JsonbValueGetJsonbDatum(&value));
+}
+
+/*
+ * jsonb ->> text
+ */
+Datum jsonb_object_field_text(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    text* key = PG_GETARG_TEXT_PP(1);
+    JsonbValue value;
+    text* result = NULL;
+
+    if (!JsonbFindKey(&jb->root, VARDATA_ANY(key), VARSIZE_ANY_EXHDR(key), &value)) {
+        PG_RETURN_NULL();
+    }
+    result = JsonbValueAsText(&value);
+    if (result == NULL) {
+        PG_RETURN_NULL();
+    }
+    PG_RETURN_TEXT_P(result);
+}
+
+/*
+ * jsonb -> int4
+ */
+Datum jsonb_array_element(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    int32 index = PG_GETARG_INT32(1);
+    JsonbValue value;
+
+    if (!JsonbGetArrayElement(&jb->root, index, &value)) {
+        PG_RETURN_NULL();
+    }
+    PG_RETURN_DATUM(JsonbValueGetJsonbDatum(&value));
+}
+
+/*
+ * jsonb ->> int4
+ */
+Datum jsonb_array_element_text(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    int32 index = PG_GETARG_INT32(1);
+    JsonbValue value;
+    text* result = NULL;
+
+    if (!JsonbGetArrayElement(&jb->root, index, &value)) {
+        PG_RETURN_NULL();
+    }
+    result = JsonbValueAsText(&value);
+    if (result == NULL) {
+        PG_RETURN_NULL();
+    }
+    PG_RETURN_TEXT_P(result);
+}
+
+/*
+ * jsonb #> text[]
+ */
+Datum jsonb_extract_path(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    ArrayType* path = PG_GETARG_ARRAYTYPE_P(1);
+    JsonbValue value;
+
+    if (!JsonbExtractPath(jb, path, &value)) {
+        PG_RETURN_NULL();
+    }
+    PG_RETURN_DATUM(JsonbValueGetJsonbDatum(&value));
+}
+
+/*
+ * jsonb #>> text[]
+ */
+Datum jsonb_extract_path_text(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    ArrayType* path = PG_GETARG_ARRAYTYPE_P(1);
+    JsonbValue value;
+    text* result = NULL;
+
+    if (!JsonbExtractPath(jb, path, &value)) {
+        PG_RETURN_NULL();
+    }
+    result = JsonbValueAsText(&value);
+    if (result == NULL) {
+        PG_RETURN_NULL();
+    }
+    PG_RETURN_TEXT_P(result);
+}
+
+/* is str a top-level key of an object, or a string element of an array? */
+static bool JsonbHasKey(const JsonbContainer* container, const char* str, int len)
+{
+    JsonbValue value;
+
+    if (JsonbContainerIsObject(container)) {
+        return JsonbFindKey(container, str, len, &value);
+    }
+    return JsonbFindStringElement(container, str, len);
+}
+
+/*
+ * jsonb ? text
+ */
+Datum jsonb_exists(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    text* key = PG_GETARG_TEXT_PP(1);
+
+    PG_RETURN_BOOL(JsonbHasKey(&jb->root, VARDATA_ANY(key), VARSIZE_ANY_EXHDR(key)));
+}
+
+static bool JsonbExistsArray(Jsonb* jb, ArrayType* keys, bool any)
+{
+    Datum* keydatums = NULL;
+    bool* keynulls = NULL;
+    int nkeys;
+
+    deconstruct_array(keys, TEXTOID, -1, false, 'i', &keydatums, &keynulls, &nkeys);
+
+    for (int i = 0; i < nkeys; i++) {
+        bool found = false;
+
+        /* null keys never exist, but do not make ?& fail */
+        if (keynulls[i]) {
+            continue;
+        }
+        found = JsonbHasKey(
+            &jb->root, VARDATA_ANY(DatumGetPointer(keydatums[i])), VARSIZE_ANY_EXHDR(DatumGetPointer(keydatums[i])));
+        if (found && any) {
+            return true;
+        }
+        if (!found && !any) {
+            return false;
+        }
+    }
+    return !any;
+}
+
+/*
+ * jsonb ?| text[]
+ */
+Datum jsonb_exists_any(PG_FUNCTION_ARGS)
+{
+    PG_RETURN_BOOL(JsonbExistsArray(PG_GETARG_JSONB(0), PG_GETARG_ARRAYTYPE_P(1), true));
+}
+
+/*
+ * jsonb ?& text[]
+ */
+Datum jsonb_exists_all(PG_FUNCTION_ARGS)
+{
+    PG_RETURN_BOOL(JsonbExistsArray(PG_GETARG_JSONB(0), PG_GETARG_ARRAYTYPE_P(1), false));
+}
+
+/*
+ * jsonb @> jsonb
+ */
+Datum jsonb_contains(PG_FUNCTION_ARGS)
+{
+    Jsonb* val = PG_GETARG_JSONB(0);
+    Jsonb* tmpl = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(JsonbDeepContains(&val->root, &tmpl->root));
+}
+
+/*
+ * jsonb <@ jsonb
+ */
+Datum jsonb_contained(PG_FUNCTION_ARGS)
+{
+    Jsonb* tmpl = PG_GETARG_JSONB(0);
+    Jsonb* val = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(JsonbDeepContains(&val->root, &tmpl->root));
+}
+
+/*
+ * jsonb = jsonb
+ */
+Datum jsonb_eq(PG_FUNCTION_ARGS)
+{
+    Jsonb* a = PG_GETARG_JSONB(0);
+    Jsonb* b = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(JsonbContainerEquals(&a->root, &b->root));
+}
+
+/*
+ * jsonb <> jsonb
+ */
+Datum jsonb_ne(PG_FUNCTION_ARGS)
+{
+    Jsonb* a = PG_GETARG_JSONB(0);
+    Jsonb* b = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(!JsonbContainerEquals(&a->root, &b->root));
+}
+
+/*
+ * jsonb < jsonb, and friends
+ */
+Datum jsonb_lt(PG_FUNCTION_ARGS)
+{
+    Jsonb* a = PG_GETARG_JSONB(0);
+    Jsonb* b = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(JsonbContainerCompare(&a->root, &b->root) < 0);
+}
+
+Datum jsonb_gt(PG_FUNCTION_ARGS)
+{
+    Jsonb* a = PG_GETARG_JSONB(0);
+    Jsonb* b = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(JsonbContainerCompare(&a->root, &b->root) > 0);
+}
+
+Datum jsonb_le(PG_FUNCTION_ARGS)
+{
+    Jsonb* a = PG_GETARG_JSONB(0);
+    Jsonb* b = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(JsonbContainerCompare(&a->root, &b->root) <= 0);
+}
+
+Datum jsonb_ge(PG_FUNCTION_ARGS)
+{
+    Jsonb* a = PG_GETARG_JSONB(0);
+    Jsonb* b = PG_GETARG_JSONB(1);
+
+    PG_RETURN_BOOL(JsonbContainerCompare(&a->root, &b->root) >= 0);
+}
+
+/*
+ * B-tree support function
+ */
+Datum jsonb_cmp(PG_FUNCTION_ARGS)
+{
+    Jsonb* a = PG_GETARG_JSONB(0);
+    Jsonb* b = PG_GETARG_JSONB(1);
+    int res = JsonbContainerCompare(&a->root, &b->root);
+
+    PG_FREE_IF_COPY(a, 0);
+    PG_FREE_IF_COPY(b, 1);
+    PG_RETURN_INT32(res);
+}
+
+/*
+ * hash support function
+ */
+Datum jsonb_hash(PG_FUNCTION_ARGS)
+{
+    Jsonb* jb = PG_GETARG_JSONB(0);
+    uint32 hash = JsonbContainerHash(&jb->root);
+
+    PG_FREE_IF_COPY(jb, 0);
+    PG_RETURN_UINT32(hash);
+}
@@ -0,0 +1,693 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jsonb_util.cpp
+ *	  Building, reading and comparing the on-disk jsonb format.
+ *
+ * See utils/jsonb.h for a description of the format.
+ *
+ * IDENTIFICATION
+ *	  src/common/backend/utils/adt/jsonb_util.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/hash.h"
+#include "catalog/pg_collation.h"
+#include "miscadmin.h"
+#include "utils/builtins.h"
+#include "utils/jsonb.h"
+#include "utils/memutils.h"
+
+static void ConvertJsonbValue(StringInfo buf, JEntry* jentry, const JsonbValue* val, int level);
+
+/* the JEntries of a container, and where the data of its children starts */
+#define JsonbNumChildren(jc_) (JsonbContainerIsObject(jc_) ? JsonbContainerSize(jc_) * 2 : JsonbContainerSize(jc_))
+#define JsonbDataStart(jc_) ((const char*)&(jc_)->children[JsonbNumChildren(jc_)])
+#define JsonbChildStart(jc_, i_) ((i_) == 0 ? 0 : JBE_ENDPOS((jc_)->children[(i_)-1]))
+
+static void JsonbPadToInt(StringInfo buf)
+{
+    int padlen = INTALIGN(buf->len) - buf->len;
+
+    for (int i = 0; i < padlen; i++) {
+        appendStringInfoCharMacro(buf, '\0');
+    }
+}
+
+/* reserve len bytes at the end of buf, return their offset */
+static int JsonbReserve(StringInfo buf, int len)
+{
+    int offset;
+
+    enlargeStringInfo(buf, len);
+    offset = buf->len;
+    buf->len += len;
+    buf->data[buf->len] = '\0';
+    return offset;
+}
+
+static void ConvertJsonbContainer(StringInfo buf, const JsonbValue* val, int level)
+{
+    uint32 header;
+    int nchildren;
+    int headerOffset;
+    int dataStart;
+    errno_t rc;
+
+    check_stack_depth();
+
+    /* containers always start on an int boundary */
+    Assert(buf->len == INTALIGN(buf->len));
+
+    if (val->type == jbvArray) {
+        if ((uint32)val->val.array.nelems > JSONB_MAX_ELEMS) {
+            ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                errmsg("number of jsonb array elements exceeds the maximum allowed (%u)", JSONB_MAX_ELEMS)));
+        }
+        nchildren = val->val.array.nelems;
+        header = (uint32)nchildren | JB_FARRAY;
+        if (val->val.array.rawScalar) {
+            Assert(nchildren == 1 && level == 0);
+            header |= JB_FSCALAR;
+        }
+    } else {
+        Assert(val->type == jbvObject);
+        if ((uint32)val->val.object.npairs > JSONB_MAX_PAIRS) {
+            ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                errmsg("number of jsonb object pairs exceeds the maximum allowed (%u)", JSONB_MAX_PAIRS)));
+        }
+        nchildren = val->val.object.npairs * 2;
+        header = (uint32)val->val.object.npairs | JB_FOBJECT;
+    }
+
+    headerOffset = JsonbReserve(buf, sizeof(uint32) + nchildren * sizeof(JEntry));
+    rc = memcpy_s(buf->data + headerOffset, sizeof(uint32), &header, sizeof(uint32));
+    securec_check(rc, "\0", "\0");
+    dataStart = buf->len;
+
+    for (int i = 0; i < nchildren; i++) {
+        const JsonbValue* child = NULL;
+        JEntry jentry;
+        uint32 totallen;
+
+        if (val->type == jbvArray) {
+            child = &val->val.array.elems[i];
+        } else if (i < val->val.object.npairs) {
+            child = &val->val.object.pairs[i].key;
+        } else {
+            child = &val->val.object.pairs[i - val->val.object.npairs].value;
+        }
+
+        ConvertJsonbValue(buf, &jentry, child, level + 1);
+
+        totallen = (uint32)(buf->len - dataStart);
+        if (totallen > JENTRY_OFFMASK) {
+            ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                errmsg("total size of jsonb container elements exceeds the maximum of %u bytes", JENTRY_OFFMASK)));
+        }
+        jentry |= totallen;
+
+        rc = memcpy_s(buf->data + headerOffset + sizeof(uint32) + i * sizeof(JEntry), sizeof(JEntry),
+            &jentry, sizeof(JEntry));
+        securec_check(rc, "\0", "\0");
+    }
+}
+
+/*
+ * Append the data of val to buf and set *jentry to its type.  The caller
+ * fills in the end offset.
+ */
+static void ConvertJsonbValue(StringInfo buf, JEntry* jentry, const JsonbValue* val, int level)
+{
+    switch (val->type) {
+        case jbvNull:
+            *jentry = JENTRY_ISNULL;
+            break;
+        case jbvBool:
+            *jentry = val->val.boolean ? JENTRY_ISBOOL_TRUE : JENTRY_ISBOOL_FALSE;
+            break;
+        case jbvString:
+            appendBinaryStringInfo(buf, val->val.string.val, val->val.string.len);
+            *jentry = JENTRY_ISSTRING;
+            break;
+        case jbvNumeric:
+            JsonbPadToInt(buf);
+            appendBinaryStringInfo(buf, (const char*)val->val.numeric, VARSIZE(val->val.numeric));
+            *jentry = JENTRY_ISNUMERIC;
+            break;
+        case jbvArray:
+        case jbvObject:
+            JsonbPadToInt(buf);
+            ConvertJsonbContainer(buf, val, level);
+            *jentry = JENTRY_ISCONTAINER;
+            break;
+        case jbvBinary: {
+            JsonbPadToInt(buf);
+            appendBinaryStringInfo(buf, (const char*)val->val.binary.data, val->val.binary.len);
+            *jentry = JENTRY_ISCONTAINER;
+            break;
+        }
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("unknown jsonb value type %d", (int)val->type)));
+    }
+}
+
+/*
+ * JsonbValueToJsonb - serialize a JsonbValue tree
+ *
+ * A scalar is wrapped in a one-element raw scalar array.  Objects must have
+ * been passed through JsonbUniquifyObject.
+ */
+Jsonb* JsonbValueToJsonb(JsonbValue* val)
+{
+    StringInfoData buf;
+    JsonbValue scalarArray;
+
+    if (IsAJsonbScalar(val)) {
+        scalarArray.type = jbvArray;
+        scalarArray.val.array.nelems = 1;
+        scalarArray.val.array.elems = val;
+        scalarArray.val.array.rawScalar = true;
+        val = &scalarArray;
+    }
+
+    if (val->type == jbvBinary) {
+        return JsonbContainerToJsonb(val->val.binary.data, val->val.binary.len);
+    }
+
+    initStringInfo(&buf);
+    (void)JsonbReserve(&buf, VARHDRSZ);
+    ConvertJsonbContainer(&buf, val, 0);
+    SET_VARSIZE(buf.data, buf.len);
+
+    return (Jsonb*)buf.data;
+}
+
+/*
+ * JsonbContainerToJsonb - copy a nested container into a jsonb of its own
+ *
+ * The container was int-aligned inside its parent, and it is int-aligned
+ * again right after the varlena header, so the padding inside it stays
+ * valid.
+ */
+Jsonb* JsonbContainerToJsonb(const JsonbContainer* container, int len)
+{
+    Jsonb* result = (Jsonb*)palloc(VARHDRSZ + len);
+    errno_t rc;
+
+    SET_VARSIZE(result, VARHDRSZ + len);
+    rc = memcpy_s(&result->root, len, container, len);
+    securec_check(rc, "\0", "\0");
+    return result;
+}
+
+/* order of object keys: by length first, then bytewise */
+static int JsonbKeyCompare(const char* a, int alen, const char* b, int blen)
+{
+    if (alen != blen) {
+        return (alen > blen) ? 1 : -1;
+    }
+    return memcmp(a, b, alen);
+}
+
+static int JsonbPairCompare(const void* a, const void* b)
+{
+    const JsonbPair* pa = (const JsonbPair*)a;
+    const JsonbPair* pb = (const JsonbPair*)b;
+    int res = JsonbKeyCompare(
+        pa->key.val.string.val, pa->key.val.string.len, pb->key.val.string.val, pb->key.val.string.len);
+
+    /* equal keys are ordered by input position, so the last one comes last */
+    if (res == 0) {
+        res = (pa->order > pb->order) ? 1 : -1;
+    }
+    return res;
+}
+
+/*
+ * JsonbUniquifyObject - sort the pairs of an object and drop duplicate keys
+ *
+ * As with json_object_field in other databases, the last of several equal
+ * keys wins.
+ */
+void JsonbUniquifyObject(JsonbValue* object)
+{
+    JsonbPair* pairs = object->val.object.pairs;
+    int npairs = object->val.object.npairs;
+    int res = 0;
+
+    Assert(object->type == jbvObject);
+
+    if (npairs <= 1) {
+        return;
+    }
+
+    qsort(pairs, npairs, sizeof(JsonbPair), JsonbPairCompare);
+
+    for (int i = 1; i < npairs; i++) {
+        if (JsonbKeyCompare(pairs[i].key.val.string.val, pairs[i].key.val.string.len, pairs[res].key.val.string.val,
+                pairs[res].key.val.string.len) != 0) {
+            res++;
+        }
+        pairs[res] = pairs[i];
+    }
+    object->val.object.npairs = res + 1;
+}
+
+/* fill *result from child number index of container */
+static void JsonbFillValue(const JsonbContainer* container, uint32 index, JsonbValue* result)
+{
+    const char* base = JsonbDataStart(container);
+    JEntry jentry = container->children[index];
+    uint32 start = JsonbChildStart(container, index);
+    uint32 end = JBE_ENDPOS(jentry);
+
+    switch (JBE_TYPE(jentry)) {
+        case JENTRY_ISSTRING:
+            result->type = jbvString;
+            result->val.string.val = (char*)base + start;
+            result->val.string.len = (int)(end - start);
+            break;
+        case JENTRY_ISNUMERIC:
+            result->type = jbvNumeric;
+            result->val.numeric = (Numeric)(base + INTALIGN(start));
+            break;
+        case JENTRY_ISBOOL_TRUE:
+            result->type = jbvBool;
+            result->val.boolean = true;
+            break;
+        case JENTRY_ISBOOL_FALSE:
+            result->type = jbvBool;
+            result->val.boolean = false;
+            break;
+        case JENTRY_ISNULL:
+            result->type = jbvNull;
+            break;
+        case JENTRY_ISCONTAINER:
+            result->type = jbvBinary;
+            result->val.binary.data = (JsonbContainer*)(base + INTALIGN(start));
+            result->val.binary.len = (int)(end - INTALIGN(start));
+            break;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("invalid jsonb entry type 0x%08x", jentry)));
+    }
+}
+
+/*
+ * JsonbGetIthValue - the i'th element of an array, or the value of the
+ * i'th pair of an object
+ */
+void JsonbGetIthValue(const JsonbContainer* container, uint32 i, JsonbValue* result)
+{
+    Assert(i < JsonbContainerSize(container));
+
+    if (JsonbContainerIsObject(container)) {
+        i += JsonbContainerSize(container);
+    }
+    JsonbFillValue(container, i, result);
+}
+
+/* JsonbGetIthKey - the key of the i'th pair of an object */
+void JsonbGetIthKey(const JsonbContainer* container, uint32 i, JsonbValue* result)
+{
+    Assert(JsonbContainerIsObject(container) && i < JsonbContainerSize(container));
+
+    JsonbFillValue(container, i, result);
+}
+
+/*
+ * JsonbFindKey - look up key in an object by binary search
+ *
+ * Returns false if container is not an object or has no such key;
+ * otherwise fills *result with the value.
+ */
+bool JsonbFindKey(const JsonbContainer* container, const char* key, int keylen, JsonbValue* result)
+{
+    const char* base = NULL;
+    uint32 low = 0;
+    uint32 high;
+
+    if (!JsonbContainerIsObject(container)) {
+        return false;
+    }
+
+    base = JsonbDataStart(container);
+    high = JsonbContainerSize(container);
+    while (low < high) {
+        uint32 mid = low + (high - low) / 2;
+        uint32 start = JsonbChildStart(container, mid);
+        int cmp = JsonbKeyCompare(base + start, (int)(JBE_ENDPOS(container->children[mid]) - start), key, keylen);
+
+        if (cmp == 0) {
+            JsonbGetIthValue(container, mid, result);
+            return true;
+        } else if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return false;
+}
+
+/*
+ * JsonbFindStringElement - does the array container have a string element
+ * equal to str?
+ */
+bool JsonbFindStringElement(const JsonbContainer* container, const char* str, int len)
+{
+    const char* base = NULL;
+    uint32 nelems;
+
+    if (!JsonbContainerIsArray(container)) {
+        return false;
+    }
+
+    base = JsonbDataStart(container);
+    nelems = JsonbContainerSize(container);
+    for (uint32 i = 0; i < nelems; i++) {
+        JEntry jentry = container->children[i];
+        uint32 start = JsonbChildStart(container, i);
+
+        if (JBE_TYPE(jentry) == JENTRY_ISSTRING && (int)(JBE_ENDPOS(jentry) - start) == len &&
+            memcmp(base + start, str, len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * JsonbScalarEquals - compare two scalars
+ *
+ * Numbers compare by value, so 1 and 1.0 are equal.
+ */
+bool JsonbScalarEquals(const JsonbValue* a, const JsonbValue* b)
+{
+    if (a->type != b->type) {
+        return false;
+    }
+
+    switch (a->type) {
+        case jbvNull:
+            return true;
+        case jbvBool:
+            return a->val.boolean == b->val.boolean;
+        case jbvString:
+            return a->val.string.len == b->val.string.len &&
+                   memcmp(a->val.string.val, b->val.string.val, a->val.string.len) == 0;
+        case jbvNumeric:
+            return cmp_numerics(a->val.numeric, b->val.numeric) == 0;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("jsonb value is not a scalar")));
+    }
+    return false; /* keep compiler quiet */
+}
+
+static bool JsonbValueEquals(const JsonbValue* a, const JsonbValue* b)
+{
+    if (a->type == jbvBinary || b->type == jbvBinary) {
+        return a->type == b->type && JsonbContainerEquals(a->val.binary.data, b->val.binary.data);
+    }
+    return JsonbScalarEquals(a, b);
+}
+
+/*
+ * JsonbContainerEquals - deep equality of two containers
+ *
+ * Objects have sorted unique keys, so their pairs can be compared
+ * position by position.
+ */
+bool JsonbContainerEquals(const JsonbContainer* a, const JsonbContainer* b)
+{
+    uint32 nchildren;
+
+    check_stack_depth();
+
+    if ((a->header & ~JB_CMASK) != (b->header & ~JB_CMASK) || JsonbContainerSize(a) != JsonbContainerSize(b)) {
+        return false;
+    }
+
+    nchildren = JsonbNumChildren(a);
+    for (uint32 i = 0; i < nchildren; i++) {
+        JsonbValue va;
+        JsonbValue vb;
+
+        JsonbFillValue(a, i, &va);
+        JsonbFillValue(b, i, &vb);
+        if (!JsonbValueEquals(&va, &vb)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * JsonbDeepContains - does val contain tmpl?
+ *
+ * An object contains another if it has every key of it with a value that
+ * contains the corresponding value.  An array contains another if every
+ * element of it is contained in some element of the first, regardless of
+ * order and duplicates.  As a special case a top-level array contains a
+ * bare scalar equal to one of its elements, but a bare scalar contains no
+ * array.
+ */
+bool JsonbDeepContains(const JsonbContainer* val, const JsonbContainer* tmpl)
+{
+    uint32 ntmpl = JsonbContainerSize(tmpl);
+
+    check_stack_depth();
+
+    if (JsonbContainerIsObject(val) != JsonbContainerIsObject(tmpl)) {
+        return false;
+    }
+
+    if (JsonbContainerIsObject(tmpl)) {
+        /* an object with fewer keys cannot contain this one */
+        if (JsonbContainerSize(val) < ntmpl) {
+            return false;
+        }
+
+        for (uint32 i = 0; i < ntmpl; i++) {
+            JsonbValue key;
+            JsonbValue tvalue;
+            JsonbValue vvalue;
+
+            JsonbGetIthKey(tmpl, i, &key);
+            if (!JsonbFindKey(val, key.val.string.val, key.val.string.len, &vvalue)) {
+                return false;
+            }
+
+            JsonbGetIthValue(tmpl, i, &tvalue);
+            if (tvalue.type == jbvBinary) {
+                if (vvalue.type != jbvBinary || !JsonbDeepContains(vvalue.val.binary.data, tvalue.val.binary.data)) {
+                    return false;
+                }
+            } else if (!JsonbScalarEquals(&vvalue, &tvalue)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (JsonbContainerIsScalar(val) && !JsonbContainerIsScalar(tmpl)) {
+        return false;
+    }
+
+    for (uint32 i = 0; i < ntmpl; i++) {
+        JsonbValue tvalue;
+        uint32 nval = JsonbContainerSize(val);
+        bool found = false;
+
+        JsonbGetIthValue(tmpl, i, &tvalue);
+        if (tvalue.type == jbvString) {
+            found = JsonbFindStringElement(val, tvalue.val.string.val, tvalue.val.string.len);
+        } else {
+            for (uint32 j = 0; j < nval && !found; j++) {
+                JsonbValue vvalue;
+
+                JsonbGetIthValue(val, j, &vvalue);
+                if (tvalue.type == jbvBinary) {
+                    found = vvalue.type == jbvBinary &&
+                            JsonbContainerIsObject(vvalue.val.binary.data) ==
+                                JsonbContainerIsObject(tvalue.val.binary.data) &&
+                            JsonbDeepContains(vvalue.val.binary.data, tvalue.val.binary.data);
+                } else {
+                    found = vvalue.type != jbvBinary && JsonbScalarEquals(&vvalue, &tvalue);
+                }
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* sort rank of a value's type: null < string < number < boolean < array < object */
+static int JsonbValueRank(const JsonbValue* val)
+{
+    switch (val->type) {
+        case jbvNull:
+            return 0;
+        case jbvString:
+            return 1;
+        case jbvNumeric:
+            return 2;
+        case jbvBool:
+            return 3;
+        case jbvBinary:
+            return JsonbContainerIsObject(val->val.binary.data) ? 5 : 4;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("unexpected jsonb value type %d", val->type)));
+    }
+    return 0; /* keep compiler quiet */
+}
+
+static int JsonbValueCompare(const JsonbValue* a, const JsonbValue* b)
+{
+    int ranka = JsonbValueRank(a);
+    int rankb = JsonbValueRank(b);
+
+    if (ranka != rankb) {
+        return (ranka > rankb) ? 1 : -1;
+    }
+
+    switch (a->type) {
+        case jbvNull:
+            return 0;
+        case jbvString:
+            return varstr_cmp(
+                a->val.string.val, a->val.string.len, b->val.string.val, b->val.string.len, DEFAULT_COLLATION_OID);
+        case jbvNumeric:
+            return cmp_numerics(a->val.numeric, b->val.numeric);
+        case jbvBool:
+            return (a->val.boolean == b->val.boolean) ? 0 : (a->val.boolean ? 1 : -1);
+        default:
+            return JsonbContainerCompare(a->val.binary.data, b->val.binary.data);
+    }
+}
+
+/*
+ * JsonbContainerCompare - total order of jsonb values, for B-tree indexes
+ *
+ * Values of different types sort by type; see JsonbValueRank.  A top-level
+ * scalar sorts as the scalar itself.  Containers with more elements or
+ * pairs sort after those with fewer, and otherwise compare child by child
+ * in storage order, an object's pairs key first.  The result is zero
+ * exactly when JsonbContainerEquals is true.
+ */
+int JsonbContainerCompare(const JsonbContainer* a, const JsonbContainer* b)
+{
+    uint32 nchildren;
+
+    check_stack_depth();
+
+    if (JsonbContainerIsScalar(a) || JsonbContainerIsScalar(b)) {
+        JsonbValue va;
+        JsonbValue vb;
+
+        if (JsonbContainerIsScalar(a)) {
+            JsonbFillValue(a, 0, &va);
+        } else {
+            va.type = jbvBinary;
+            va.val.binary.data = (JsonbContainer*)a;
+        }
+        if (JsonbContainerIsScalar(b)) {
+            JsonbFillValue(b, 0, &vb);
+        } else {
+            vb.type = jbvBinary;
+            vb.val.binary.data = (JsonbContainer*)b;
+        }
+        return JsonbValueCompare(&va, &vb);
+    }
+
+    if (JsonbContainerIsObject(a) != JsonbContainerIsObject(b)) {
+        return JsonbContainerIsObject(a) ? 1 : -1;
+    }
+    if (JsonbContainerSize(a) != JsonbContainerSize(b)) {
+        return (JsonbContainerSize(a) > JsonbContainerSize(b)) ? 1 : -1;
+    }
+
+    nchildren = JsonbContainerSize(a);
+    for (uint32 i = 0; i < nchildren; i++) {
+        JsonbValue va;
+        JsonbValue vb;
+        int res;
+
+        if (JsonbContainerIsObject(a)) {
+            JsonbGetIthKey(a, i, &va);
+            JsonbGetIthKey(b, i, &vb);
+            res = JsonbValueCompare(&va, &vb);
+            if (res != 0) {
+                return res;
+            }
+        }
+
+        JsonbGetIthValue(a, i, &va);
+        JsonbGetIthValue(b, i, &vb);
+        res = JsonbValueCompare(&va, &vb);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static uint32 JsonbValueHash(const JsonbValue* val)
+{
+    switch (val->type) {
+        case jbvNull:
+            return 0x01;
+        case jbvString:
+            return DatumGetUInt32(hash_any((const unsigned char*)val->val.string.val, val->val.string.len));
+        case jbvNumeric:
+            /* must hash equal values such as 1 and 1.0 alike */
+            return DatumGetUInt32(DirectFunctionCall1(hash_numeric, NumericGetDatum(val->val.numeric)));
+        case jbvBool:
+            return val->val.boolean ? 0x02 : 0x04;
+        case jbvBinary:
+            return JsonbContainerHash(val->val.binary.data);
+        default:
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("unexpected jsonb value type %d", val->type)));
+    }
+    return 0; /* keep compiler quiet */
+}
+
+/*
+ * JsonbContainerHash - hash of a jsonb value, consistent with
+ * JsonbContainerEquals
+ */
+uint32 JsonbContainerHash(const JsonbContainer* container)
+{
+    uint32 hash = container->header & ~JB_CMASK;
+    uint32 nchildren;
+
+    check_stack_depth();
+
+    nchildren = JsonbNumChildren(container);
+    for (uint32 i = 0; i < nchildren; i++) {
+        JsonbValue val;
+
+        JsonbFillValue(container, i, &val);
+        hash = (hash << 1) | (hash >> 31);
+        hash ^= JsonbValueHash(&val);
+    }
+    return hash;
+}
@@ -213,6 +213,217 @@ static inline int Generic_Text_IC_like(text* str, text* pat, Oid collation)
     }
 }
 
+/*
+ * Compiled LIKE patterns.
+ *
+ * A pattern made only of literal text and '%' is a sequence of literal
+ * fragments: the first is anchored at the start of the string unless the
+ * pattern begins with '%', the last at the end unless it finishes with '%',
+ * and the ones in between only have to occur in order.  Taking the leftmost
+ * occurrence of each is always safe, so such a pattern is matched with a
+ * memcmp() per anchor plus a memchr()-driven substring search per floating
+ * fragment, instead of the backtracking interpreter in like_match.cpp.  That
+ * is the shape of typical log searches like '%error%'.
+ *
+ * Everything else (patterns with '_' or escapes) keeps using the
+ * interpreter.  Byte-wise searching is only exact when a match cannot start
+ * in the middle of a character, so in multibyte encodings other than UTF8
+ * only exact and prefix patterns are compiled.
+ */
+typedef struct LikeFragment {
+    int off; /* offset in the pattern */
+    int len;
+} LikeFragment;
+
+struct LikeMatcher {
+    char* pattern; /* the source pattern, also the fragments' text */
+    int patlen;
+    bool simple;         /* false: use GenericMatchText */
+    bool has_wildcard;   /* false: the whole pattern is one literal */
+    bool anchored_start; /* first fragment is a prefix */
+    bool anchored_end;   /* last fragment is a suffix */
+    int minlen;          /* total length of the fragments */
+    int nfrags;
+    LikeFragment frags[FLEXIBLE_ARRAY_MEMBER];
+};
+
+LikeMatcher* CompileLikePattern(const char* p, int plen, MemoryContext cxt)
+{
+    LikeMatcher* m = NULL;
+    int npercent = 0;
+    bool simple = true;
+    int fragstart = 0;
+    errno_t rc;
+
+    for (int i = 0; i < plen; i++) {
+        if (p[i] == '%') {
+            npercent++;
+        } else if (p[i] == '_' || p[i] == '\\') {
+            simple = false;
+        }
+    }
+
+    m = (LikeMatcher*)MemoryContextAllocZero(
+        cxt, offsetof(LikeMatcher, frags) + (npercent + 1) * sizeof(LikeFragment) + plen + 1);
+    m->pattern = (char*)&m->frags[npercent + 1];
+    m->patlen = plen;
+    if (plen > 0) {
+        rc = memcpy_s(m->pattern, plen, p, plen);
+        securec_check(rc, "\0", "\0");
+    }
+    m->simple = simple;
+    if (!simple) {
+        return m;
+    }
+
+    m->has_wildcard = (npercent > 0);
+    m->anchored_start = (plen == 0 || p[0] != '%');
+    m->anchored_end = (plen == 0 || p[plen - 1] != '%');
+
+    /* split on '%', dropping the empty fragments between adjacent ones */
+    for (int i = 0; i <= plen; i++) {
+        if (i == plen || p[i] == '%') {
+            if (i > fragstart) {
+                m->frags[m->nfrags].off = fragstart;
+                m->frags[m->nfrags].len = i - fragstart;
+                m->nfrags++;
+                m->minlen += i - fragstart;
+            }
+            fragstart = i + 1;
+        }
+    }
+
+    if (m->has_wildcard && pg_database_encoding_max_length() > 1 && GetDatabaseEncoding() != PG_UTF8 &&
+        (m->anchored_end || m->nfrags > (m->anchored_start ? 1 : 0))) {
+        m->simple = false;
+    }
+
+    return m;
+}
+
+/* was m compiled from pattern p? */
+bool LikeMatcherIsFor(const LikeMatcher* m, const char* p, int plen)
+{
+    return m->patlen == plen && memcmp(m->pattern, p, plen) == 0;
+}
+
+/* the leftmost occurrence of needle in hay, or NULL */
+static inline const char* LikeFindFragment(const char* hay, int haylen, const char* needle, int nlen)
+{
+    const char* last = hay + haylen - nlen;
+
+    while (hay <= last) {
+        hay = (const char*)memchr(hay, (unsigned char)needle[0], last - hay + 1);
+        if (hay == NULL) {
+            return NULL;
+        }
+        if (memcmp(hay + 1, needle + 1, nlen - 1) == 0) {
+            return hay;
+        }
+        hay++;
+    }
+    return NULL;
+}
+
+int LikeMatcherMatchText(const LikeMatcher* m, char* s, int slen)
+{
+    const char* pat = m->pattern;
+    const LikeFragment* f = NULL;
+    int first = 0;
+    int last = m->nfrags - 1;
+    int start = 0;
+    int end = slen;
+
+    if (!m->simple) {
+        return GenericMatchText(s, slen, m->pattern, m->patlen);
+    }
+
+    if (!m->has_wildcard) {
+        return (slen == m->patlen && memcmp(s, pat, slen) == 0) ? LIKE_TRUE : LIKE_FALSE;
+    }
+    if (slen < m->minlen) {
+        return LIKE_FALSE;
+    }
+
+    /* the minimum length check keeps the two anchors from overlapping */
+    if (m->anchored_start && m->nfrags > 0) {
+        f = &m->frags[first++];
+        if (memcmp(s, pat + f->off, f->len) != 0) {
+            return LIKE_FALSE;
+        }
+        start = f->len;
+    }
+    if (m->anchored_end && first <= last) {
+        f = &m->frags[last--];
+        if (memcmp(s + slen - f->len, pat + f->off, f->len) != 0) {
+            return LIKE_FALSE;
+        }
+        end = slen - f->len;
+    }
+
+    for (int i = first; i <= last; i++) {
+        const char* hit = NULL;
+
+        f = &m->frags[i];
+        hit = LikeFindFragment(s + start, end - start, pat + f->off, f->len);
+        if (hit == NULL) {
+            return LIKE_FALSE;
+        }
+        start = (int)(hit - s) + f->len;
+    }
+
+    return LIKE_TRUE;
+}
+
+/*
+ * The compiled form of pattern p for this call site, cached in fn_extra
+ * so that a constant pattern is only analysed once per query.
+ */
+LikeMatcher* GetCachedLikeMatcher(FunctionCallInfo fcinfo, const char* p, int plen)
+{
+    LikeMatcher* m = NULL;
+
+    if (fcinfo->flinfo == NULL) {
+        return CompileLikePattern(p, plen, CurrentMemoryContext);
+    }
+
+    m = (LikeMatcher*)fcinfo->flinfo->fn_extra;
+    if (m != NULL && LikeMatcherIsFor(m, p, plen)) {
+        return m;
+    }
+    if (m != NULL) {
+        pfree(m);
+    }
+    m = CompileLikePattern(p, plen, fcinfo->flinfo->fn_mcxt);
+    fcinfo->flinfo->fn_extra = m;
+    return m;
+}
+
+/*
+ * Match a possibly toasted text datum.  For a plain 'literal%' pattern only
+ * the first bytes of the string matter, so a toasted value is fetched and
+ * decompressed just that far instead of in full.
+ */
+static bool LikeMatcherMatchDatum(const LikeMatcher* m, Datum strdatum)
+{
+    text* str = NULL;
+    bool result = false;
+
+    if (m->simple && m->has_wildcard && m->anchored_start && !m->anchored_end && m->nfrags == 1 &&
+        VARATT_IS_EXTENDED(DatumGetPointer(strdatum))) {
+        str = DatumGetTextPSlice(strdatum, 0, m->frags[0].len);
+    } else {
+        str = DatumGetTextPP(strdatum);
+    }
+
+    result = (LikeMatcherMatchText(m, VARDATA_ANY(str), VARSIZE_ANY_EXHDR(str)) == LIKE_TRUE);
+
+    if ((Pointer)str != DatumGetPointer(strdatum)) {
+        pfree(str);
+    }
+    return result;
+}
+
 /* interface routines called by the function manager */
 Datum namelike(PG_FUNCTION_ARGS)
 {
@@ -252,38 +463,24 @@ Datum namenlike(PG_FUNCTION_ARGS)
 
 Datum textlike(PG_FUNCTION_ARGS)
 {
-    text* str = PG_GETARG_TEXT_PP(0);
     text* pat = PG_GETARG_TEXT_PP(1);
+    LikeMatcher* matcher = GetCachedLikeMatcher(fcinfo, VARDATA_ANY(pat), VARSIZE_ANY_EXHDR(pat));
     bool result = false;
-    char *s, *p;
-    int slen, plen;
 
-    s = VARDATA_ANY(str);
-    slen = VARSIZE_ANY_EXHDR(str);
-    p = VARDATA_ANY(pat);
-    plen = VARSIZE_ANY_EXHDR(pat);
-
-    result = (GenericMatchText(s, slen, p, plen) == LIKE_TRUE);
+    result = LikeMatcherMatchDatum(matcher, PG_GETARG_DATUM(0));
 
     PG_RETURN_BOOL(result);
 }
 
 Datum textnlike(PG_FUNCTION_ARGS)
 {
-    text* str = PG_GETARG_TEXT_PP(0);
     text* pat = PG_GETARG_TEXT_PP(1);
+    LikeMatcher* matcher = GetCachedLikeMatcher(fcinfo, VARDATA_ANY(pat), VARSIZE_ANY_EXHDR(pat));
     bool result = false;
-    char *s, *p;
-    int slen, plen;
-
-    s = VARDATA_ANY(str);
-    slen = VARSIZE_ANY_EXHDR(str);
-    p = VARDATA_ANY(pat);
-    plen = VARSIZE_ANY_EXHDR(pat);
 
-    result = (GenericMatchText(s, slen, p, plen) != LIKE_TRUE);
+    result = LikeMatcherMatchDatum(matcher, PG_GETARG_DATUM(0));
 
-    PG_RETURN_BOOL(result);
+    PG_RETURN_BOOL(!result);
 }
 
 Datum bytealike(PG_FUNCTION_ARGS)
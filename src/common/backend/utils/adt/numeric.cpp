@@ -27,6 +27,7 @@
 #include <math.h>
 
 #include "access/hash.h"
+#include "access/tupmacs.h"
 #include "catalog/pg_type.h"
 #include "funcapi.h"
 #include "common/int.h"
@@ -209,6 +210,7 @@ static void trunc_var(NumericVar* var, int rscale);
 static void strip_var(NumericVar* var);
 static void compute_bucket(
     Numeric operand, Numeric bound1, Numeric bound2, NumericVar* count_var, NumericVar* result_var);
+static inline int get_whole_scale(const NumericVar& numVar);
 
 /*
  * @Description: call corresponding big integer operator functions.
@@ -3190,6 +3192,177 @@ Datum numeric_float4(PG_FUNCTION_ARGS)
  * ----------------------------------------------------------------------
  */
 
+/*
+ * Fast path for sum and avg of numeric.
+ *
+ * While every input is a short numeric of at most 18 significant digits,
+ * the running sums are kept as bi128 numerics (see utils/biginteger.h).
+ * Those have a fixed size, so when called as an aggregate we can update the
+ * transition value in place: no palloc and no digit-array arithmetic per
+ * row.  An input that does not fit, or a sum that would overflow int128,
+ * simply falls back to the general code, which accepts bi128 operands.
+ */
+
+/* the value of num as a scaled int64, if it is small enough */
+static inline bool numeric_get_scaled_int64(Numeric num, int64* value, int* scale)
+{
+    NumericVar x;
+
+    if (!NUMERIC_IS_SHORT(num))
+        return false;
+
+    init_var_from_num(num, &x);
+    if (!CAN_CONVERT_BI64(get_whole_scale(x)))
+        return false;
+
+    *value = convert_short_numeric_to_int64_byscale(num, x.dscale);
+    *scale = x.dscale;
+    return true;
+}
+
+/* sum + value * 10^-scale into *result; false on overflow */
+static inline bool bi128_add_scaled(Numeric sum, int64 value, int scale, int128* result, int* resscale)
+{
+    int128 sumval;
+    int128 addend = value;
+    int sumscale = NUMERIC_BI_SCALE(sum);
+    errno_t rc;
+
+    rc = memcpy_s(&sumval, sizeof(int128), sum->choice.n_bi.n_data, sizeof(int128));
+    securec_check(rc, "\0", "\0");
+
+    if (scale > sumscale) {
+        if (__builtin_mul_overflow(sumval, getScaleMultiplier(scale - sumscale), &sumval))
+            return false;
+        sumscale = scale;
+    } else if (scale < sumscale) {
+        /* both scales are at most 18, so this cannot overflow int128 */
+        addend *= getScaleMultiplier(sumscale - scale);
+    }
+
+    if (__builtin_add_overflow(sumval, addend, result))
+        return false;
+    *resscale = sumscale;
+    return true;
+}
+
+static inline void bi128_store(Numeric num, int128 value, int scale)
+{
+    errno_t rc;
+
+    num->choice.n_header = NUMERIC_128 + scale;
+    rc = memcpy_s(num->choice.n_bi.n_data, sizeof(int128), &value, sizeof(int128));
+    securec_check(rc, "\0", "\0");
+}
+
+/* num as a bi128 numeric, or NULL if it does not fit in the fast path */
+static Numeric numeric_to_bi128(Numeric num)
+{
+    int64 value;
+    int scale;
+
+    if (NUMERIC_IS_BI128(num))
+        return num;
+    if (NUMERIC_IS_BI64(num))
+        return DatumGetNumeric(makeNumeric128(NUMERIC_64VALUE(num), NUMERIC_BI_SCALE(num)));
+    if (!numeric_get_scaled_int64(num, &value, &scale))
+        return NULL;
+    return DatumGetNumeric(makeNumeric128(value, scale));
+}
+
+/*
+ * Add value * 10^-scale to the sum(X) transition value of an aggregate,
+ * in place when possible.  Returns the new transition value, or NULL if
+ * the caller has to use the general code.
+ */
+static Numeric numeric_sum_accum_fast(Numeric state, int64 value, int scale)
+{
+    int128 result;
+    int resscale;
+
+    if (!u_sess->attr.attr_sql.enable_fast_numeric)
+        return NULL;
+
+    if (!NUMERIC_IS_BI128(state)) {
+        state = numeric_to_bi128(state);
+        if (state == NULL)
+            return NULL;
+    }
+
+    if (!bi128_add_scaled(state, value, scale, &result, &resscale))
+        return NULL;
+
+    bi128_store(state, result, resscale);
+    return state;
+}
+
+/*
+ * The avg transition array {N, sum(X)}, with both elements as bi128, for
+ * in-place updates; a new array is built the first time round.  NULL if
+ * the current values do not fit.
+ */
+static ArrayType* numeric_avg_state_to_bi128(ArrayType* transarray, Numeric* N, Numeric* sumX)
+{
+    Datum* transdatums = NULL;
+    int ndatums;
+    char* ptr = NULL;
+
+    if (ARR_NDIM(transarray) == 1 && !ARR_HASNULL(transarray) && ARR_DIMS(transarray)[0] == 2) {
+        ptr = ARR_DATA_PTR(transarray);
+        if (!VARATT_IS_SHORT(ptr) && NUMERIC_IS_BI128((Numeric)ptr)) {
+            *N = (Numeric)ptr;
+            ptr = (char*)att_align_nominal(ptr + VARSIZE(ptr), 'i');
+            *sumX = (Numeric)ptr;
+            if (!VARATT_IS_SHORT(ptr) && NUMERIC_IS_BI128(*sumX))
+                return transarray;
+        }
+    }
+
+    deconstruct_array(transarray, NUMERICOID, -1, false, 'i', &transdatums, NULL, &ndatums);
+    if (ndatums != 2)
+        ereport(ERROR, (errcode(ERRCODE_ARRAY_ELEMENT_ERROR), errmsg("expected 2-element numeric array")));
+
+    *N = numeric_to_bi128(DatumGetNumeric(transdatums[0]));
+    *sumX = numeric_to_bi128(DatumGetNumeric(transdatums[1]));
+    if (*N == NULL || *sumX == NULL)
+        return NULL;
+
+    transdatums[0] = NumericGetDatum(*N);
+    transdatums[1] = NumericGetDatum(*sumX);
+    transarray = construct_array(transdatums, 2, NUMERICOID, -1, false, 'i');
+
+    ptr = ARR_DATA_PTR(transarray);
+    *N = (Numeric)ptr;
+    *sumX = (Numeric)att_align_nominal(ptr + VARSIZE(ptr), 'i');
+    return transarray;
+}
+
+/* avg counterpart of numeric_sum_accum_fast */
+static ArrayType* numeric_avg_accum_fast(ArrayType* transarray, int64 value, int scale)
+{
+    Numeric N = NULL;
+    Numeric sumX = NULL;
+    int128 newN;
+    int128 newSum;
+    int Nscale;
+    int sumscale;
+
+    if (!u_sess->attr.attr_sql.enable_fast_numeric)
+        return NULL;
+
+    transarray = numeric_avg_state_to_bi128(transarray, &N, &sumX);
+    if (transarray == NULL)
+        return NULL;
+
+    /* check both before touching either */
+    if (!bi128_add_scaled(N, 1, 0, &newN, &Nscale) || !bi128_add_scaled(sumX, value, scale, &newSum, &sumscale))
+        return NULL;
+
+    bi128_store(N, newN, Nscale);
+    bi128_store(sumX, newSum, sumscale);
+    return transarray;
+}
+
 static ArrayType* do_numeric_accum(ArrayType* transarray, Numeric newval)
 {
     Datum* transdatums = NULL;
@@ -3247,6 +3420,40 @@ static ArrayType* do_numeric_avg_accum(ArrayType* transarray, Numeric newval)
     return result;
 }
 
+/*
+ * Transition function for sum(numeric).  This is numeric_add, except that
+ * when called as an aggregate the running sum is kept in the fast format;
+ * numeric_sum turns it back into a plain numeric at the end.
+ */
+Datum numeric_sum_accum(PG_FUNCTION_ARGS)
+{
+    Numeric state = PG_GETARG_NUMERIC(0);
+    Numeric newval = PG_GETARG_NUMERIC(1);
+    Numeric result = NULL;
+    int64 value;
+    int scale;
+
+    if (AggCheckCallContext(fcinfo, NULL) && numeric_get_scaled_int64(newval, &value, &scale)) {
+        result = numeric_sum_accum_fast(state, value, scale);
+        if (result != NULL)
+            PG_RETURN_NUMERIC(result);
+    }
+
+    return DirectFunctionCall2(numeric_add, NumericGetDatum(state), NumericGetDatum(newval));
+}
+
+/*
+ * Final function for sum(numeric).
+ */
+Datum numeric_sum(PG_FUNCTION_ARGS)
+{
+    Numeric state = PG_GETARG_NUMERIC(0);
+
+    if (NUMERIC_IS_BI(state))
+        PG_RETURN_NUMERIC(makeNumericNormal(state));
+    PG_RETURN_NUMERIC(state);
+}
+
 Datum numeric_accum(PG_FUNCTION_ARGS)
 {
     ArrayType* transarray = PG_GETARG_ARRAYTYPE_P(0);
@@ -3262,6 +3469,15 @@ Datum numeric_avg_accum(PG_FUNCTION_ARGS)
 {
     ArrayType* transarray = PG_GETARG_ARRAYTYPE_P(0);
     Numeric newval = PG_GETARG_NUMERIC(1);
+    ArrayType* result = NULL;
+    int64 value;
+    int scale;
+
+    if (AggCheckCallContext(fcinfo, NULL) && numeric_get_scaled_int64(newval, &value, &scale)) {
+        result = numeric_avg_accum_fast(transarray, value, scale);
+        if (result != NULL)
+            PG_RETURN_ARRAYTYPE_P(result);
+    }
 
     PG_RETURN_ARRAYTYPE_P(do_numeric_avg_accum(transarray, newval));
 }
@@ -3316,6 +3532,13 @@ Datum int8_avg_accum(PG_FUNCTION_ARGS)
     ArrayType* transarray = PG_GETARG_ARRAYTYPE_P(0);
     Datum newval8 = PG_GETARG_DATUM(1);
     Numeric newval;
+    ArrayType* result = NULL;
+
+    if (AggCheckCallContext(fcinfo, NULL)) {
+        result = numeric_avg_accum_fast(transarray, DatumGetInt64(newval8), 0);
+        if (result != NULL)
+            PG_RETURN_ARRAYTYPE_P(result);
+    }
 
     newval = DatumGetNumeric(DirectFunctionCall1(int8_numeric, newval8));
 
@@ -3336,6 +3559,12 @@ Datum numeric_avg(PG_FUNCTION_ARGS)
     N = DatumGetNumeric(transdatums[0]);
     sumX = DatumGetNumeric(transdatums[1]);
 
+    /* the fast accumulators leave bi128 values behind; divide as numeric */
+    if (NUMERIC_IS_BI(N))
+        N = makeNumericNormal(N);
+    if (NUMERIC_IS_BI(sumX))
+        sumX = makeNumericNormal(sumX);
+
     /* SQL92 defines AVG of no values to be NULL */
     /* N is zero iff no digits (cf. numeric_uminus) */
     if (NUMERIC_NDIGITS(N) == 0)
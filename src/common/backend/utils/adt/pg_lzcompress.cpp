@@ -40,6 +40,16 @@
  *					The data is written to buff exactly as it was handed
  *					to pglz_compress(). No terminating zero byte is added.
  *
+ *			int32
+ *			pglz_decompress_prefix(const PGLZ_Header *source, int32 srclen,
+ *								   char *dest, int32 destlen)
+ *
+ *				Like pglz_decompress(), but stops after destlen bytes of
+ *					output.  Only the first srclen bytes of source need to be
+ *					present, which lets callers decode the head of a large
+ *					value without fetching all of it; the amount that is
+ *					always sufficient is pglz_maximum_compressed_size().
+ *
  *		The decompression algorithm and internal data format:
  *
  *			PGLZ_Header is defined as
@@ -579,22 +589,19 @@ bool pglz_compress(const char* source, int32 slen, PGLZ_Header* dest, const PGLZ
 }
 
 /* ----------
- * pglz_decompress -
+ * pglz_decode -
  *
- *		Decompresses source into dest.
+ *		Decode the stream [sp, srcend) into [dp, destend) and return the
+ *		output position reached.  In prefix mode a match that runs past
+ *		destend is cut short there, since the caller only wants the
+ *		first bytes; otherwise that is left for the caller to report as
+ *		corruption.
  * ----------
  */
-void pglz_decompress(const PGLZ_Header* source, char* dest)
+static unsigned char* pglz_decode(
+    const unsigned char** spp, const unsigned char* srcend, unsigned char* dp, unsigned char* destend, bool prefix)
 {
-    const unsigned char* sp = NULL;
-    const unsigned char* srcend = NULL;
-    unsigned char* dp = NULL;
-    unsigned char* destend = NULL;
-
-    sp = ((const unsigned char*)source) + sizeof(PGLZ_Header);
-    srcend = ((const unsigned char*)source) + VARSIZE(source);
-    dp = (unsigned char*)dest;
-    destend = dp + source->rawsize;
+    const unsigned char* sp = *spp;
 
     while (sp < srcend && dp < destend) {
         /*
@@ -604,7 +611,7 @@ void pglz_decompress(const PGLZ_Header* source, char* dest)
         unsigned char ctrl = *sp++;
         int ctrlc;
 
-        for (ctrlc = 0; ctrlc < 8 && sp < srcend; ctrlc++) {
+        for (ctrlc = 0; ctrlc < 8 && sp < srcend && dp < destend; ctrlc++) {
             if (ctrl & 1) {
                 /*
                  * Otherwise it contains the match length minus 3 and the
@@ -616,10 +623,19 @@ void pglz_decompress(const PGLZ_Header* source, char* dest)
                 int32 len;
                 int32 off;
 
+                /* a fetched prefix may end in the middle of a tag */
+                if (prefix && sp + 1 >= srcend) {
+                    sp = srcend;
+                    break;
+                }
+
                 len = (sp[0] & 0x0f) + 3;
                 off = ((sp[0] & 0xf0) << 4) | sp[1];
                 sp += 2;
                 if (len == 18) {
+                    if (prefix && sp >= srcend) {
+                        break;
+                    }
                     len += *sp++;
                 }
 
@@ -631,8 +647,11 @@ void pglz_decompress(const PGLZ_Header* source, char* dest)
                  * probably interfere with optimization.
                  */
                 if (dp + len > destend) {
-                    dp += len;
-                    break;
+                    if (!prefix) {
+                        dp += len;
+                        break;
+                    }
+                    len = destend - dp;
                 }
 
                 /*
@@ -663,6 +682,29 @@ void pglz_decompress(const PGLZ_Header* source, char* dest)
         }
     }
 
+    *spp = sp;
+    return dp;
+}
+
+/* ----------
+ * pglz_decompress -
+ *
+ *		Decompresses source into dest.
+ * ----------
+ */
+void pglz_decompress(const PGLZ_Header* source, char* dest)
+{
+    const unsigned char* sp = NULL;
+    const unsigned char* srcend = NULL;
+    unsigned char* dp = NULL;
+    unsigned char* destend = NULL;
+
+    sp = ((const unsigned char*)source) + sizeof(PGLZ_Header);
+    srcend = ((const unsigned char*)source) + VARSIZE(source);
+    destend = (unsigned char*)dest + source->rawsize;
+
+    dp = pglz_decode(&sp, srcend, (unsigned char*)dest, destend, false);
+
     /*
      * Check we decompressed the right amount.
      */
@@ -670,3 +712,51 @@ void pglz_decompress(const PGLZ_Header* source, char* dest)
         ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("compressed data is corrupt")));
     }
 }
+
+/* ----------
+ * pglz_decompress_prefix -
+ *
+ *		Decompresses only the first destlen bytes of source into dest.
+ *		srclen is the number of bytes of source actually available, which
+ *		may be less than VARSIZE(source) when only a leading part of an
+ *		out-of-line value was fetched.  Returns the number of bytes
+ *		written, which is less than destlen only if the input ran out.
+ * ----------
+ */
+int32 pglz_decompress_prefix(const PGLZ_Header* source, int32 srclen, char* dest, int32 destlen)
+{
+    const unsigned char* sp = NULL;
+    const unsigned char* srcend = NULL;
+    unsigned char* dp = NULL;
+
+    if (destlen <= 0 || srclen <= (int32)sizeof(PGLZ_Header)) {
+        return 0;
+    }
+
+    sp = ((const unsigned char*)source) + sizeof(PGLZ_Header);
+    srcend = ((const unsigned char*)source) + Min((Size)srclen, VARSIZE(source));
+    destlen = Min(destlen, source->rawsize);
+
+    dp = pglz_decode(&sp, srcend, (unsigned char*)dest, (unsigned char*)dest + destlen, true);
+
+    return (int32)(dp - (unsigned char*)dest);
+}
+
+/* ----------
+ * pglz_maximum_compressed_size -
+ *
+ *		The number of compressed bytes (including the header) that is
+ *		certainly enough to decode the first rawsize bytes.  Each control
+ *		byte covers 8 items and every output byte costs at most one literal
+ *		byte plus its share of a control byte, so the worst case is 9 input
+ *		bytes per 8 output bytes.
+ * ----------
+ */
+int32 pglz_maximum_compressed_size(int32 rawsize, int32 total_compressed_size)
+{
+    int64 compressed_size;
+
+    compressed_size = ((int64)rawsize * 9 + 7) / 8 + sizeof(PGLZ_Header);
+
+    return (int32)Min(compressed_size, (int64)total_compressed_size);
+}
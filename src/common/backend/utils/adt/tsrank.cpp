@@ -18,6 +18,7 @@
 
 #include "tsearch/ts_utils.h"
 #include "utils/array.h"
+#include "utils/memutils.h"
 #include "miscadmin.h"
 
 static float weights[] = {0.1f, 0.2f, 0.4f, 1.0f};
@@ -33,8 +34,30 @@ static float weights[] = {0.1f, 0.2f, 0.4f, 1.0f};
 #define RANK_NORM_RDIVRPLUS1 0x20
 #define DEF_NORM_METHOD RANK_NO_NORM
 
-static float calc_rank_or(const float* w, TSVector t, TSQuery q);
-static float calc_rank_and(const float* w, TSVector t, TSQuery q);
+/*
+ * The parts of ranking that depend only on the query.  A ranking call is
+ * normally evaluated for every matching row with the same query, so these
+ * are computed once and kept in fn_extra instead of being redone per row.
+ *
+ * Note that every matching row is still ranked: ORDER BY ts_rank(...) LIMIT k
+ * scores all matches and keeps the best k in a bounded sort.  There is no
+ * early termination in the style of WAND or block-max WAND, since GIN
+ * posting lists hold bare item pointers without term frequencies, and the
+ * executor has no index scan that returns rows in approximate rank order.
+ * Either would need a new GIN on-disk format and a new ordered-scan
+ * interface, so only the per-row cost is reduced here.
+ */
+typedef struct {
+    MemoryContext cxt; /* holds this struct and everything it points to */
+    TSQuery query;     /* private copy; the pointers below point into it */
+    QueryOperand** items; /* sorted, de-duplicated operands */
+    int nitems;
+    QueryItem*** equal; /* for each operand item, all items with the same word */
+    int16* nequal;
+} TSRankQuery;
+
+static float calc_rank_or(const float* w, TSVector t, TSRankQuery* rq);
+static float calc_rank_and(const float* w, TSVector t, TSRankQuery* rq);
 
 /*
  * Returns a weight of a word collocation
@@ -170,8 +193,83 @@ static QueryOperand** sort_and_uniq_items(TSQuery q, int* size)
     return res;
 }
 
-static float calc_rank_and(const float* w, TSVector t, TSQuery q)
+static TSRankQuery* build_rank_query(TSQuery query, MemoryContext parent)
 {
+    MemoryContext cxt = AllocSetContextCreate(parent, "ts_rank query", ALLOCSET_SMALL_MINSIZE,
+        ALLOCSET_SMALL_INITSIZE, ALLOCSET_SMALL_MAXSIZE);
+    MemoryContext oldcxt = MemoryContextSwitchTo(cxt);
+    TSRankQuery* rq = (TSRankQuery*)palloc0(sizeof(TSRankQuery));
+    QueryItem* item = NULL;
+    char* operand = NULL;
+    int i;
+    int k;
+    errno_t rc;
+
+    rq->cxt = cxt;
+    rq->query = (TSQuery)palloc(VARSIZE(query));
+    rc = memcpy_s(rq->query, VARSIZE(query), query, VARSIZE(query));
+    securec_check(rc, "\0", "\0");
+
+    rq->nitems = rq->query->size;
+    rq->items = sort_and_uniq_items(rq->query, &rq->nitems);
+
+    item = GETQUERY(rq->query);
+    operand = GETOPERAND(rq->query);
+    rq->equal = (QueryItem***)palloc0(sizeof(QueryItem**) * (rq->query->size + 1));
+    rq->nequal = (int16*)palloc0(sizeof(int16) * (rq->query->size + 1));
+    for (i = 0; i < rq->query->size; i++) {
+        if (item[i].type != QI_VAL) {
+            continue;
+        }
+        rq->equal[i] = (QueryItem**)palloc(sizeof(QueryItem*) * rq->query->size);
+        for (k = 0; k < rq->query->size; k++) {
+            QueryOperand* kptr = &item[k].qoperand;
+            QueryOperand* iptr = &item[i].qoperand;
+
+            if (k == i || (item[k].type == QI_VAL && compare_query_operand(&kptr, &iptr, operand) == 0)) {
+                rq->equal[i][rq->nequal[i]++] = item + k;
+            }
+        }
+    }
+
+    (void)MemoryContextSwitchTo(oldcxt);
+    return rq;
+}
+
+/*
+ * Return the query-side ranking data for query, reusing the copy cached
+ * for this call site when the query has not changed.
+ */
+static TSRankQuery* get_rank_query(FunctionCallInfo fcinfo, TSQuery query)
+{
+    TSRankQuery* rq = NULL;
+
+    if (fcinfo->flinfo == NULL) {
+        return build_rank_query(query, CurrentMemoryContext);
+    }
+
+    rq = (TSRankQuery*)fcinfo->flinfo->fn_extra;
+    if (rq != NULL && VARSIZE(rq->query) == VARSIZE(query) && memcmp(rq->query, query, VARSIZE(query)) == 0) {
+        return rq;
+    }
+    if (rq != NULL) {
+        MemoryContextDelete(rq->cxt);
+    }
+    rq = build_rank_query(query, fcinfo->flinfo->fn_mcxt);
+    fcinfo->flinfo->fn_extra = rq;
+    return rq;
+}
+
+static void release_rank_query(FunctionCallInfo fcinfo, TSRankQuery* rq)
+{
+    if (fcinfo->flinfo == NULL) {
+        MemoryContextDelete(rq->cxt);
+    }
+}
+
+static float calc_rank_and(const float* w, TSVector t, TSRankQuery* rq)
+{
+    TSQuery q = rq->query;
     WordEntryPosVector** pos = NULL;
     int i, k, l, p;
     WordEntry* entry = NULL;
@@ -180,19 +278,18 @@ static float calc_rank_and(const float* w, TSVector t, TSQuery q)
     WordEntryPos* ct = NULL;
     int4 dimt, lenct, dist, nitem;
     float res = -1.0;
-    QueryOperand** item = NULL;
-    int size = q->size;
+    QueryOperand** item = rq->items;
+    int size = rq->nitems;
+    WordEntryPosVector* pos_null_ptr = NULL;
+
+    if (size < 2) {
+        return calc_rank_or(w, t, rq);
+    }
 
     /* A dummy WordEntryPos array to use when haspos is false */
-    WordEntryPosVector* pos_null_ptr = (WordEntryPosVector*)palloc(sizeof(WordEntryPosVector) + sizeof(WordEntryPos));
+    pos_null_ptr = (WordEntryPosVector*)palloc(sizeof(WordEntryPosVector) + sizeof(WordEntryPos));
     pos_null_ptr->npos = 1;
     pos_null_ptr->pos[0] = 0;
-
-    item = sort_and_uniq_items(q, &size);
-    if (size < 2) {
-        pfree_ext(item);
-        return calc_rank_or(w, t, q);
-    }
     pos = (WordEntryPosVector**)palloc0(sizeof(WordEntryPosVector*) * q->size);
     WEP_SETPOS(pos_null_ptr->pos[0], MAXENTRYPOS - 1);
 
@@ -236,27 +333,26 @@ static float calc_rank_and(const float* w, TSVector t, TSQuery q)
         }
     }
     pfree_ext(pos);
-    pfree_ext(item);
     pfree_ext(pos_null_ptr);
     return res;
 }
 
-static float calc_rank_or(const float* w, TSVector t, TSQuery q)
+static float calc_rank_or(const float* w, TSVector t, TSRankQuery* rq)
 {
+    TSQuery q = rq->query;
     WordEntry* entry = NULL;
     WordEntry* firstentry = NULL;
     WordEntryPos* post = NULL;
     int4 dimt, j, i, nitem;
     float res = 0.0;
-    QueryOperand** item;
-    int size = q->size;
+    QueryOperand** item = rq->items;
+    int size = rq->nitems;
 
     /* A dummy WordEntryPos array to use when haspos is false */
     WordEntryPosVector* pos_null_ptr = (WordEntryPosVector*)palloc(sizeof(WordEntryPosVector) + sizeof(WordEntryPos));
     pos_null_ptr->npos = 1;
     pos_null_ptr->pos[0] = 0;
 
-    item = sort_and_uniq_items(q, &size);
     for (i = 0; i < size; i++) {
         float resj, wjm;
         int4 jm;
@@ -300,12 +396,12 @@ static float calc_rank_or(const float* w, TSVector t, TSQuery q)
         res = res / size;
     }
     pfree_ext(pos_null_ptr);
-    pfree_ext(item);
     return res;
 }
 
-static float calc_rank(const float* w, TSVector t, TSQuery q, int4 method)
+static float calc_rank(const float* w, TSVector t, TSRankQuery* rq, int4 method)
 {
+    TSQuery q = rq->query;
     QueryItem* item = GETQUERY(q);
     float res = 0.0;
     int len;
@@ -315,7 +411,7 @@ static float calc_rank(const float* w, TSVector t, TSQuery q, int4 method)
     }
 
     /* XXX: What about NOT? */
-    res = (item->type == QI_OPR && item->qoperator.oper == OP_AND) ? calc_rank_and(w, t, q) : calc_rank_or(w, t, q);
+    res = (item->type == QI_OPR && item->qoperator.oper == OP_AND) ? calc_rank_and(w, t, rq) : calc_rank_or(w, t, rq);
     if (res < 0) {
         res = 1e-20f;
     }
@@ -387,8 +483,10 @@ Datum ts_rank_wttf(PG_FUNCTION_ARGS)
     TSVector txt = PG_GETARG_TSVECTOR(1);
     TSQuery query = PG_GETARG_TSQUERY(2);
     int method = PG_GETARG_INT32(3);
-    float res = calc_rank(get_weights(win), txt, query, method);
+    TSRankQuery* rq = get_rank_query(fcinfo, query);
+    float res = calc_rank(get_weights(win), txt, rq, method);
 
+    release_rank_query(fcinfo, rq);
     PG_FREE_IF_COPY(win, 0);
     PG_FREE_IF_COPY(txt, 1);
     PG_FREE_IF_COPY(query, 2);
@@ -401,8 +499,10 @@ Datum ts_rank_wtt(PG_FUNCTION_ARGS)
     ArrayType* win = (ArrayType*)PG_DETOAST_DATUM(PG_GETARG_DATUM(0));
     TSVector txt = PG_GETARG_TSVECTOR(1);
     TSQuery query = PG_GETARG_TSQUERY(2);
-    float res = calc_rank(get_weights(win), txt, query, DEF_NORM_METHOD);
+    TSRankQuery* rq = get_rank_query(fcinfo, query);
+    float res = calc_rank(get_weights(win), txt, rq, DEF_NORM_METHOD);
 
+    release_rank_query(fcinfo, rq);
     PG_FREE_IF_COPY(win, 0);
     PG_FREE_IF_COPY(txt, 1);
     PG_FREE_IF_COPY(query, 2);
@@ -415,8 +515,10 @@ Datum ts_rank_ttf(PG_FUNCTION_ARGS)
     TSVector txt = PG_GETARG_TSVECTOR(0);
     TSQuery query = PG_GETARG_TSQUERY(1);
     int method = PG_GETARG_INT32(2);
-    float res = calc_rank(get_weights(NULL), txt, query, method);
+    TSRankQuery* rq = get_rank_query(fcinfo, query);
+    float res = calc_rank(get_weights(NULL), txt, rq, method);
 
+    release_rank_query(fcinfo, rq);
     PG_FREE_IF_COPY(txt, 0);
     PG_FREE_IF_COPY(query, 1);
     PG_RETURN_FLOAT4(res);
@@ -427,8 +529,10 @@ Datum ts_rank_tt(PG_FUNCTION_ARGS)
     ts_check_feature_disable();
     TSVector txt = PG_GETARG_TSVECTOR(0);
     TSQuery query = PG_GETARG_TSQUERY(1);
-    float res = calc_rank(get_weights(NULL), txt, query, DEF_NORM_METHOD);
+    TSRankQuery* rq = get_rank_query(fcinfo, query);
+    float res = calc_rank(get_weights(NULL), txt, rq, DEF_NORM_METHOD);
 
+    release_rank_query(fcinfo, rq);
     PG_FREE_IF_COPY(txt, 0);
     PG_FREE_IF_COPY(query, 1);
     PG_RETURN_FLOAT4(res);
@@ -549,7 +653,7 @@ static bool cover(DocRepresentation* doc, int len, QueryRepresentation* qr, Exte
     return cover(doc, len, qr, ext);
 }
 
-static DocRepresentation* get_docrep(TSVector txt, QueryRepresentation* qr, int* doclen)
+static DocRepresentation* get_docrep(TSVector txt, TSRankQuery* rq, QueryRepresentation* qr, int* doclen)
 {
     QueryItem* item = GETQUERY(qr->query);
     WordEntry* entry = NULL;
@@ -559,7 +663,6 @@ static DocRepresentation* get_docrep(TSVector txt, QueryRepresentation* qr, int*
     int len = qr->query->size * 4;
     int cur = 0;
     DocRepresentation* doc = NULL;
-    char* operand = NULL;
 
     /* A dummy WordEntryPos array to use when haspos is false */
     WordEntryPosVector* pos_null_ptr = (WordEntryPosVector*)palloc(sizeof(WordEntryPosVector) + sizeof(WordEntryPos));
@@ -568,7 +671,6 @@ static DocRepresentation* get_docrep(TSVector txt, QueryRepresentation* qr, int*
     WordEntryPosVector POSNULL = *pos_null_ptr;
 
     doc = (DocRepresentation*)palloc(sizeof(DocRepresentation) * len);
-    operand = GETOPERAND(qr->query);
     for (i = 0; i < qr->query->size; i++) {
         QueryOperand* curoperand = NULL;
         if (item[i].type != QI_VAL) {
@@ -602,21 +704,11 @@ static DocRepresentation* get_docrep(TSVector txt, QueryRepresentation* qr, int*
             for (j = 0; j < dimt; j++) {
                 if (j == 0) {
                     int k;
-                    doc[cur].nitem = 0;
-                    doc[cur].item = (QueryItem**)palloc(sizeof(QueryItem*) * qr->query->size);
-                    for (k = 0; k < qr->query->size; k++) {
-                        QueryOperand* kptr = &item[k].qoperand;
-                        QueryOperand* iptr = &item[i].qoperand;
-
-                        if (k == i || (item[k].type == QI_VAL && compare_query_operand(&kptr, &iptr, operand) == 0)) {
-                            /*
-                             * if k == i, we've already checked above that
-                             * it's type == Q_VAL
-                             */
-                            doc[cur].item[doc[cur].nitem] = item + k;
-                            doc[cur].nitem++;
-                            QR_SET_OPERAND_EXISTS(qr, item + k);
-                        }
+                    /* the items sharing this operand's word were found once per query */
+                    doc[cur].nitem = rq->nequal[i];
+                    doc[cur].item = rq->equal[i];
+                    for (k = 0; k < doc[cur].nitem; k++) {
+                        QR_SET_OPERAND_EXISTS(qr, doc[cur].item[k]);
                     }
                 } else {
                     doc[cur].nitem = doc[cur - 1].nitem;
@@ -641,8 +733,9 @@ static DocRepresentation* get_docrep(TSVector txt, QueryRepresentation* qr, int*
     return NULL;
 }
 
-static float4 calc_rank_cd(float4* arrdata, TSVector txt, TSQuery query, int method)
+static float4 calc_rank_cd(float4* arrdata, TSVector txt, TSRankQuery* rq, int method)
 {
+    TSQuery query = rq->query;
     DocRepresentation* doc = NULL;
     int len;
     int i;
@@ -667,7 +760,7 @@ static float4 calc_rank_cd(float4* arrdata, TSVector txt, TSQuery query, int met
 
     qr.query = query;
     qr.operandexist = (bool*)palloc0(sizeof(bool) * query->size);
-    doc = get_docrep(txt, &qr, &doclen);
+    doc = get_docrep(txt, rq, &qr, &doclen);
     if (doc == NULL) {
         pfree_ext(qr.operandexist);
         return 0.0;
@@ -749,8 +842,11 @@ Datum ts_rankcd_wttf(PG_FUNCTION_ARGS)
     TSQuery query = PG_GETARG_TSQUERY(2);
     int method = PG_GETARG_INT32(3);
     float res;
+    TSRankQuery* rq = NULL;
 
-    res = calc_rank_cd(get_weights(win), txt, query, method);
+    rq = get_rank_query(fcinfo, query);
+    res = calc_rank_cd(get_weights(win), txt, rq, method);
+    release_rank_query(fcinfo, rq);
     PG_FREE_IF_COPY(win, 0);
     PG_FREE_IF_COPY(txt, 1);
     PG_FREE_IF_COPY(query, 2);
@@ -764,8 +860,11 @@ Datum ts_rankcd_wtt(PG_FUNCTION_ARGS)
     TSVector txt = PG_GETARG_TSVECTOR(1);
     TSQuery query = PG_GETARG_TSQUERY(2);
     float res;
+    TSRankQuery* rq = NULL;
 
-    res = calc_rank_cd(get_weights(win), txt, query, DEF_NORM_METHOD);
+    rq = get_rank_query(fcinfo, query);
+    res = calc_rank_cd(get_weights(win), txt, rq, DEF_NORM_METHOD);
+    release_rank_query(fcinfo, rq);
 
     PG_FREE_IF_COPY(win, 0);
     PG_FREE_IF_COPY(txt, 1);
@@ -780,8 +879,11 @@ Datum ts_rankcd_ttf(PG_FUNCTION_ARGS)
     TSQuery query = PG_GETARG_TSQUERY(1);
     int method = PG_GETARG_INT32(2);
     float res;
+    TSRankQuery* rq = NULL;
 
-    res = calc_rank_cd(get_weights(NULL), txt, query, method);
+    rq = get_rank_query(fcinfo, query);
+    res = calc_rank_cd(get_weights(NULL), txt, rq, method);
+    release_rank_query(fcinfo, rq);
     PG_FREE_IF_COPY(txt, 0);
     PG_FREE_IF_COPY(query, 1);
     PG_RETURN_FLOAT4(res);
@@ -793,8 +895,11 @@ Datum ts_rankcd_tt(PG_FUNCTION_ARGS)
     TSVector txt = PG_GETARG_TSVECTOR(0);
     TSQuery query = PG_GETARG_TSQUERY(1);
     float res;
+    TSRankQuery* rq = NULL;
 
-    res = calc_rank_cd(get_weights(NULL), txt, query, DEF_NORM_METHOD);
+    rq = get_rank_query(fcinfo, query);
+    res = calc_rank_cd(get_weights(NULL), txt, rq, DEF_NORM_METHOD);
+    release_rank_query(fcinfo, rq);
     PG_FREE_IF_COPY(txt, 0);
     PG_FREE_IF_COPY(query, 1);
     PG_RETURN_FLOAT4(res);
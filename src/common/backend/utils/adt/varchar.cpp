@@ -1207,11 +1207,14 @@ Datum nvarchar2typmodout(PG_FUNCTION_ARGS)
  * is the declared length of the type plus VARHDRSZ.
  * vectorize function
  */
-static FORCE_INLINE bool datumlike(Datum datum1, Datum datum2)
+static FORCE_INLINE bool datumlike(FunctionCallInfo fcinfo, Datum datum1, Datum datum2)
 {
     Size size1 = VARSIZE_ANY_EXHDR(datum1);
     Size size2 = VARSIZE_ANY_EXHDR(datum2);
-    return GenericMatchText(VARDATA_ANY(datum1), size1, VARDATA_ANY(datum2), size2) == LIKE_TRUE;
+    /* the pattern is nearly always a constant, so this is compiled once */
+    LikeMatcher* matcher = GetCachedLikeMatcher(fcinfo, VARDATA_ANY(datum2), size2);
+
+    return LikeMatcherMatchText(matcher, VARDATA_ANY(datum1), size1) == LIKE_TRUE;
 }
 
 ScalarVector* vtextlike(PG_FUNCTION_ARGS)
@@ -1240,7 +1243,7 @@ ScalarVector* vtextlike(PG_FUNCTION_ARGS)
                 } else {
                     arg1 = ScalarVector::Decode(parg1[i]);
                     arg2 = ScalarVector::Decode(parg2[i]);
-                    result = datumlike(arg1, arg2);
+                    result = datumlike(fcinfo, arg1, arg2);
                     presult[i] = result;
                     SET_NOTNULL(result_flag[i]);
                 }
@@ -1253,7 +1256,7 @@ ScalarVector* vtextlike(PG_FUNCTION_ARGS)
             } else {
                 arg1 = ScalarVector::Decode(parg1[i]);
                 arg2 = ScalarVector::Decode(parg2[i]);
-                result = datumlike(arg1, arg2);
+                result = datumlike(fcinfo, arg1, arg2);
                 presult[i] = result;
                 SET_NOTNULL(result_flag[i]);
             }
@@ -1291,7 +1294,7 @@ ScalarVector* vtextnlike(PG_FUNCTION_ARGS)
                 } else {
                     arg1 = ScalarVector::Decode(parg1[i]);
                     arg2 = ScalarVector::Decode(parg2[i]);
-                    result = !datumlike(arg1, arg2);
+                    result = !datumlike(fcinfo, arg1, arg2);
                     presult[i] = result;
                     SET_NOTNULL(result_flag[i]);
                 }
@@ -1304,7 +1307,7 @@ ScalarVector* vtextnlike(PG_FUNCTION_ARGS)
             } else {
                 arg1 = ScalarVector::Decode(parg1[i]);
                 arg2 = ScalarVector::Decode(parg2[i]);
-                result = !datumlike(arg1, arg2);
+                result = !datumlike(fcinfo, arg1, arg2);
                 presult[i] = result;
                 SET_NOTNULL(result_flag[i]);
             }
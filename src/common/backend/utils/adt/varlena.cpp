@@ -5754,14 +5754,28 @@ Datum text_concat_ws(PG_FUNCTION_ARGS)
  */
 Datum text_left(PG_FUNCTION_ARGS)
 {
-    text* str = PG_GETARG_TEXT_PP(0);
-    const char* p = VARDATA_ANY(str);
-    int len = VARSIZE_ANY_EXHDR(str);
     int n = PG_GETARG_INT32(1);
+    text* str = NULL;
+    const char* p = NULL;
+    int len;
     int part_off = 0;
     int rlen;
     text* part_str = NULL;
 
+    /*
+     * The first n characters are within the first n * max-encoding-length
+     * bytes, so only that much of a toasted value needs to be fetched.  A
+     * plain value is used in place; slicing it would only copy it.
+     */
+    if (n >= 0 && (int64)n * pg_database_encoding_max_length() < INT_MAX &&
+        VARATT_IS_EXTENDED(DatumGetPointer(PG_GETARG_DATUM(0)))) {
+        str = PG_GETARG_TEXT_P_SLICE(0, 0, n * pg_database_encoding_max_length());
+    } else {
+        str = PG_GETARG_TEXT_PP(0);
+    }
+    p = VARDATA_ANY(str);
+    len = VARSIZE_ANY_EXHDR(str);
+
     if (n < 0) {
         n = pg_mbstrlen_with_len(p, len) + n;
     }
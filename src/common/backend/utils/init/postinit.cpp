@@ -796,6 +796,14 @@ static void process_startup_options(Port* port, bool am_superuser)
         ConnAuthMethodCorrect = true;
     }
 
+    /*
+     * The client negotiated ColumnarData messages.  enable_columnar_result is
+     * GUC_REPORT, so the ParameterStatus sent at the end of startup is what
+     * tells the client that the server agreed.
+     */
+    if (port->columnar_result)
+        SetConfigOption("enable_columnar_result", "on", PGC_INTERNAL, PGC_S_OVERRIDE);
+
     /*
      * Process any additional GUC variable settings passed in startup packet.
      * These are handled exactly like command-line variables.
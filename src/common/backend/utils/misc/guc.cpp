@@ -34,6 +34,7 @@
 #include "pgxc/pgxc.h"
 #endif
 #include "access/transam.h"
+#include "access/tuptoaster.h"
 #include "access/twophase.h"
 #include "access/xact.h"
 #include "access/xlog.h"
@@ -273,6 +274,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "vacuum_freeze_table_age",
     "vacuum_freeze_min_age",
     "bytea_output",
+    "default_toast_compression",
     "xmlbinary",
     "xmloption",
     "DateStyle",
@@ -692,6 +694,9 @@ static bool is_opt_line_commented(char* opt_line)
 static const struct config_enum_entry bytea_output_options[] = {
     {"escape", BYTEA_OUTPUT_ESCAPE, false}, {"hex", BYTEA_OUTPUT_HEX, false}, {NULL, 0, false}};
 
+static const struct config_enum_entry toast_compression_options[] = {
+    {"pglz", TOAST_PGLZ_COMPRESSION_ID, false}, {"lz4", TOAST_LZ4_COMPRESSION_ID, false}, {NULL, 0, false}};
+
 /*
  * We have different sets for client and server message level options because
  * they sort slightly different (see "log" level)
@@ -1820,6 +1825,21 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_columnar_result",
+                PGC_INTERNAL,
+                CLIENT_CONN_OTHER,
+                gettext_noop("Shows whether binary query results of vectorized plans are sent in column-oriented messages."),
+                gettext_noop("Turned on only by the _pq_.columnar_result startup packet option."),
+                GUC_REPORT | GUC_NOT_IN_SAMPLE | GUC_DISALLOW_IN_FILE
+            },
+            &u_sess->attr.attr_sql.enable_columnar_result,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_force_vector_engine",
@@ -4305,6 +4325,62 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_copy_read_ahead",
+                PGC_USERSET,
+                UNGROUPED,
+                gettext_noop("Enables a read-ahead thread for COPY FROM a server file."),
+                NULL
+            },
+            &u_sess->attr.attr_storage.enable_copy_read_ahead,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "enable_copy_direct_load",
+                PGC_USERSET,
+                UNGROUPED,
+                gettext_noop("Enables COPY FROM to write pages directly into a table created in the same transaction."),
+                NULL
+            },
+            &u_sess->attr.attr_storage.enable_copy_direct_load,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "enable_io_uring",
+                PGC_USERSET,
+                UNGROUPED,
+                gettext_noop("Enables io_uring for asynchronous data file I/O."),
+                NULL
+            },
+            &u_sess->attr.attr_storage.enable_io_uring,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "enable_direct_io",
+                PGC_POSTMASTER,
+                UNGROUPED,
+                gettext_noop("Opens relation data files with O_DIRECT, bypassing the kernel page cache."),
+                NULL
+            },
+            &g_instance.attr.attr_storage.enable_direct_io,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_user_metric_persistent",
@@ -5211,6 +5287,38 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "clog_buffers",
+                PGC_POSTMASTER,
+                RESOURCES_MEM,
+                gettext_noop("Sets the number of shared buffers of each CLOG partition."),
+                gettext_noop("0 sizes the buffers from shared_buffers.")
+            },
+            &g_instance.attr.attr_storage.clog_buffers,
+            0,
+            0,
+            4096,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "csnlog_buffers",
+                PGC_POSTMASTER,
+                RESOURCES_MEM,
+                gettext_noop("Sets the number of shared buffers of each CSNLOG partition."),
+                gettext_noop("0 sizes the buffers from shared_buffers.")
+            },
+            &g_instance.attr.attr_storage.csnlog_buffers,
+            0,
+            0,
+            4096,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "max_loaded_cudesc",
@@ -6767,6 +6875,23 @@ static void init_configure_names_int()
             assign_effective_io_concurrency,
             NULL
         },
+        {
+            {
+                "direct_io_read_ahead",
+                PGC_USERSET,
+                RESOURCES_ASYNCHRONOUS,
+                gettext_noop("Number of pages a sequential scan reads ahead when enable_direct_io is on."),
+                gettext_noop("Zero disables read-ahead."),
+                GUC_UNIT_BLOCKS
+            },
+            &u_sess->attr.attr_storage.direct_io_read_ahead,
+            128,
+            0,
+            512,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "backend_flush_after",
@@ -11154,6 +11279,21 @@ static void init_configure_names_enum()
             NULL,
             NULL
         },
+        {
+            {
+                "default_toast_compression",
+                PGC_USERSET,
+                CLIENT_CONN_STATEMENT,
+                gettext_noop("Sets the default compression method for compressible values."),
+                gettext_noop("Columns with a toast_compression option use that method instead.")
+            },
+            &u_sess->attr.attr_storage.default_toast_compression,
+            TOAST_PGLZ_COMPRESSION_ID,
+            toast_compression_options,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "client_min_messages",
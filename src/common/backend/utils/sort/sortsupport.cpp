@@ -16,6 +16,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/nbtree.h"
 #include "fmgr.h"
 #include "utils/lsyscache.h"
 #include "utils/sortsupport.h"
@@ -140,3 +141,48 @@ void PrepareSortSupportFromOrderingOp(Oid orderingOp, SortSupport ssup)
         PrepareSortSupportComparisonShim(sortFunction, ssup);
     }
 }
+
+/*
+ * Fill in SortSupport given an index relation, attribute, and strategy.
+ *
+ * Caller must previously have zeroed the SortSupportData structure and then
+ * filled in ssup_cxt, ssup_attno, ssup_collation, ssup_nulls_first and
+ * abbreviate.  This will fill in ssup_reverse (based on the supplied
+ * strategy), as well as the comparator function pointer.
+ */
+void PrepareSortSupportFromIndexRel(Relation indexRel, int16 strategy, SortSupport ssup)
+{
+    Oid opfamily = indexRel->rd_opfamily[ssup->ssup_attno - 1];
+    Oid opcintype = indexRel->rd_opcintype[ssup->ssup_attno - 1];
+    Oid sortSupportFunction;
+
+    Assert(ssup->comparator == NULL);
+
+    if (strategy != BTGreaterStrategyNumber && strategy != BTLessStrategyNumber)
+        ereport(ERROR,
+            (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("unexpected sort support strategy: %d", strategy)));
+    ssup->ssup_reverse = (strategy == BTGreaterStrategyNumber);
+
+    /* Look for a sort support function */
+    sortSupportFunction = get_opfamily_proc(opfamily, opcintype, opcintype, BTSORTSUPPORT_PROC);
+    if (OidIsValid(sortSupportFunction)) {
+        /*
+         * The sort support function can provide a comparator, but it can also
+         * choose not to do so (e.g. based on the selected collation).
+         */
+        OidFunctionCall1(sortSupportFunction, PointerGetDatum(ssup));
+    }
+
+    if (ssup->comparator == NULL) {
+        Oid sortFunction = get_opfamily_proc(opfamily, opcintype, opcintype, BTORDER_PROC);
+
+        if (!OidIsValid(sortFunction))
+            ereport(ERROR,
+                (errcode(ERRCODE_UNDEFINED_FUNCTION),
+                    errmsg("missing support function %d(%u,%u) in opfamily %u",
+                        BTORDER_PROC, opcintype, opcintype, opfamily)));
+
+        /* We'll use a shim to call the old-style btree comparator */
+        PrepareSortSupportComparisonShim(sortFunction, ssup);
+    }
+}
@@ -867,6 +867,7 @@ Tuplesortstate* tuplesort_begin_index_btree(
 {
     Tuplesortstate* state = tuplesort_begin_common(workMem, randomAccess);
     MemoryContext oldcontext;
+    int i;
 
     oldcontext = MemoryContextSwitchTo(state->sortcontext);
 
@@ -898,6 +899,34 @@ Tuplesortstate* tuplesort_begin_index_btree(
     state->indexScanKey = _bt_mkscankey_nodata(indexRel);
     state->enforceUnique = enforceUnique;
     state->maxMem = maxMem * 1024L;
+    state->abbrevNext = 10;
+
+    /*
+     * Prepare SortSupport data for each column, so that collatable keys are
+     * compared by the opclass's fast comparator (and the leading key through
+     * its abbreviated form, e.g. a strxfrm() prefix) rather than by calling
+     * the btree comparison function through fmgr for every comparison.
+     */
+    state->sortKeys = (SortSupport)palloc0(state->nKeys * sizeof(SortSupportData));
+
+    for (i = 0; i < state->nKeys; i++) {
+        SortSupport sortKey = state->sortKeys + i;
+        ScanKey scanKey = state->indexScanKey + i;
+        int16 strategy;
+
+        sortKey->ssup_cxt = CurrentMemoryContext;
+        sortKey->ssup_collation = scanKey->sk_collation;
+        sortKey->ssup_nulls_first = (scanKey->sk_flags & SK_BT_NULLS_FIRST) != 0;
+        sortKey->ssup_attno = scanKey->sk_attno;
+        /* Convey if abbreviation optimization is applicable in principle */
+        sortKey->abbreviate = (i == 0);
+
+        AssertState(sortKey->ssup_attno != 0);
+
+        strategy = (scanKey->sk_flags & SK_BT_DESC) != 0 ? BTGreaterStrategyNumber : BTLessStrategyNumber;
+
+        PrepareSortSupportFromIndexRel(indexRel, strategy, sortKey);
+    }
 
     (void)MemoryContextSwitchTo(oldcontext);
 
@@ -3519,7 +3548,7 @@ static int comparetup_index_btree(const SortTuple* a, const SortTuple* b, Tuples
      * whether any null fields are present.  Also see the special treatment
      * for equal keys at the end.
      */
-    ScanKey scanKey = state->indexScanKey;
+    SortSupport sortKey = state->sortKeys;
     IndexTuple tuple1;
     IndexTuple tuple2;
     int keysz;
@@ -3527,34 +3556,43 @@ static int comparetup_index_btree(const SortTuple* a, const SortTuple* b, Tuples
     bool equal_hasnull = false;
     int nkey;
     int32 compare;
+    Datum datum1, datum2;
+    bool isnull1 = false, isnull2 = false;
 
     /* Compare the leading sort key */
-    compare = inlineApplySortFunction(
-        &scanKey->sk_func, scanKey->sk_flags, scanKey->sk_collation, a->datum1, a->isnull1, b->datum1, b->isnull1);
+    compare = ApplySortComparator(a->datum1, a->isnull1, b->datum1, b->isnull1, sortKey);
     if (compare != 0) {
         return compare;
     }
 
-    /* they are equal, so we only need to examine one null flag */
-    if (a->isnull1) {
-        equal_hasnull = true;
-    }
-
     /* Compare additional sort keys */
     tuple1 = (IndexTuple)a->tuple;
     tuple2 = (IndexTuple)b->tuple;
     keysz = state->nKeys;
     tupDes = RelationGetDescr(state->indexRel);
-    scanKey++;
-    for (nkey = 2; nkey <= keysz; nkey++, scanKey++) {
-        Datum datum1, datum2;
-        bool isnull1 = false, isnull2 = false;
 
+    if (sortKey->abbrev_converter) {
+        /* abbreviated keys were equal; settle it with the original values */
+        datum1 = index_getattr(tuple1, 1, tupDes, &isnull1);
+        datum2 = index_getattr(tuple2, 1, tupDes, &isnull2);
+
+        compare = ApplySortAbbrevFullComparator(datum1, isnull1, datum2, isnull2, sortKey);
+        if (compare != 0) {
+            return compare;
+        }
+    }
+
+    /* they are equal, so we only need to examine one null flag */
+    if (a->isnull1) {
+        equal_hasnull = true;
+    }
+
+    sortKey++;
+    for (nkey = 2; nkey <= keysz; nkey++, sortKey++) {
         datum1 = index_getattr(tuple1, nkey, tupDes, &isnull1);
         datum2 = index_getattr(tuple2, nkey, tupDes, &isnull2);
 
-        compare = inlineApplySortFunction(
-            &scanKey->sk_func, scanKey->sk_flags, scanKey->sk_collation, datum1, isnull1, datum2, isnull2);
+        compare = ApplySortComparator(datum1, isnull1, datum2, isnull2, sortKey);
         if (compare != 0) {
             return compare; /* done when we find unequal attributes */
         }
@@ -3673,6 +3711,7 @@ static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup)
     IndexTuple tuple = (IndexTuple)tup;
     unsigned int tuplen = IndexTupleSize(tuple);
     IndexTuple newtuple;
+    Datum original;
 
     /* copy the tuple into sort storage */
     newtuple = (IndexTuple)palloc(tuplen);
@@ -3682,7 +3721,41 @@ static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup)
     USEMEM(state, GetMemoryChunkSpace(newtuple));
     stup->tuple = (void*)newtuple;
     /* set up first-column key value */
-    stup->datum1 = index_getattr(newtuple, 1, RelationGetDescr(state->indexRel), &stup->isnull1);
+    original = index_getattr(newtuple, 1, RelationGetDescr(state->indexRel), &stup->isnull1);
+
+    if (state->sortKeys == NULL || !state->sortKeys->abbrev_converter || stup->isnull1) {
+        /*
+         * Store ordinary Datum representation, or NULL value.  If there is a
+         * converter it won't expect NULL values, and cost model is not
+         * required to account for NULL, so in that case we avoid calling
+         * converter and just set datum1 to "void" representation (to be
+         * consistent).
+         */
+        stup->datum1 = original;
+    } else if (!consider_abort_common(state)) {
+        /* Store abbreviated key representation */
+        stup->datum1 = state->sortKeys->abbrev_converter(original, state->sortKeys);
+    } else {
+        /* Abort abbreviation */
+        int i;
+
+        stup->datum1 = original;
+
+        /*
+         * Set state to be consistent with never trying abbreviation.
+         *
+         * Alter datum1 representation in already-copied tuples, so as to
+         * ensure a consistent representation (current tuple was just handled).
+         * Note that we rely on all tuples copied so far actually being
+         * contained within memtuples array.
+         */
+        for (i = 0; i < state->memtupcount; i++) {
+            SortTuple* mtup = &state->memtuples[i];
+
+            tuple = (IndexTuple)mtup->tuple;
+            mtup->datum1 = index_getattr(tuple, 1, RelationGetDescr(state->indexRel), &mtup->isnull1);
+        }
+    }
 }
 
 static void writetup_index(Tuplesortstate* state, int tapenum, SortTuple* stup)
@@ -3725,11 +3798,12 @@ static void readtup_index(Tuplesortstate* state, SortTuple* stup, int tapenum, u
 
 static void reversedirection_index_btree(Tuplesortstate* state)
 {
-    ScanKey scanKey = state->indexScanKey;
+    SortSupport sortKey = state->sortKeys;
     int nkey;
 
-    for (nkey = 0; nkey < state->nKeys; nkey++, scanKey++) {
-        scanKey->sk_flags ^= (SK_BT_DESC | SK_BT_NULLS_FIRST);
+    for (nkey = 0; nkey < state->nKeys; nkey++, sortKey++) {
+        sortKey->ssup_reverse = !sortKey->ssup_reverse;
+        sortKey->ssup_nulls_first = !sortKey->ssup_nulls_first;
     }
 }
 
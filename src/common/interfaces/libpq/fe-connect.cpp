@@ -218,6 +218,9 @@ static const PQconninfoOption PQconninfoOptions[] = {
     {"keepalives_interval", NULL, NULL, NULL, "TCP-Keepalives-Interval", "", 10, 0},
     {"keepalives_count", NULL, NULL, NULL, "TCP-Keepalives-Count", "", 10, 0},
     {"rw_timeout", NULL, NULL, NULL, "Read write timeout", "", 10, 0},
+
+    /* should be just '0' or '1' */
+    {"columnar_result", NULL, "0", NULL, "Columnar-Result", "", 1, 0},
 #ifdef USE_SSL
 
     /*
@@ -884,6 +887,8 @@ static void fillPGconn(PGconn* conn, PQconninfoOption* connOptions)
     conn->keepalives_count = (tmp != NULL) ? strdup(tmp) : NULL;
     tmp = conninfo_getval(connOptions, "rw_timeout");
     conn->rw_timeout = (tmp != NULL) ? strdup(tmp) : NULL;
+    tmp = conninfo_getval(connOptions, "columnar_result");
+    conn->columnar_result = (tmp != NULL) ? strdup(tmp) : NULL;
     tmp = conninfo_getval(connOptions, "sslmode");
     conn->sslmode = (tmp != NULL) ? strdup(tmp) : NULL;
     tmp = conninfo_getval(connOptions, "sslcompression");
@@ -3221,6 +3226,7 @@ void freePGconn(PGconn* conn)
     libpq_free(conn->keepalives_interval);
     libpq_free(conn->keepalives_count);
     libpq_free(conn->rw_timeout);
+    libpq_free(conn->columnar_result);
     libpq_free(conn->sslmode);
     libpq_free(conn->sslcert);
     libpq_free(conn->sslkey);
@@ -5771,6 +5777,18 @@ const char* PQparameterStatus(const PGconn* conn, const char* paramName)
     return NULL;
 }
 
+/*
+ * Whether the server agreed to send results as ColumnarData messages.  The
+ * client asks with the columnar_result connection option; a server that
+ * understands it reports enable_columnar_result = on at startup.
+ */
+int PQcolumnarResult(const PGconn* conn)
+{
+    const char* val = PQparameterStatus(conn, "enable_columnar_result");
+
+    return (val != NULL && strcmp(val, "on") == 0) ? 1 : 0;
+}
+
 int PQprotocolVersion(const PGconn* conn)
 {
     if (conn == NULL)
@@ -40,13 +40,15 @@
  * than a couple of kilobytes).
  */
 #define VALID_LONG_MESSAGE_TYPE(id) \
-    ((id) == 'T' || (id) == 'D' || (id) == 'd' || (id) == 'V' || (id) == 'E' || (id) == 'N' || (id) == 'A')
+    ((id) == 'T' || (id) == 'D' || (id) == 'Y' || (id) == 'd' || (id) == 'V' || (id) == 'E' || (id) == 'N' || \
+        (id) == 'A')
 
 THR_LOCAL uint32 *g_workingVersionNum = NULL;
 static void handleSyncLoss(PGconn* conn, char id, int msgLength);
 static int getRowDescriptions(PGconn* conn, int msgLength);
 static int getParamDescriptions(PGconn* conn);
 static int getAnotherTuple(PGconn* conn, int msgLength);
+static int getColumnarTuples(PGconn* conn, int msgLength);
 static int getParameterStatus(PGconn* conn);
 static int getNotify(PGconn* conn);
 static int getCopyStart(PGconn* conn, ExecStatusType copytype);
@@ -303,6 +305,23 @@ void pqParseInput3(PGconn* conn)
                         conn->inCursor += msgLength;
                     }
                     break;
+                case 'Y': /* Columnar Data */
+                    if (conn->result != NULL && conn->result->resultStatus == PGRES_TUPLES_OK) {
+                        if (getColumnarTuples(conn, msgLength))
+                            return;
+                        /* getColumnarTuples() moves inStart itself */
+                        continue;
+                    } else if (conn->result != NULL && conn->result->resultStatus == PGRES_FATAL_ERROR) {
+                        /* Already choked, discard tuples till we get to the end of the query */
+                        conn->inCursor += msgLength;
+                    } else {
+                        printfPQExpBuffer(&conn->errorMessage,
+                            libpq_gettext("server sent data (\"Y\" message) without prior row description "
+                                          "(\"T\" message)\n"));
+                        pqSaveErrorResult(conn);
+                        conn->inCursor += msgLength;
+                    }
+                    break;
                 case 'G': /* Start Copy In */
                     if (getCopyStart(conn, PGRES_COPY_IN))
                         return;
@@ -732,6 +751,145 @@ set_error_result:
     return 0;
 }
 
+/*
+ * parseInput subroutine to read a 'Y' (ColumnarData) message.
+ *
+ * The server sends these instead of 'D' messages when the connection asked for
+ * them with the columnar_result option (see PQcolumnarResult()) and all result
+ * columns are in binary format.  Each message carries a batch of rows column by column, see
+ * printtup.cpp in the backend for the layout.  We split it back into rows
+ * and hand them to the row processor, so the PGresult looks the same as if
+ * the rows had arrived as DataRow messages.
+ *
+ * Returns: 0 if processed message successfully, EOF to suspend parsing
+ * (the latter case is not actually used currently).
+ */
+static int getColumnarTuples(PGconn* conn, int msgLength)
+{
+    PGresult* result = conn->result;
+    int nfields = result->numAttributes;
+    const char* errmsg = NULL;
+    PGdataValue* cells = NULL;
+    PGdataValue* rowbuf = NULL;
+    int tupnfields;
+    int nrows;
+    int width;
+    int vlen;
+    int i;
+    int j;
+
+    if (conn->singleRowMode) {
+        errmsg = libpq_gettext("\"Y\" message is not supported in single-row mode");
+        goto advance_and_error;
+    }
+
+    if (pqGetInt(&tupnfields, 2, conn) || pqGetInt(&nrows, 4, conn)) {
+        errmsg = libpq_gettext("insufficient data in \"Y\" message");
+        goto advance_and_error;
+    }
+    if (tupnfields != nfields || nrows < 0) {
+        errmsg = libpq_gettext("unexpected field or row count in \"Y\" message");
+        goto advance_and_error;
+    }
+    if (nrows == 0 || nfields == 0)
+        goto done;
+
+    /* Resize row buffer if needed */
+    if (nfields > conn->rowBufLen) {
+        rowbuf = (PGdataValue*)malloc(nfields * sizeof(PGdataValue));
+        if (rowbuf == NULL) {
+            errmsg = NULL; /* means "out of memory", see below */
+            goto advance_and_error;
+        }
+        free(conn->rowBuf);
+        conn->rowBuf = rowbuf;
+        conn->rowBufLen = nfields;
+    }
+    rowbuf = conn->rowBuf;
+
+    /* cells[i * nrows + j] is column i of row j */
+    cells = (PGdataValue*)malloc((size_t)nfields * (size_t)nrows * sizeof(PGdataValue));
+    if (cells == NULL) {
+        errmsg = NULL;
+        goto advance_and_error;
+    }
+
+    for (i = 0; i < nfields; i++) {
+        const unsigned char* nullbits = NULL;
+
+        if (pqGetInt(&width, 4, conn)) {
+            errmsg = libpq_gettext("insufficient data in \"Y\" message");
+            goto advance_and_error;
+        }
+        nullbits = (const unsigned char*)conn->inBuffer + conn->inCursor;
+        if (pqSkipnchar((size_t)(nrows + 7) / 8, conn)) {
+            errmsg = libpq_gettext("insufficient data in \"Y\" message");
+            goto advance_and_error;
+        }
+
+        for (j = 0; j < nrows; j++) {
+            PGdataValue* cell = &cells[i * nrows + j];
+
+            if (nullbits[j / 8] & (1 << (j % 8))) {
+                cell->len = -1;
+                cell->value = conn->inBuffer + conn->inCursor;
+                continue;
+            }
+            if (width >= 0) {
+                vlen = width;
+            } else if (pqGetInt(&vlen, 4, conn)) {
+                errmsg = libpq_gettext("insufficient data in \"Y\" message");
+                goto advance_and_error;
+            }
+            cell->len = vlen;
+            cell->value = conn->inBuffer + conn->inCursor;
+            if (vlen > 0 && pqSkipnchar(vlen, conn)) {
+                errmsg = libpq_gettext("insufficient data in \"Y\" message");
+                goto advance_and_error;
+            }
+        }
+    }
+
+done:
+    /* Sanity check that we absorbed all the data */
+    if (conn->inCursor != conn->inStart + 5 + msgLength) {
+        errmsg = libpq_gettext("extraneous data in \"Y\" message");
+        goto advance_and_error;
+    }
+
+    /* Advance inStart to show that the "Y" message has been processed. */
+    conn->inStart = conn->inCursor;
+
+    /* The cells still point into inBuffer, which is not touched until we return */
+    for (j = 0; j < nrows; j++) {
+        for (i = 0; i < nfields; i++)
+            rowbuf[i] = cells[i * nrows + j];
+
+        errmsg = NULL;
+        if (!pqRowProcessor(conn, &errmsg))
+            goto set_error_result;
+    }
+
+    free(cells);
+    return 0;
+
+advance_and_error:
+    /* Discard the failed message by pretending we read it */
+    conn->inStart += 5 + msgLength;
+
+set_error_result:
+    free(cells);
+
+    /* Same as in getAnotherTuple() */
+    pqClearAsyncResult(conn);
+    if (errmsg == NULL)
+        errmsg = libpq_gettext("out of memory for query result");
+    printfPQExpBuffer(&conn->errorMessage, "%s\n", errmsg);
+    pqSaveErrorResult(conn);
+
+    return 0;
+}
+
 /*
  * Attempt to read an Error or Notice response message.
  * This is possible in several places, so we break it out as a subroutine.
@@ -1866,6 +2024,15 @@ static bool add_options_to_package(const PGconn* conn, char* packet, int *packet
         return false;
     }
 
+    /*
+     * Only sent when asked for: a server that does not know the option
+     * refuses the connection, like for any unknown startup parameter.
+     */
+    if (conn->columnar_result != NULL && conn->columnar_result[0] == '1' &&
+        !ADD_STARTUP_OPTION("_pq_.columnar_result", "1", packet, packet_len)) {
+        return false;
+    }
+
     if (g_workingVersionNum && *g_workingVersionNum >= 92060) {
         return ADD_STARTUP_OPTION("connect_timeout", conn->connect_timeout, packet, packet_len);
     }
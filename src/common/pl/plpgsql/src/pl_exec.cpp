@@ -136,6 +136,9 @@ static void exec_simple_check_plan(PLpgSQL_expr* expr);
 static void exec_simple_recheck_plan(PLpgSQL_expr* expr, CachedPlan* cplan);
 static bool exec_eval_simple_expr(
     PLpgSQL_execstate* estate, PLpgSQL_expr* expr, Datum* result, bool* isNull, Oid* rettype);
+static void exec_simple_build_fast_expr(PLpgSQL_expr* expr, CachedPlanSource* plansource);
+static bool exec_eval_fast_expr(
+    PLpgSQL_execstate* estate, PLpgSQL_expr* expr, Datum* result, bool* isNull, Oid* rettype);
 
 static void exec_assign_expr(PLpgSQL_execstate* estate, PLpgSQL_datum* target, PLpgSQL_expr* expr);
 static void exec_assign_c_string(PLpgSQL_execstate* estate, PLpgSQL_datum* target, const char* str);
@@ -5795,6 +5798,14 @@ static Datum exec_eval_expr(PLpgSQL_execstate* estate, PLpgSQL_expr* expr, bool*
         exec_prepare_plan(estate, expr, 0);
     }
 
+    /*
+     * If this is a trivial expression, evaluate it without even touching the
+     * plan cache or the executor
+     */
+    if (exec_eval_fast_expr(estate, expr, &result, isNull, rettype)) {
+        return result;
+    }
+
     /*
      * If this is a simple expression, bypass SPI and use the executor
      * directly
@@ -6252,6 +6263,101 @@ static bool exec_eval_simple_expr(
     return true;
 }
 
+/* ----------
+ * exec_eval_fast_expr -		Evaluate a trivial expression directly
+ *
+ * If the expression has a fast form (see exec_simple_build_fast_expr) that
+ * is still current, compute its value by fetching the variables and calling
+ * the function ourselves, and return TRUE.  Otherwise return FALSE and let
+ * the caller take the simple-expression or SPI path, which revalidates the
+ * plan and rebuilds the fast form if the expression is still trivial.
+ *
+ * The fast form only involves immutable built-in functions and no tables,
+ * so the generic plan can only go stale through an explicit invalidation or
+ * a search_path change, both of which we can test cheaply here.
+ *
+ * Note: if pass-by-reference, the result is in the eval_econtext's
+ * temporary memory context.  It will be freed when exec_eval_cleanup
+ * is done.
+ * ----------
+ */
+static bool exec_eval_fast_expr(
+    PLpgSQL_execstate* estate, PLpgSQL_expr* expr, Datum* result, bool* isNull, Oid* rettype)
+{
+    PLpgSQL_fast_expr* fast = expr->expr_fast;
+    CachedPlanSource* plansource = NULL;
+    Datum values[PLPGSQL_FAST_EXPR_MAX_ARGS];
+    bool nulls[PLPGSQL_FAST_EXPR_MAX_ARGS];
+    int nargs;
+    int i;
+
+    if (fast == NULL || !fast->valid || expr->expr_simple_expr == NULL) {
+        return false;
+    }
+
+    plansource = fast->plansource;
+    if (!plansource->is_valid || plansource->gplan == NULL || !plansource->gplan->is_valid ||
+        plansource->gplan->generation != expr->expr_simple_generation ||
+        (plansource->dependsOnRole && plansource->rewriteRoleId != GetUserId()) ||
+        !OverrideSearchPathMatchesCurrent(plansource->search_path)) {
+        return false;
+    }
+
+    nargs = Max(fast->nargs, 1);
+    for (i = 0; i < nargs; i++) {
+        PLpgSQL_fast_arg* arg = &fast->args[i];
+
+        if (arg->dno >= 0) {
+            PLpgSQL_var* var = (PLpgSQL_var*)estate->datums[arg->dno];
+
+            /* the variable must still be what the plan was made for */
+            if (var->dtype != PLPGSQL_DTYPE_VAR || var->datatype->typoid != arg->paramtype) {
+                return false;
+            }
+            values[i] = var->value;
+            nulls[i] = var->isnull;
+        } else {
+            values[i] = arg->constvalue;
+            nulls[i] = arg->constisnull;
+        }
+    }
+
+    *rettype = expr->expr_simple_type;
+
+    if (fast->nargs == 0) {
+        *result = values[0];
+        *isNull = nulls[0];
+        return true;
+    }
+
+    /* the function is strict */
+    for (i = 0; i < nargs; i++) {
+        if (nulls[i]) {
+            *result = (Datum)0;
+            *isNull = true;
+            return true;
+        }
+    }
+
+    {
+        FunctionCallInfoData fcinfo;
+        MemoryContext oldcontext;
+
+        InitFunctionCallInfoData(fcinfo, &fast->flinfo, nargs, fast->inputcollid, NULL, NULL);
+        for (i = 0; i < nargs; i++) {
+            fcinfo.arg[i] = values[i];
+            fcinfo.argnull[i] = false;
+        }
+
+        oldcontext = MemoryContextSwitchTo(estate->eval_econtext->ecxt_per_tuple_memory);
+        *result = FunctionCallInvoke(&fcinfo);
+        MemoryContextSwitchTo(oldcontext);
+        *isNull = fcinfo.isnull;
+    }
+
+    return true;
+}
+
 /*
  * Create a ParamListInfo to pass to SPI
  *
@@ -7156,6 +7262,9 @@ static void exec_simple_check_plan(PLpgSQL_expr* expr)
     expr->expr_simple_expr = NULL;
     expr->expr_simple_generation = 0;
     expr->expr_simple_need_snapshot = true;
+    if (expr->expr_fast != NULL) {
+        expr->expr_fast->valid = false;
+    }
 
     /*
      * We can only test queries that resulted in exactly one CachedPlanSource
@@ -7240,6 +7349,9 @@ static void exec_simple_recheck_plan(PLpgSQL_expr* expr, CachedPlan* cplan)
     expr->expr_simple_expr = NULL;
     expr->expr_simple_generation = cplan->generation;
     expr->expr_simple_need_snapshot = true;
+    if (expr->expr_fast != NULL) {
+        expr->expr_fast->valid = false;
+    }
 
     /*
      * 1. There must be one single plantree
@@ -7294,6 +7406,166 @@ static void exec_simple_recheck_plan(PLpgSQL_expr* expr, CachedPlan* cplan)
     /* Also stash away the expression result type */
     expr->expr_simple_type = exprType((Node*)tle->expr);
     expr->expr_simple_need_snapshot = exec_simple_check_mutable_function((Node*)tle->expr);
+
+    /* See if it is even trivial enough for exec_eval_fast_expr */
+    if (!expr->expr_simple_need_snapshot) {
+        List* plansources = SPI_plan_get_plan_sources(expr->plan);
+
+        exec_simple_build_fast_expr(expr, (CachedPlanSource*)linitial(plansources));
+    }
+}
+
+/*
+ * exec_simple_fast_arg --- set up one argument of a fast expression
+ *
+ * The argument must be a plain PL/pgSQL variable or a constant, possibly
+ * under a binary-compatible relabeling.  Constants are copied into the
+ * function's context, since the plan they came from may go away.
+ */
+static bool exec_simple_fast_arg(PLpgSQL_expr* expr, Node* node, PLpgSQL_fast_arg* arg)
+{
+    while (node != NULL && IsA(node, RelabelType)) {
+        node = (Node*)((RelabelType*)node)->arg;
+    }
+    if (node == NULL) {
+        return false;
+    }
+
+    if (IsA(node, Param)) {
+        Param* param = (Param*)node;
+        int dno = param->paramid - 1;
+
+        if (param->paramkind != PARAM_EXTERN || param->paramtype == REFCURSOROID ||
+            !bms_is_member(dno, expr->paramnos) || expr->func->datums[dno]->dtype != PLPGSQL_DTYPE_VAR) {
+            return false;
+        }
+        arg->dno = dno;
+        arg->paramtype = param->paramtype;
+        return true;
+    }
+
+    if (IsA(node, Const)) {
+        Const* con = (Const*)node;
+
+        if (con->consttype == REFCURSOROID) {
+            return false;
+        }
+        arg->dno = -1;
+        arg->constisnull = con->constisnull;
+        arg->constbyval = con->constbyval;
+        if (con->constisnull || con->constbyval) {
+            arg->constvalue = con->constvalue;
+        } else {
+            MemoryContext oldcontext = MemoryContextSwitchTo(expr->func->fn_cxt);
+
+            arg->constvalue = datumCopy(con->constvalue, false, con->constlen);
+            MemoryContextSwitchTo(oldcontext);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * exec_simple_build_fast_expr --- build the direct evaluator for expr
+ *
+ * Called whenever exec_simple_recheck_plan has found a simple expression
+ * that needs no snapshot.  The result is marked valid only if the whole
+ * expression is a variable, a constant, or a strict immutable built-in
+ * function with non-polymorphic arguments applied to those.
+ */
+static void exec_simple_build_fast_expr(PLpgSQL_expr* expr, CachedPlanSource* plansource)
+{
+    PLpgSQL_fast_expr* fast = expr->expr_fast;
+    Node* node = (Node*)expr->expr_simple_expr;
+    Oid funcid = InvalidOid;
+    Oid inputcollid = InvalidOid;
+    List* args = NIL;
+    Oid* argtypes = NULL;
+    int nargs = 0;
+    int i;
+    errno_t rc;
+
+    if (expr->func == NULL || expr->expr_simple_type == REFCURSOROID) {
+        return;
+    }
+
+    if (fast == NULL) {
+        fast = (PLpgSQL_fast_expr*)MemoryContextAllocZero(expr->func->fn_cxt, sizeof(PLpgSQL_fast_expr));
+        expr->expr_fast = fast;
+    } else {
+        /* forget what the previous plan's fast form had copied */
+        for (i = 0; i < PLPGSQL_FAST_EXPR_MAX_ARGS; i++) {
+            PLpgSQL_fast_arg* arg = &fast->args[i];
+
+            if (arg->dno < 0 && !arg->constisnull && !arg->constbyval) {
+                pfree(DatumGetPointer(arg->constvalue));
+            }
+        }
+        rc = memset_s(fast, sizeof(PLpgSQL_fast_expr), 0, sizeof(PLpgSQL_fast_expr));
+        securec_check(rc, "\0", "\0");
+    }
+    for (i = 0; i < PLPGSQL_FAST_EXPR_MAX_ARGS; i++) {
+        fast->args[i].dno = -1;
+        fast->args[i].constisnull = true;
+    }
+
+    if (IsA(node, OpExpr)) {
+        OpExpr* op = (OpExpr*)node;
+
+        set_opfuncid(op);
+        funcid = op->opfuncid;
+        inputcollid = op->inputcollid;
+        args = op->args;
+    } else if (IsA(node, FuncExpr)) {
+        FuncExpr* func = (FuncExpr*)node;
+
+        if (func->funcretset) {
+            return;
+        }
+        funcid = func->funcid;
+        inputcollid = func->inputcollid;
+        args = func->args;
+    } else {
+        /* a lone variable or constant */
+        if (exec_simple_fast_arg(expr, node, &fast->args[0])) {
+            fast->plansource = plansource;
+            fast->valid = true;
+        }
+        return;
+    }
+
+    if (list_length(args) < 1 || list_length(args) > PLPGSQL_FAST_EXPR_MAX_ARGS) {
+        return;
+    }
+    if (funcid >= FirstNormalObjectId || !func_strict(funcid) || func_volatile(funcid) != PROVOLATILE_IMMUTABLE) {
+        return;
+    }
+
+    /* polymorphic functions would want fn_expr, which we don't provide */
+    if (IsPolymorphicType(get_func_signature(funcid, &argtypes, &nargs)) || nargs != list_length(args)) {
+        return;
+    }
+    for (i = 0; i < nargs; i++) {
+        if (get_typtype(argtypes[i]) == TYPTYPE_PSEUDO) {
+            pfree_ext(argtypes);
+            return;
+        }
+    }
+    pfree_ext(argtypes);
+
+    for (i = 0; i < nargs; i++) {
+        if (!exec_simple_fast_arg(expr, (Node*)list_nth(args, i), &fast->args[i])) {
+            return;
+        }
+    }
+
+    fmgr_info_cxt(funcid, &fast->flinfo, expr->func->fn_cxt);
+    fast->nargs = nargs;
+    fast->inputcollid = inputcollid;
+    fast->plansource = plansource;
+    fast->valid = true;
 }
 
 /* ----------
@@ -583,6 +583,9 @@ void free_expr(PLpgSQL_expr* expr)
     if (expr != NULL && expr->plan != NULL) {
         SPI_freeplan(expr->plan);
         expr->plan = NULL;
+        if (expr->expr_fast != NULL) {
+            expr->expr_fast->valid = false;
+        }
     }
 }
 
@@ -19,6 +19,142 @@
 
 #include <nmmintrin.h>
 
+#ifdef __x86_64__
+/*
+ * The crc32 instruction has a latency of three cycles but a throughput of one
+ * per cycle, so a single dependency chain leaves two thirds of the unit idle.
+ * Large buffers are therefore processed as three independent streams over
+ * consecutive blocks, and the partial CRCs are then combined by "shifting"
+ * each one over the length of the block that follows it, i.e. by computing
+ * the CRC register after feeding it that many zero bytes.  That is a linear
+ * operation over GF(2), done with a 32x32 bit matrix which is in turn folded
+ * into four 256-entry lookup tables per block size.
+ */
+#define CRC32C_POLY 0x82f63b78 /* reflected Castagnoli polynomial */
+#define CRC32C_LONG_BLOCK 8192
+#define CRC32C_SHORT_BLOCK 256
+
+typedef struct Crc32cShiftTables {
+    uint32 longShift[4][256];
+    uint32 shortShift[4][256];
+
+    Crc32cShiftTables();
+} Crc32cShiftTables;
+
+/* multiply the 32x32 GF(2) matrix mat by the vector vec */
+static uint32 gf2_matrix_times(const uint32* mat, uint32 vec)
+{
+    uint32 sum = 0;
+
+    while (vec != 0) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+static void gf2_matrix_square(uint32* square, const uint32* mat)
+{
+    for (int n = 0; n < 32; n++) {
+        square[n] = gf2_matrix_times(mat, mat[n]);
+    }
+}
+
+/* build the operator that feeds len zero bytes (len a power of two) through the CRC */
+static void crc32c_zeros_op(uint32* even, size_t len)
+{
+    uint32 odd[32];
+    uint32 row = 1;
+
+    /* operator for one zero bit */
+    odd[0] = CRC32C_POLY;
+    for (int n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    /* two, then four zero bits */
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+
+    /* each further squaring doubles the count, starting from one zero byte */
+    for (;;) {
+        gf2_matrix_square(even, odd);
+        len >>= 1;
+        if (len == 0) {
+            return;
+        }
+        gf2_matrix_square(odd, even);
+        len >>= 1;
+        if (len == 0) {
+            break;
+        }
+    }
+
+    for (int n = 0; n < 32; n++) {
+        even[n] = odd[n];
+    }
+}
+
+static void crc32c_zeros(uint32 zeros[][256], size_t len)
+{
+    uint32 op[32];
+
+    crc32c_zeros_op(op, len);
+    for (uint32 n = 0; n < 256; n++) {
+        zeros[0][n] = gf2_matrix_times(op, n);
+        zeros[1][n] = gf2_matrix_times(op, n << 8);
+        zeros[2][n] = gf2_matrix_times(op, n << 16);
+        zeros[3][n] = gf2_matrix_times(op, n << 24);
+    }
+}
+
+Crc32cShiftTables::Crc32cShiftTables()
+{
+    crc32c_zeros(longShift, CRC32C_LONG_BLOCK);
+    crc32c_zeros(shortShift, CRC32C_SHORT_BLOCK);
+}
+
+static inline uint32 crc32c_shift(const uint32 zeros[][256], uint32 crc)
+{
+    return zeros[0][crc & 0xff] ^ zeros[1][(crc >> 8) & 0xff] ^ zeros[2][(crc >> 16) & 0xff] ^ zeros[3][crc >> 24];
+}
+
+/*
+ * Run three interleaved streams over as many groups of three blocks of the
+ * given size as fit in the buffer, and return the CRC of all of them.
+ */
+static inline uint32 crc32c_sse42_interleaved(
+    uint32 crc, const unsigned char** pp, const unsigned char* pend, size_t block, const uint32 shift[][256])
+{
+    const unsigned char* p = *pp;
+
+    while ((size_t)(pend - p) >= block * 3) {
+        const unsigned char* end = p + block;
+        uint64 crc0 = crc;
+        uint64 crc1 = 0;
+        uint64 crc2 = 0;
+
+        do {
+            crc0 = _mm_crc32_u64(crc0, *((const uint64*)p));
+            crc1 = _mm_crc32_u64(crc1, *((const uint64*)(p + block)));
+            crc2 = _mm_crc32_u64(crc2, *((const uint64*)(p + block * 2)));
+            p += 8;
+        } while (p < end);
+
+        crc = crc32c_shift(shift, (uint32)crc0) ^ (uint32)crc1;
+        crc = crc32c_shift(shift, crc) ^ (uint32)crc2;
+        p += block * 2;
+    }
+
+    *pp = p;
+    return crc;
+}
+#endif /* __x86_64__ */
+
 pg_crc32c pg_comp_crc32c_sse42(pg_crc32c crc, const void* data, size_t len)
 {
     const unsigned char* p = (const unsigned char*)data;
@@ -32,6 +168,14 @@ pg_crc32c pg_comp_crc32c_sse42(pg_crc32c crc, const void* data, size_t len)
      * the begin address.
      */
 #ifdef __x86_64__
+    if (len >= CRC32C_SHORT_BLOCK * 3) {
+        /* built once, on first use; C++ makes that thread-safe */
+        static const Crc32cShiftTables tables;
+
+        crc = crc32c_sse42_interleaved(crc, &p, pend, CRC32C_LONG_BLOCK, tables.longShift);
+        crc = crc32c_sse42_interleaved(crc, &p, pend, CRC32C_SHORT_BLOCK, tables.shortShift);
+    }
+
     while (p + 8 <= pend) {
         crc = (uint32)_mm_crc32_u64(crc, *((const uint64*)p));
         p += 8;
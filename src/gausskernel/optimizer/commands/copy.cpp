@@ -26,7 +26,9 @@
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "bulkload/dist_fdw.h"
+#include "bulkload/simd_scan.h"
 #include "catalog/heap.h"
+#include "catalog/index.h"
 #include "catalog/pgxc_class.h"
 #include "bulkload/dist_fdw.h"
 #include "catalog/namespace.h"
@@ -35,6 +37,7 @@
 #include "catalog/pg_trigger.h"
 #endif
 #include "commands/copy.h"
+#include "commands/copy_reader.h"
 #include "commands/defrem.h"
 #include "commands/trigger.h"
 #include "executor/executor.h"
@@ -217,6 +220,7 @@ static uint64 CopyTo(CopyState cstate, bool isFirst, bool isLast);
 static uint64 CopyToCompatiblePartions(CopyState cstate);
 static void CopyOneRowTo(CopyState cstate, Oid tupleOid, Datum* values, const bool* nulls);
 static uint64 CopyFrom(CopyState cstate);
+static bool CopyFromCanDirectLoad(CopyState cstate, ResultRelInfo* resultRelInfo);
 static void EstCopyMemInfo(Relation rel, UtilityDesc* desc);
 
 static void CopyFromInsertBatch(Relation rel, EState* estate, CommandId mycid, int hi_options,
@@ -1004,10 +1008,20 @@ uint64 DoCopy(CopyStmt* stmt, const char* queryString)
         {
             SyncBulkloadStates(cstate);
 
+            /*
+             * Overlap reading a server file with parsing and inserting.  The
+             * reader must be stopped on the error path as well, or its thread
+             * would wait for the backend forever.
+             */
+            if (u_sess->attr.attr_storage.enable_copy_read_ahead && cstate->copy_dest == COPY_FILE &&
+                cstate->filename != NULL && cstate->copyGetDataFunc == CopyGetDataDefault)
+                CopyReaderStart(cstate);
+
             processed = CopyFrom(cstate); /* copy from file to database */
         }
         PG_CATCH();
         {
+            CopyReaderStop(cstate);
             CleanBulkloadStates();
             PG_RE_THROW();
         }
@@ -3361,6 +3375,52 @@ static void CStoreCopyConstraintsCheck(ResultRelInfo* resultRelInfo, Datum* valu
         ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("Column Store unsupport CHECK constraint")));
 }
 
+/*
+ * Check whether COPY FROM may load cstate->rel with heap_direct_load_insert().
+ *
+ * Direct-path load writes pages straight to a relfilenode created in this
+ * transaction, so nobody else can be looking at it and an abort just drops
+ * the file.  Everything that wants to see each tuple as it is inserted ---
+ * triggers, per-tuple index maintenance, logical decoding, BCM data
+ * replication, row compression --- rules it out; indexes are rebuilt once
+ * the load is done instead.  Since a unique or exclusion violation would
+ * only show up in that rebuild, after the whole file has been loaded and
+ * past any error-row logging, such indexes and LOG ERRORS rule it out too.
+ */
+static bool CopyFromCanDirectLoad(CopyState cstate, ResultRelInfo* resultRelInfo)
+{
+    Relation rel = cstate->rel;
+    SubTransactionId mySubid = GetCurrentSubTransactionId();
+
+    if (!u_sess->attr.attr_storage.enable_copy_direct_load || IS_PGXC_COORDINATOR)
+        return false;
+
+    if (rel->rd_rel->relkind != RELKIND_RELATION || RELATION_IS_PARTITIONED(rel) || RELATION_OWN_BUCKET(rel) ||
+        RelationIsColStore(rel) || RowRelationIsCompressed(rel) || RelationIsLogicallyLogged(rel))
+        return false;
+
+    if (resultRelInfo->ri_TrigDesc != NULL || enable_heap_bcm_data_replication())
+        return false;
+
+    if (cstate->log_errors || cstate->logErrorsData)
+        return false;
+
+    for (int i = 0; i < resultRelInfo->ri_NumIndices; i++) {
+        IndexInfo* indexInfo = resultRelInfo->ri_IndexRelationInfo[i];
+
+        if (indexInfo->ii_Unique || indexInfo->ii_ExclusionOps != NULL)
+            return false;
+    }
+
+    /* The relfilenode must belong to this very subtransaction, as for skipping WAL */
+    if (rel->rd_createSubid != mySubid && rel->rd_newRelfilenodeSubid != mySubid)
+        return false;
+
+    /* Only an empty relfilenode: we append pages without the buffer manager */
+    RelationOpenSmgr(rel);
+    return smgrnblocks(rel->rd_smgr, MAIN_FORKNUM) == 0;
+}
+
 /*
  * Copy FROM file to relation.
  */
@@ -3395,6 +3455,8 @@ static uint64 CopyFrom(CopyState cstate)
     bool hasBucket = false;
     MemInfoArg* CopyMem = NULL;
     bool needflush = false;
+    HeapDirectLoad directLoad = NULL;
+    bool rebuildIndexes = false;
     Assert(cstate->rel);
 
     if (cstate->rel->rd_rel->relkind != RELKIND_RELATION) {
@@ -3514,6 +3576,12 @@ static uint64 CopyFrom(CopyState cstate)
         useHeapMultiInsert = true;
         mgr = initCopyFromManager(cstate->copycontext, resultRelationDesc);
         cstate->pcState = New(cstate->copycontext) PageCompress(resultRelationDesc, cstate->copycontext);
+
+        /* heap_end_direct_load() does the heap_sync, so no need for needflush */
+        if (CopyFromCanDirectLoad(cstate, resultRelInfo)) {
+            directLoad = heap_begin_direct_load(cstate->rel, mycid, hi_options);
+            needflush = false;
+        }
     }
 
     /* Prepare to catch AFTER triggers. */
@@ -3964,7 +4032,11 @@ static uint64 CopyFrom(CopyState cstate)
                     bucketid = computeTupleBucketId(resultRelationDesc, tuple);
                 }
 
-                if (useHeapMultiInsert) {
+                if (directLoad != NULL) {
+                    /* indexes are rebuilt after the load, see below */
+                    heap_direct_load_insert(directLoad, tuple);
+                    resetPerTupCxt = true;
+                } else if (useHeapMultiInsert) {
                     bool toFlush = false;
                     CopyFromBulk bulk = NULL;
                     /* step 1: query and get the caching buffer */
@@ -4093,6 +4165,12 @@ static uint64 CopyFrom(CopyState cstate)
 
     CStoreInsert::DeInitInsertArg(args);
 
+    if (directLoad != NULL) {
+        heap_end_direct_load(directLoad);
+        directLoad = NULL;
+        rebuildIndexes = (resultRelInfo->ri_NumIndices > 0);
+    }
+
     /* Flush any remaining buffered tuples */
     if (useHeapMultiInsert) {
         if (hasPartition) {
@@ -4194,6 +4272,13 @@ static uint64 CopyFrom(CopyState cstate)
         }
     }
 
+    /*
+     * A direct-path load made no index entries.  Build them all in one pass
+     * now, which is also where unique constraints get checked.
+     */
+    if (rebuildIndexes)
+        (void)reindex_relation(RelationGetRelid(cstate->rel), REINDEX_REL_CHECK_CONSTRAINTS, REINDEX_ALL_INDEX);
+
     if (enable_heap_bcm_data_replication() && !RelationIsForeignTable(cstate->rel))
         HeapSyncHashSearch(cstate->rel->rd_id, HASH_REMOVE);
 
@@ -5489,7 +5574,9 @@ void EndCopyFrom(CopyState cstate)
         FreeRemoteCopyData(cstate->remoteCopyState);
 #endif
 
-    /* No COPY FROM related resources except memory. */
+    /* Let go of the read-ahead thread, if any */
+    CopyReaderStop(cstate);
+
     EndCopy(cstate);
     cstate = NULL;
 }
@@ -5656,6 +5743,7 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
     bool last_was_esc = false;
     char quotec = '\0';
     char escapec = '\0';
+    SimdScanSet scan_set;
 
     if (csv_mode) {
         quotec = cstate->quote[0];
@@ -5668,6 +5756,24 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
 
     mblen_str[1] = '\0';
 
+    /*
+     * Bytes that need the per-character state machine below.  Anything else
+     * is plain data and is skipped in bulk with the vectorized scanner.
+     */
+    SimdScanSetInit(&scan_set);
+    if (cstate->eol_type == EOL_UD) {
+        SimdScanSetAdd(&scan_set, cstate->eol[0]);
+    } else {
+        SimdScanSetAdd(&scan_set, '\r');
+        SimdScanSetAdd(&scan_set, '\n');
+    }
+    SimdScanSetAdd(&scan_set, '\\');
+    if (csv_mode) {
+        SimdScanSetAdd(&scan_set, quotec);
+        SimdScanSetAdd(&scan_set, escapec);
+    }
+    scan_set.highbit = cstate->encoding_embeds_ascii;
+
     /*
      * The objective of this loop is to transfer the entire next input line
      * into line_buf.  Hence, we only care for detecting newlines (\r and/or
@@ -5696,6 +5802,7 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
     for (;;) {
         int prev_raw_ptr;
         char c;
+        size_t skip;
 
         /*
          * Load more data if needed.  Ideally we would just force four bytes
@@ -5730,6 +5837,20 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
             need_data = false;
         }
 
+        /*
+         * Jump over the run of ordinary data bytes in front of us.  None of
+         * them changes the quote state, but they do end an escape sequence
+         * and mean we are no longer at the start of the line.
+         */
+        skip = SimdScanFind(&scan_set, copy_raw_buf + raw_buf_ptr, copy_buf_len - raw_buf_ptr);
+        if (skip > 0) {
+            raw_buf_ptr += (int)skip;
+            first_char_in_line = false;
+            last_was_esc = false;
+            if (raw_buf_ptr >= copy_buf_len)
+                continue;
+        }
+
         /* OK to fetch a character */
         prev_raw_ptr = raw_buf_ptr;
         c = copy_raw_buf[raw_buf_ptr++];
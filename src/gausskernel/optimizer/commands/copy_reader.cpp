@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * copy_reader.cpp
+ *	  Read-ahead reader stage for COPY FROM a server file.
+ *
+ * COPY FROM used to fread() RAW_BUF_SIZE bytes at a time in the backend,
+ * so every refill of raw_buf stalled line splitting, attribute parsing and
+ * tuple insertion.  The reader splits the load into two stages: a helper
+ * thread that reads the file in COPY_READER_CHUNK_SIZE chunks into a ring of
+ * buffers, and the backend which keeps parsing and inserting as before but
+ * pulls raw data out of the ring instead of calling fread() itself.
+ *
+ * Only the file read is moved to a helper thread.  Parsing and inserting
+ * stay in the backend: heap and CStore inserts, index maintenance, triggers
+ * and error-row logging all need the session's transaction, snapshot and
+ * resource owner, which a helper thread cannot have.
+ *
+ * The helper is started through gs_thread_create(), so its thread-local
+ * storage is bound like any other thread's, and with every signal blocked,
+ * so that signals meant for the backend are never delivered to it.  It
+ * still does no palloc and no elog: all errors are handed back to the
+ * backend through the shared state and reported there.  It reads through
+ * its own dup of the file descriptor, so the backend can close copy_file
+ * without waiting for a slow fread() to return.  The dup is positioned at
+ * copy_file's stdio position, not the descriptor's, because BeginCopyFrom
+ * may already have read a binary header through a buffered fread().
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/optimizer/commands/copy_reader.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "commands/copy.h"
+#include "commands/copy_reader.h"
+#include "miscadmin.h"
+#include "utils/memutils.h"
+
+/* how long the backend sleeps before re-checking for interrupts, in ms */
+#define COPY_READER_WAIT_INTERVAL 100
+
+static void CopyReaderFree(CopyReaderState* reader)
+{
+    if (reader->file != NULL)
+        (void)fclose(reader->file);
+    for (int i = 0; i < COPY_READER_NUM_CHUNKS; i++)
+        free(reader->chunks[i].data);
+    (void)pthread_cond_destroy(&reader->cond);
+    (void)pthread_mutex_destroy(&reader->mutex);
+    free(reader);
+}
+
+static void* CopyReaderMain(void* arg)
+{
+    CopyReaderState* reader = (CopyReaderState*)((knl_thread_arg*)arg)->payload;
+    bool orphaned = false;
+
+    (void)pthread_mutex_lock(&reader->mutex);
+    for (;;) {
+        CopyReaderChunk* chunk = NULL;
+        size_t nread;
+        int err = 0;
+
+        while (!reader->stop && reader->nready == COPY_READER_NUM_CHUNKS)
+            (void)pthread_cond_wait(&reader->cond, &reader->mutex);
+        if (reader->stop)
+            break;
+
+        /* The tail chunk is not visible to the backend until nready covers it */
+        chunk = &reader->chunks[reader->tail];
+        (void)pthread_mutex_unlock(&reader->mutex);
+
+        nread = fread(chunk->data, 1, COPY_READER_CHUNK_SIZE, reader->file);
+        if (nread == 0 && ferror(reader->file))
+            err = (errno != 0) ? errno : EIO;
+
+        (void)pthread_mutex_lock(&reader->mutex);
+        chunk->len = (int)nread;
+        chunk->cursor = 0;
+        reader->tail = (reader->tail + 1) % COPY_READER_NUM_CHUNKS;
+        reader->nready++;
+        if (nread == 0) {
+            /* an empty ready chunk tells the backend there is no more data */
+            reader->eof = true;
+            reader->read_err = err;
+        }
+        (void)pthread_cond_broadcast(&reader->cond);
+        if (reader->eof)
+            break;
+    }
+    reader->exited = true;
+    orphaned = reader->orphaned;
+    (void)pthread_mutex_unlock(&reader->mutex);
+
+    /* the backend is gone from this state and will never look at it again */
+    if (orphaned)
+        CopyReaderFree(reader);
+
+    return NULL;
+}
+
+/*
+ * CopyReaderStart - start the read-ahead thread for cstate->copy_file
+ *
+ * From now on the backend must not access cstate->copy_file directly until
+ * CopyReaderStop() is called.  If the thread cannot be created we silently
+ * keep reading the file synchronously.
+ */
+void CopyReaderStart(CopyState cstate)
+{
+    CopyReaderState* reader = NULL;
+    sigset_t all_signals;
+    sigset_t old_signals;
+    off_t offset;
+    int fd;
+    int rc;
+
+    Assert(cstate->is_from && cstate->copy_dest == COPY_FILE);
+    Assert(cstate->reader == NULL);
+
+    /*
+     * BeginCopyFrom has already read the header of a binary file through
+     * stdio, which buffered more than that, so the descriptor's offset is
+     * past where parsing continues.  We restart the read at copy_file's
+     * logical position; a pipe cannot do that and is read synchronously.
+     */
+    offset = ftello(cstate->copy_file);
+    if (offset < 0)
+        return;
+
+    reader = (CopyReaderState*)calloc(1, sizeof(CopyReaderState));
+    if (reader == NULL)
+        return;
+    (void)pthread_mutex_init(&reader->mutex, NULL);
+    (void)pthread_cond_init(&reader->cond, NULL);
+    for (int i = 0; i < COPY_READER_NUM_CHUNKS; i++) {
+        reader->chunks[i].data = (char*)malloc(COPY_READER_CHUNK_SIZE);
+        if (reader->chunks[i].data == NULL) {
+            CopyReaderFree(reader);
+            return;
+        }
+    }
+
+    /* The dup shares the file position, and nobody else reads copy_file meanwhile */
+    fd = dup(fileno(cstate->copy_file));
+    if (fd < 0 || lseek(fd, offset, SEEK_SET) < 0 || (reader->file = fdopen(fd, "r")) == NULL) {
+        ereport(LOG,
+            (errmsg("could not start COPY read-ahead thread, reading \"%s\" synchronously: %m", cstate->filename)));
+        if (fd >= 0)
+            (void)close(fd);
+        CopyReaderFree(reader);
+        return;
+    }
+
+    reader->thread_arg.next = NULL;
+    reader->thread_arg.m_thd_arg.payload = reader;
+
+    /* the new thread inherits the mask, so it starts with every signal blocked */
+    (void)sigfillset(&all_signals);
+    (void)pthread_sigmask(SIG_SETMASK, &all_signals, &old_signals);
+    rc = gs_thread_create(&reader->thread, CopyReaderMain, 1, &reader->thread_arg);
+    (void)pthread_sigmask(SIG_SETMASK, &old_signals, NULL);
+
+    if (rc != 0) {
+        ereport(LOG,
+            (errmsg("could not start COPY read-ahead thread, reading \"%s\" synchronously: %s",
+                cstate->filename,
+                strerror(rc))));
+        CopyReaderFree(reader);
+        return;
+    }
+
+    cstate->reader = reader;
+    cstate->copyGetDataFunc = CopyReaderGetData;
+}
+
+/*
+ * CopyReaderStop - terminate the read-ahead thread
+ *
+ * Safe to call when no reader was started, and from error cleanup paths:
+ * it never throws.  It never waits for a read in progress either, so a
+ * slow file cannot hold up cancel or terminate: a reader that is still
+ * busy is detached and frees the shared state itself when it is done.
+ */
+void CopyReaderStop(CopyState cstate)
+{
+    CopyReaderState* reader = cstate->reader;
+    bool exited = false;
+
+    if (reader == NULL)
+        return;
+    cstate->reader = NULL;
+
+    (void)pthread_mutex_lock(&reader->mutex);
+    reader->stop = true;
+    exited = reader->exited;
+    if (!exited)
+        reader->orphaned = true;
+    (void)pthread_cond_broadcast(&reader->cond);
+    (void)pthread_mutex_unlock(&reader->mutex);
+
+    if (exited) {
+        /* only the last few instructions of the thread are left */
+        (void)pthread_join(gs_thread_id(reader->thread), NULL);
+        CopyReaderFree(reader);
+    } else {
+        (void)pthread_detach(gs_thread_id(reader->thread));
+    }
+}
+
+/*
+ * Wait until the reader has published at least one chunk.  We cannot sleep
+ * uninterruptibly on a slow file, so wake up periodically and check for
+ * query cancel; the mutex must be released before CHECK_FOR_INTERRUPTS()
+ * because it may longjmp out of here.
+ */
+static void CopyReaderWaitForChunk(CopyReaderState* reader)
+{
+    for (;;) {
+        struct timespec deadline;
+        bool ready = false;
+
+        (void)clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += COPY_READER_WAIT_INTERVAL * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        (void)pthread_mutex_lock(&reader->mutex);
+        if (reader->nready == 0)
+            (void)pthread_cond_timedwait(&reader->cond, &reader->mutex, &deadline);
+        ready = (reader->nready > 0);
+        (void)pthread_mutex_unlock(&reader->mutex);
+
+        if (ready)
+            return;
+
+        CHECK_FOR_INTERRUPTS();
+    }
+}
+
+/*
+ * CopyReaderGetData - copyGetDataFunc used while the reader is running
+ *
+ * Same contract as CopyGetDataDefault() for COPY_FILE: returns between
+ * minread and maxread bytes, or fewer only at end of file.  We block only
+ * while we have less than minread bytes; otherwise we return whatever is
+ * already buffered so the parser can get going.
+ */
+int CopyReaderGetData(CopyState cstate, void* databuf, int minread, int maxread)
+{
+    CopyReaderState* reader = cstate->reader;
+    char* dst = (char*)databuf;
+    int bytesread = 0;
+
+    Assert(reader != NULL);
+
+    if (minread > maxread) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+            errmsg("could not get data from COPY source")));
+    }
+
+    while (bytesread < maxread) {
+        CopyReaderChunk* chunk = NULL;
+        int avail;
+        errno_t rc;
+
+        (void)pthread_mutex_lock(&reader->mutex);
+        if (reader->nready == 0) {
+            (void)pthread_mutex_unlock(&reader->mutex);
+            if (bytesread >= minread)
+                break;
+            CopyReaderWaitForChunk(reader);
+            continue;
+        }
+        chunk = &reader->chunks[reader->head];
+        (void)pthread_mutex_unlock(&reader->mutex);
+
+        if (chunk->len == 0) {
+            /* End of file.  Leave the marker in place for later calls. */
+            if (reader->read_err != 0) {
+                errno = reader->read_err;
+                ereport(ERROR, (errcode_for_file_access(), errmsg("could not read from COPY file: %m")));
+            }
+            break;
+        }
+
+        /* The head chunk belongs to us until we hand it back below */
+        avail = Min(chunk->len - chunk->cursor, maxread - bytesread);
+        rc = memcpy_s(dst + bytesread, maxread - bytesread, chunk->data + chunk->cursor, avail);
+        securec_check(rc, "\0", "\0");
+        chunk->cursor += avail;
+        bytesread += avail;
+
+        if (chunk->cursor == chunk->len) {
+            (void)pthread_mutex_lock(&reader->mutex);
+            reader->head = (reader->head + 1) % COPY_READER_NUM_CHUNKS;
+            reader->nready--;
+            (void)pthread_cond_broadcast(&reader->cond);
+            (void)pthread_mutex_unlock(&reader->mutex);
+        }
+    }
+
+    return bytesread;
+}
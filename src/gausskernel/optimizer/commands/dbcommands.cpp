@@ -960,6 +960,9 @@ void dropdb(const char* dbname, bool missing_ok)
      */
     ForgetDatabaseFsyncRequests(db_id);
 
+    /* Close idle descriptors of its files held in the thread-shared fd cache */
+    ForgetDatabaseDataFileIdCache(db_id);
+
     /*
      * Force a checkpoint to make sure the checkpointer has received the
      * message sent by ForgetDatabaseFsyncRequests. On Windows, this also
@@ -1401,8 +1404,10 @@ static void movedb_success_callback(Oid db_id, Oid src_tblspcoid)
 #endif
 
     /*
-     * Remove files from the old tablespace
+     * Remove files from the old tablespace, after closing idle descriptors of
+     * them in the thread-shared fd cache
      */
+    ForgetDatabaseDataFileIdCache(db_id);
     if (!rmtree(src_dbpath, true))
         ereport(
             WARNING, (errmsg("some useless files may be left behind in old database directory \"%s\"", src_dbpath)));
@@ -2137,6 +2142,9 @@ void xlog_db_drop(Oid dbId, Oid tbSpcId)
     /* Also, clean out any fsync requests that might be pending in md.c */
     ForgetDatabaseFsyncRequests(dbId);
 
+    /* and any idle descriptors of its files in the thread-shared fd cache */
+    ForgetDatabaseDataFileIdCache(dbId);
+
     /* Clean out the xlog relcache too */
     XLogDropDatabase(dbId);
 
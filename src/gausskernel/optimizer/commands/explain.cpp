@@ -1413,7 +1413,10 @@ static void show_bucket_info(PlanState* planstate, ExplainState* es, bool is_pre
     Scan* scanplan = (Scan*)planstate->plan;
     BucketInfo* bucket_info = scanplan->bucketInfo;
     int selected_buckets = list_length(bucket_info->buckets);
-    if (selected_buckets == 0) {
+    if (bucket_info->pruningExpr != NULL) {
+        /* the bucket of the run-time value of the bucket key */
+        selected_buckets = 1;
+    } else if (selected_buckets == 0) {
         /* 0 means all buckets */
         selected_buckets = BUCKETDATALEN;
     }
@@ -12793,15 +12793,15 @@ static void copy_relation_data(Relation rel, SMgrRelation* dstptr, ForkNumber fo
      * can seriously hurt transfer speed to and from the kernel; not to
      * mention possibly making log_newpage's accesses to the page header fail.
      */
-    ADIO_RUN()
+    DIO_RUN()
     {
         buf = (char*)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         buf = (char*)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
     page = (Page)buf;
 
     /*
@@ -12884,15 +12884,15 @@ static void copy_relation_data(Relation rel, SMgrRelation* dstptr, ForkNumber fo
         smgrextend(dst, forkNum, blkno, bufToWrite, true);
     }
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(buf);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree_ext(buf);
     }
-    ADIO_END();
+    DIO_END();
 
     /*
      * If the rel isn't temp, we must fsync it down to disk before it's safe
@@ -12938,15 +12938,15 @@ static void mergeHeapBlock(Relation src, Relation dest, ForkNumber forkNum, char
      * can seriously hurt transfer speed to and from the kernel; not to
      * mention possibly making log_newpage's accesses to the page header fail.
      */
-    ADIO_RUN()
+    DIO_RUN()
     {
         buf = (char*)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         buf = (char*)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
     page = (Page)buf;
 
     /*
@@ -13092,15 +13092,15 @@ static void mergeHeapBlock(Relation src, Relation dest, ForkNumber forkNum, char
         smgrextend(dest->rd_smgr, forkNum, dest_blkno, bufToWrite, true);
     }
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(buf);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree_ext(buf);
     }
-    ADIO_END();
+    DIO_END();
 
     /*
      * If the rel isn't temp, we must fsync it down to disk before it's safe
@@ -46,6 +46,7 @@
 #include "commands/tablespace.h"
 #include "commands/verify.h"
 #include "utils/acl.h"
+#include "utils/aiomem.h"
 #include "utils/fmgroids.h"
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
@@ -1201,13 +1202,24 @@ static void VerifyRowRel(VacuumStmt* stmt, Relation rel, VerifyDesc* checkCudesc
  */
 static bool VerifyRowRelFast(Relation rel, VerifyDesc* checkCudesc)
 {
-    char* buf = (char*)palloc(BLCKSZ);
+    char* buf = NULL;
     BlockNumber nblocks;
     BlockNumber blkno;
-    Page page = (Page)buf;
+    Page page = NULL;
     ForkNumber forkNum = MAIN_FORKNUM;
     bool isValidRelationPage = true;
 
+    DIO_RUN()
+    {
+        buf = (char*)adio_align_alloc(BLCKSZ);
+    }
+    DIO_ELSE()
+    {
+        buf = (char*)palloc(BLCKSZ);
+    }
+    DIO_END();
+    page = (Page)buf;
+
     RelationOpenSmgr(rel);
     SMgrRelation src = rel->rd_smgr;
     nblocks = smgrnblocks(src, forkNum);
@@ -1241,7 +1253,15 @@ static bool VerifyRowRelFast(Relation rel, VerifyDesc* checkCudesc)
         }
     }
 
-    pfree_ext(buf);
+    DIO_RUN()
+    {
+        adio_align_free(buf);
+    }
+    DIO_ELSE()
+    {
+        pfree_ext(buf);
+    }
+    DIO_END();
     return isValidRelationPage;
 }
 
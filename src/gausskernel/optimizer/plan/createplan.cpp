@@ -36,6 +36,7 @@
 #include "nodes/nodeFuncs.h"
 #include "nodes/plannodes.h"
 #include "nodes/primnodes.h"
+#include "optimizer/bucketpruning.h"
 #include "optimizer/clauses.h"
 #include "optimizer/cost.h"
 #include "optimizer/dataskew.h"
@@ -127,7 +128,7 @@ static DfsScan* make_dfsscan(List* qptlist, List* qpqual, Index scanrelid, List*
 static PartIterator* create_partIterator_plan(
     PlannerInfo* root, PartIteratorPath* pIterpath, GlobalPartIterator* gpIter);
 static Plan* setPartitionParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel);
-static Plan* setBucketInfoParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel);
+static Plan* setBucketInfoParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel, List* scan_clauses);
 Plan* create_globalpartInterator_plan(PlannerInfo* root, PartIteratorPath* pIterpath);
 
 static IndexScan* make_indexscan(List* qptlist, List* qpqual, Index scanrelid, Oid indexid, List* indexqual,
@@ -678,7 +679,7 @@ static Plan* create_scan_plan(PlannerInfo* root, Path* best_path)
         WLMmonitor_check_and_update_IOCost(root, best_path->pathtype, plan->total_cost);
 
     (void*)setPartitionParam(root, plan, best_path->parent);
-    (void*)setBucketInfoParam(root, plan, best_path->parent);
+    (void*)setBucketInfoParam(root, plan, best_path->parent, scan_clauses);
 
     /*
      * If there are any pseudoconstant clauses attached to this node, insert a
@@ -8737,7 +8738,7 @@ static Plan* setPartitionParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel)
     }
     return plan;
 }
-static Plan* setBucketInfoParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel)
+static Plan* setBucketInfoParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel, List* scan_clauses)
 {
     if (rel->bucketInfo != NULL) {
         if (!PointerIsValid(plan) || !PointerIsValid(rel) || !PointerIsValid(root)) {
@@ -8748,9 +8749,30 @@ static Plan* setBucketInfoParam(PlannerInfo* root, Plan* plan, RelOptInfo* rel)
         }
         switch (plan->type) {
             case T_SeqScan:
-            case T_CStoreScan:
             case T_IndexScan:
-            case T_IndexOnlyScan:
+            case T_IndexOnlyScan: {
+                Scan* scan = (Scan*)plan;
+                scan->bucketInfo = rel->bucketInfo;
+
+                /*
+                 * If no bucket could be pruned with constants, the bucket key
+                 * may still be compared with a Param or an outer rel's
+                 * column; then the executor picks the one bucket to scan.
+                 * Bitmap scans are left out, as their heap and index sides
+                 * must walk the same buckets.
+                 */
+                if (rel->bucketInfo->buckets == NIL) {
+                    Expr* pruning_expr = GetBucketPruningExpr(root, rel, scan_clauses);
+
+                    if (pruning_expr != NULL) {
+                        pruning_expr = (Expr*)replace_nestloop_params(root, (Node*)pruning_expr);
+                        fix_opfuncids((Node*)pruning_expr);
+                        scan->bucketInfo = (BucketInfo*)copyObject(rel->bucketInfo);
+                        scan->bucketInfo->pruningExpr = pruning_expr;
+                    }
+                }
+            } break;
+            case T_CStoreScan:
             case T_BitmapHeapScan:
             case T_BitmapIndexScan:
             case T_TidScan:
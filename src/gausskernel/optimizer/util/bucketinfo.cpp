@@ -251,7 +251,7 @@ static StringInfo bucketInfoToNotString(BucketInfo* bucket_info)
 char* bucketInfoToString(BucketInfo* bucket_info)
 {
     if (bucket_info->buckets == NIL) {
-        return "all";
+        return (bucket_info->pruningExpr != NULL) ? "chosen at run time" : "all";
     } else {
         StringInfo dotstr = bucketInfoToDotString(bucket_info);
         StringInfo notstr = bucketInfoToNotString(bucket_info);
@@ -31,6 +31,9 @@
 #include "nodes/bitmapset.h"
 #include "nodes/makefuncs.h"
 #include "nodes/relation.h"
+#include "nodes/nodeFuncs.h"
+#include "optimizer/clauses.h"
+#include "optimizer/var.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "pgxc/pgxc.h"
@@ -84,6 +87,7 @@ static BucketPruningResult* BucketPruningForExpr(BucketPruningContext* bpcxt, Ex
 static int getConstBucketId(Const* val);
 static BucketPruningResult* BucketPruningForBoolExpr(BucketPruningContext* bpcxt, BoolExpr* expr);
 static BucketPruningResult* BucketPruningForOpExpr(BucketPruningContext* bpcxt, OpExpr* expr);
+static Expr* GetBucketKeyValue(RelOptInfo* rel, AttrNumber attno, OpExpr* expr);
 
 /*
  * @Description: make a pruning result based on the PruningStatus
@@ -652,28 +656,144 @@ static BucketPruningResult* BucketPruningForOpExpr(BucketPruningContext* bpcxt,
 /*
  * @Description: calculate the bucketid for a const val
  *
- *         notice the algorithm must be the same with
- *         the executor, double check it when make modify
- *
  * @in  Const: the const val which we want the bucketid of it
  * @return the bucketid index of the const val
  */
 static int getConstBucketId(Const* val)
+{
+    return GetBucketIdByValue(val->consttype, val->constvalue, val->constisnull);
+}
+
+/*
+ * @Description: calculate the bucketid for a value of the bucket key
+ *
+ *         notice the algorithm must be the same with
+ *         the executor, double check it when make modify
+ *
+ * @in  type: the type of the value
+ * @in  value: the value which we want the bucketid of it
+ * @in  isnull: whether the value is null
+ * @return the bucketid index of the value
+ */
+int GetBucketIdByValue(Oid type, Datum value, bool isnull)
 {
     uint32 hashval = 0;
     int bucketid = 0;
 
-    if (val->constisnull) {
+    if (isnull) {
         return 0;
     }
 
-    hashval = compute_hash(val->consttype, val->constvalue, LOCATOR_TYPE_HASH);
+    hashval = compute_hash(type, value, LOCATOR_TYPE_HASH);
 
     bucketid = compute_modulo((unsigned int)(abs((int)hashval)), BUCKETDATALEN);
 
     return bucketid;
 }
 
+/*
+ * @Description: find the value side of a "bucket key = value" OpExpr
+ *
+ *         the value must not reference the rel itself and must be
+ *         safe to evaluate once before the scan: no volatile functions,
+ *         no subplans and no sets.  It must have the type of the bucket
+ *         key, so hashing it gives the bucket the row was stored in.
+ *
+ * @in  RelOptInfo: the scanned rel
+ * @in  attno: the bucket key attno
+ * @in  Expr: the OpExpr to check
+ * @return the value expr, or NULL if the OpExpr is not of this form
+ */
+static Expr* GetBucketKeyValue(RelOptInfo* rel, AttrNumber attno, OpExpr* expr)
+{
+    char* opName = NULL;
+    Expr* args[2];
+    Var* varArg = NULL;
+    Expr* valueArg = NULL;
+
+    if (list_length(expr->args) != 2 || !PointerIsValid(opName = get_opname(expr->opno)) ||
+        pg_strcasecmp(opName, "=") != 0) {
+        return NULL;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        args[i] = (Expr*)list_nth(expr->args, i);
+        /* handle the relabel type */
+        while (args[i] && IsA(args[i], RelabelType)) {
+            args[i] = ((RelabelType*)args[i])->arg;
+        }
+    }
+
+    for (int i = 0; i < 2; i++) {
+        Var* var = (Var*)args[i];
+
+        if (var != NULL && IsA(var, Var) && var->varno == rel->relid && var->varlevelsup == 0 &&
+            var->varattno == attno) {
+            varArg = var;
+            valueArg = args[1 - i];
+            break;
+        }
+    }
+
+    if (varArg == NULL || valueArg == NULL || IsA(valueArg, Const) || exprType((Node*)valueArg) != varArg->vartype) {
+        return NULL;
+    }
+
+    if (bms_is_member(rel->relid, pull_varnos((Node*)valueArg)) || contain_volatile_functions((Node*)valueArg) ||
+        contain_subplans((Node*)valueArg) || expression_returns_set((Node*)valueArg)) {
+        return NULL;
+    }
+
+    return valueArg;
+}
+
+/*
+ * @Description: find the value the bucket key must equal when it is only
+ *               known at run time
+ *
+ *       The pruning above only works on constants.  A "bucket key = value"
+ *       clause whose value is a Param, or in a parameterized path an
+ *       expression over the outer rels, still leaves a single bucket to
+ *       scan once the value is known.  The executor evaluates the value
+ *       when the scan starts or is rescanned and scans that bucket only.
+ *
+ * @in  PlannerInfo: this holds many things needed during pruning
+ * @in  RelOptInfo: the scanned rel, whose bucketInfo did not prune anything
+ * @in  List of restrictInfo: the scan clauses, an implicit AND
+ * @return a copy of the value expr, or NULL if there is no such clause
+ */
+Expr* GetBucketPruningExpr(PlannerInfo* root, RelOptInfo* rel, List* scanClauses)
+{
+    RangeTblEntry* rte = planner_rt_fetch(rel->relid, root);
+    AttrNumber attno = InvalidAttrNumber;
+    ListCell* cell = NULL;
+
+    if (rte->rtekind != RTE_RELATION || !rte->relhasbucket || rte->isbucket) {
+        return NULL;
+    }
+
+    foreach (cell, scanClauses) {
+        RestrictInfo* rinfo = (RestrictInfo*)lfirst(cell);
+        Expr* value = NULL;
+
+        if (!IsA(rinfo->clause, OpExpr)) {
+            continue;
+        }
+
+        /* look the key up only once there is a candidate clause */
+        if (attno == InvalidAttrNumber && (attno = GetDistributeKeyAttno(rte->relid)) == InvalidAttrNumber) {
+            return NULL;
+        }
+
+        value = GetBucketKeyValue(rel, attno, (OpExpr*)rinfo->clause);
+        if (value != NULL) {
+            return (Expr*)copyObject(value);
+        }
+    }
+
+    return NULL;
+}
+
 /*
  * @Description: calculate the pruning ratio for cost-model
  *
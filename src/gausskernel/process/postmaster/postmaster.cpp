@@ -3347,6 +3347,13 @@ int ProcessStartupPacket(Port* port, bool SSLdone)
                     ereport(elevel,
                         (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
                             errmsg("requested backend version is larger than grand version.")));
+            } else if (strcmp(nameptr, "_pq_.columnar_result") == 0) {
+                /* a protocol option, not a GUC: only the client can turn it on */
+                if (!parse_bool(valptr, &port->columnar_result))
+                    ereport(elevel,
+                        (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                            errmsg("invalid value for parameter \"_pq_.columnar_result\""),
+                            errhint("Valid values are: false, 0, true, 1.")));
             } else if (strcmp(nameptr, "connect_timeout") == 0) {
                 errno = 0;
                 u_sess->attr.attr_network.PoolerConnectTimeout = (uint32) strtoul(valptr, NULL, 10);
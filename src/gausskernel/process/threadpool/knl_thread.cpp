@@ -1056,6 +1056,7 @@ static void knl_t_libpq_init(knl_t_libpq_context* libpq_cxt)
     libpq_cxt->PqSendBuffer = NULL;
     libpq_cxt->PqCommBusy = false;
     libpq_cxt->DoingCopyOut = false;
+    libpq_cxt->PqPendingRows = NULL;
 
     libpq_cxt->save_query_result_to_disk = false;
     temp_file_context_init(libpq_cxt);
@@ -1134,6 +1135,8 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
     storage_cxt->InProgressAioDispatchCount = 0;
     storage_cxt->InProgressAioBuf = NULL;
     storage_cxt->InProgressAioType = AioUnkown;
+    storage_cxt->FileAioUring = NULL;
+    storage_cxt->FileAioUringFailed = false;
     storage_cxt->is_btree_split = false;
     storage_cxt->PrivateRefCountArray =
         (PrivateRefCountEntry*)palloc0(sizeof(PrivateRefCountEntry) * REFCOUNT_ARRAY_ENTRIES);
@@ -1194,7 +1197,9 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
     storage_cxt->conflicting_lock_mode_name = NULL;
     storage_cxt->conflicting_lock_thread_id = 0;
     storage_cxt->conflicting_lock_by_holdlock = true;
-    storage_cxt->FastPathLocalUseCount = 0;
+    rc = memset_s(storage_cxt->FastPathLocalUseCounts, sizeof(storage_cxt->FastPathLocalUseCounts), 0,
+        sizeof(storage_cxt->FastPathLocalUseCounts));
+    securec_check(rc, "\0", "\0");
     storage_cxt->FastPathStrongRelationLocks = NULL;
     storage_cxt->LockMethodLockHash = NULL;
     storage_cxt->LockMethodProcLockHash = NULL;
@@ -1240,6 +1245,7 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
 
     storage_cxt->cmprMetaInfo = (CmprMetaUnion*)palloc0(sizeof(CmprMetaUnion));
     storage_cxt->DataFileIdCache = NULL;
+    storage_cxt->DataFileIdCacheCtl = NULL;
 
     storage_cxt->max_safe_fds = 32;
     storage_cxt->max_userdatafiles = 8192 - 1000;
@@ -74,6 +74,8 @@
 #endif
 #include "vecexecutor/vectorbatch.h"
 #include "vecexecutor/vecexecutor.h"
+#include "vecexecutor/vecnodevectorow.h"
+#include "access/printtup.h"
 #include "utils/anls_opt.h"
 #include "utils/memprot.h"
 #include "utils/memtrack.h"
@@ -110,6 +112,7 @@ static void ExecutePlan(EState *estate, PlanState *planstate, CmdType operation,
     ScanDirection direction, DestReceiver *dest, JitExec::JitContext* mot_jit_context);
 static void ExecuteVectorizedPlan(EState *estate, PlanState *planstate, CmdType operation, bool sendTuples,
     long numberTuples, ScanDirection direction, DestReceiver *dest);
+static void ExecuteColumnarResultPlan(EState *estate, VecToRowState *node, TupleDesc tupdesc, DestReceiver *dest);
 static bool ExecCheckRTEPerms(RangeTblEntry *rte);
 static bool ExecCheckRTEPermsModified(Oid relOid, Oid userid, Bitmapset *modifiedCols, AclMode requiredPerms);
 void ExecCheckXactReadOnly(PlannedStmt *plannedstmt);
@@ -570,6 +573,11 @@ void standard_ExecutorRun(QueryDesc *queryDesc, ScanDirection direction, long co
     if (!ScanDirectionIsNoMovement(direction)) {
         if (queryDesc->planstate->vectorized) {
             ExecuteVectorizedPlan(estate, queryDesc->planstate, operation, send_tuples, count, direction, dest);
+        } else if (send_tuples && operation == CMD_SELECT && count == 0 && ScanDirectionIsForward(direction) &&
+                   estate->es_junkFilter == NULL && IsA(queryDesc->planstate, VecToRowState) &&
+                   ((VecToRowState*)queryDesc->planstate)->nattrs == queryDesc->tupDesc->natts &&
+                   printtupCanSendColumns(dest, queryDesc->tupDesc)) {
+            ExecuteColumnarResultPlan(estate, (VecToRowState*)queryDesc->planstate, queryDesc->tupDesc, dest);
         } else {
             ExecutePlan(estate, queryDesc->planstate, operation, send_tuples,
                 count, direction, dest, queryDesc->mot_jit_context);
@@ -2205,6 +2213,37 @@ static void ExecuteVectorizedPlan(EState *estate, PlanState *planstate, CmdType
     }
 }
 
+/*
+ * ExecuteColumnarResultPlan
+ *
+ * Send the whole result of a vectorized plan to a client that negotiated
+ * columnar results.  The top VecToRow node devectorizes one batch at a time
+ * column by column, and the batch goes out as a single ColumnarData message
+ * instead of being turned into a slot and a DataRow per row.
+ */
+static void ExecuteColumnarResultPlan(EState *estate, VecToRowState *node, TupleDesc tupdesc, DestReceiver *dest)
+{
+    int rows;
+
+    estate->es_direction = ForwardScanDirection;
+
+    for (;;) {
+        ResetPerTupleExprContext(estate);
+
+        rows = ExecVecToRowBatch(node);
+        if (rows == 0) {
+            ExecEarlyFree((PlanState*)node);
+            break;
+        }
+
+        if (!u_sess->exec_cxt.executor_stop_flag) {
+            printtupColumns(dest, tupdesc, node->m_ttsvalues, node->m_ttsisnull, rows);
+        }
+
+        estate->es_processed += rows;
+    }
+}
+
 /*
  * ExecRelCheck --- check that tuple meets constraints for result relation
  */
@@ -685,7 +685,12 @@ VecAggState* ExecInitVecAggregation(VecAgg* node, EState* estate, int eflags)
             else
                 aggstate->aggInfo[idx].vec_agg_function.flinfo->vec_fn_addr = aggstate->aggInfo[idx].vec_agg_cache[1];
 
-            if (OidIsValid(peraggstate->finalfn_oid)) {
+            /*
+             * An aggregate whose final function only undoes the row engine's
+             * transition format, such as sum(numeric), has no vector final
+             * function: the vector transition value is already the result.
+             */
+            if (OidIsValid(peraggstate->finalfn_oid) && aggstate->aggInfo[idx].vec_agg_final[0] != NULL) {
                 InitFunctionCallInfoData(aggstate->aggInfo[idx].vec_final_function,
                     &peraggstate->finalfn,
                     2,
@@ -175,6 +175,26 @@ TupleTableSlot* ExecVecToRow(VecToRowState* state) /* return: a tuple or NULL */
     return tuple;
 }
 
+/*
+ * Devectorize the next whole batch for a consumer that takes rows a batch at
+ * a time.  The values are left in state->m_ttsvalues / m_ttsisnull, nattrs
+ * per row, valid until the next call; returns the number of rows, 0 when
+ * there are no more.  Must not be mixed with ExecVecToRow() on the same node.
+ */
+int ExecVecToRowBatch(VecToRowState* state)
+{
+    VectorBatch* current_batch = VectorEngine(outerPlanState(state));
+
+    if (BatchIsNull(current_batch))
+        return 0;
+
+    state->m_pCurrentBatch = current_batch;
+    state->m_currentRow = 0;
+    DevectorizeOneBatch(state);
+
+    return current_batch->m_rows;
+}
+
 VecToRowState* ExecInitVecToRow(VecToRow* node, EState* estate, int eflags)
 {
     VecToRowState* state = NULL;
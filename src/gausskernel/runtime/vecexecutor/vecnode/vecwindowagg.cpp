@@ -687,7 +687,8 @@ void VecWinAggRuntime::DispatchAggFunction(
 
         aggInfo->vec_agg_function.flinfo->vec_fn_addr = aggInfo->vec_agg_cache[0];
 
-        if (OidIsValid(peraggState->finalfn_oid)) {
+        /* no vector final function means the transition value is the result, cf. ExecInitVecAggregation */
+        if (OidIsValid(peraggState->finalfn_oid) && aggInfo->vec_agg_final[0] != NULL) {
             InitFunctionCallInfoData(
                 aggInfo->vec_final_function, &peraggState->finalfn, 2, perfuncstate->winCollation, NULL, NULL);
             aggInfo->vec_final_function.flinfo->fn_addr = aggInfo->vec_agg_final[0];
@@ -26,6 +26,7 @@
 #include "c.h"
 #include "catalog/pg_type.h"
 #include "storage/compress_kits.h"
+#include "vecexecutor/vechashfunc.h"
 #include "vectorsonic/vsonichash.h"
 #include "utils/dynahash.h"
 #ifdef __aarch64__
@@ -371,22 +372,25 @@ void SonicHash::hashGeneralFunc(char* val, uint8* flag, int nval, uint32* res, P
     Datum args[2];
     fcinfo.arg = &args[0];
 
-    for (int i = 0; i < nval; i++) {
-        if (likely(NOT_NULL(*flag))) {
-            fcinfo.arg[0] = *arrval;
-            if (rehash) {
-                hash_val = *res1;
-                hash_val = (hash_val << 1) | ((hash_val & 0x80000000) ? 1 : 0);
-                *res1 = hash_val ^ func(&fcinfo);
-            } else
-                *res1 = func(&fcinfo);
-        } else {
-            if (!rehash)
-                *res1 = 0;
+    /* fixed-width types such as date or oid are hashed without fmgr */
+    if (!VecHashColumnByFunc<rehash>(func, arrval, flag, nval, res)) {
+        for (int i = 0; i < nval; i++) {
+            if (likely(NOT_NULL(*flag))) {
+                fcinfo.arg[0] = *arrval;
+                if (rehash) {
+                    hash_val = *res1;
+                    hash_val = (hash_val << 1) | ((hash_val & 0x80000000) ? 1 : 0);
+                    *res1 = hash_val ^ func(&fcinfo);
+                } else
+                    *res1 = func(&fcinfo);
+            } else {
+                if (!rehash)
+                    *res1 = 0;
+            }
+            res1++;
+            arrval++;
+            flag++;
         }
-        res1++;
-        arrval++;
-        flag++;
     }
 
     /*
@@ -80,7 +80,7 @@ IndexTuple index_form_tuple(TupleDesc tuple_descriptor, Datum* values, const boo
         if (!VARATT_IS_EXTENDED(DatumGetPointer(untoasted_values[i])) &&
             VARSIZE(DatumGetPointer(untoasted_values[i])) > TOAST_INDEX_TARGET &&
             (att->attstorage == 'x' || att->attstorage == 'm')) {
-            Datum cvalue = toast_compress_datum(untoasted_values[i]);
+            Datum cvalue = toast_compress_datum(untoasted_values[i], toast_get_index_compression_method(att));
             if (DatumGetPointer(cvalue) != NULL) {
                 /* successful compression */
                 if (untoasted_free[i])
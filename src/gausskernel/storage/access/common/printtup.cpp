@@ -41,6 +41,8 @@ static void printtup_20(TupleTableSlot* slot, DestReceiver* self);
 static void printtup_internal_20(TupleTableSlot* slot, DestReceiver* self);
 static void printtup_shutdown(DestReceiver* self);
 static void printtup_destroy(DestReceiver* self);
+static void printtup_putrow(DR_printtup* my_state, StringInfo buf);
+static void printtup_flush_rows(DR_printtup* my_state);
 
 static void SendRowDescriptionCols_2(StringInfo buf, TupleDesc typeinfo, List* targetlist, int16* formats);
 static void SendRowDescriptionCols_3(StringInfo buf, TupleDesc typeinfo, List* targetlist, int16* formats);
@@ -444,6 +446,8 @@ static void printtup_startup(DestReceiver* self, int operation, TupleDesc typein
 
     /* create buffer to be used for all messages */
     initStringInfo(&my_state->buf);
+    initStringInfo(&my_state->rowbuf);
+    pq_register_pending_rows(&my_state->rowbuf);
 
     if (PG_PROTOCOL_MAJOR(FrontendProtocol) < 3) {
         /*
@@ -942,7 +946,7 @@ void printtup(TupleTableSlot* slot, DestReceiver* self)
         pq_beginmessage_reuse(buf, 'D');
         appendBinaryStringInfo(buf, slot->tts_dataRow, slot->tts_dataLen);
         AddCheckInfo(buf);
-        pq_endmessage_reuse(buf);
+        printtup_putrow(my_state, buf);
         StreamTimeSerilizeEnd(t_thrd.pgxc_cxt.GlobalNetInstr);
         return;
     }
@@ -1051,7 +1055,228 @@ void printtup(TupleTableSlot* slot, DestReceiver* self)
     StreamTimeSerilizeEnd(t_thrd.pgxc_cxt.GlobalNetInstr);
 
     AddCheckInfo(buf);
-    pq_endmessage_reuse(buf);
+    printtup_putrow(my_state, buf);
+}
+
+/*
+ * DataRow (and ColumnarData) messages are collected in rowbuf and handed to libpq
+ * PRINTTUP_ROWBUF_SIZE bytes at a time rather than one pq_putmessage() per
+ * row; pq_putmessages() sends a block that does not fit into the send buffer
+ * straight to the socket together with what is buffered there.  The rows are
+ * flushed by printtup_shutdown(), before the executor returns and any
+ * CommandComplete or PortalSuspended can be sent.  rowbuf is registered with
+ * libpq as well, so that a notice or error raised mid-query goes out after
+ * the rows produced before it, as it would without batching.
+ */
+#define PRINTTUP_ROWBUF_SIZE (64 * 1024)
+
+static void printtup_putrow(DR_printtup* my_state, StringInfo buf)
+{
+    StringInfo rowbuf = &my_state->rowbuf;
+    uint32 n32;
+
+    /* rowbuf is only set up by printtup_startup() */
+    if (rowbuf->data == NULL) {
+        pq_endmessage_reuse(buf);
+        return;
+    }
+
+    /* msgtype was saved in cursor field, see pq_beginmessage_reuse() */
+    appendStringInfoCharMacro(rowbuf, (char)buf->cursor);
+    n32 = htonl((uint32)(buf->len + 4));
+    appendBinaryStringInfo(rowbuf, (char*)&n32, 4);
+    appendBinaryStringInfo(rowbuf, buf->data, buf->len);
+
+    if (rowbuf->len >= PRINTTUP_ROWBUF_SIZE)
+        printtup_flush_rows(my_state);
+}
+
+static void printtup_flush_rows(DR_printtup* my_state)
+{
+    StringInfo rowbuf = &my_state->rowbuf;
+
+    if (rowbuf->data == NULL || rowbuf->len == 0)
+        return;
+
+    /* no need to complain about any failure, since pqcomm.c already did */
+    (void)pq_putmessages(rowbuf->data, rowbuf->len);
+    resetStringInfo(rowbuf);
+}
+
+/*
+ * Columnar results
+ *
+ * A client that negotiated _pq_.columnar_result in its startup packet (which
+ * turns on enable_columnar_result) and asked for binary format for every
+ * column gets the result of a vectorized plan as
+ * ColumnarData ('Y') messages, one per batch, instead of DataRow messages:
+ *
+ *		int16	number of columns
+ *		int32	number of rows
+ *		for each column:
+ *			int32	value width, or -1 if every value carries an int32 length
+ *			byte[]	null bitmap, (rows + 7) / 8 bytes, bit (row % 8) of byte
+ *					(row / 8) is set if the value is NULL
+ *			values	the binary send representation of each non-null value,
+ *					in row order
+ *
+ * The values are exactly what DataRow would have carried; only the layout
+ * is transposed.
+ */
+bool printtupCanSendColumns(DestReceiver* self, TupleDesc typeinfo)
+{
+    DR_printtup* my_state = (DR_printtup*)self;
+    int16* formats = NULL;
+
+    if (!u_sess->attr.attr_sql.enable_columnar_result)
+        return false;
+    if (self->mydest != DestRemote && self->mydest != DestRemoteExecute)
+        return false;
+    /* protocol 3.0 only, and never for stream or coordinator connections */
+    if (self->receiveSlot != printtup || IsConnFromCoord())
+        return false;
+
+    formats = (my_state->portal != NULL) ? my_state->portal->formats : my_state->formats;
+    if (formats == NULL || typeinfo->natts <= 0)
+        return false;
+    for (int i = 0; i < typeinfo->natts; i++) {
+        if (formats[i] != 1 || typeinfo->attrs[i]->attisdropped)
+            return false;
+    }
+    return true;
+}
+
+/* Width of the binary send representation of typid, or -1 if it varies */
+static int printtup_column_width(Oid typid)
+{
+    switch (typid) {
+        case BOOLOID:
+        case CHAROID:
+            return 1;
+        case INT2OID:
+            return 2;
+        case INT4OID:
+        case OIDOID:
+        case FLOAT4OID:
+        case DATEOID:
+            return 4;
+        case INT8OID:
+        case FLOAT8OID:
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+        case TIMEOID:
+            return 8;
+        default:
+            return -1;
+    }
+}
+
+/* Same bytes as the type's send function, without calling it */
+static void printtup_send_fixed(StringInfo buf, Oid typid, Datum attr)
+{
+    switch (typid) {
+        case BOOLOID:
+            pq_sendbyte(buf, DatumGetBool(attr) ? 1 : 0);
+            break;
+        case CHAROID:
+            pq_sendbyte(buf, DatumGetChar(attr));
+            break;
+        case INT2OID:
+            pq_sendint16(buf, DatumGetInt16(attr));
+            break;
+        case INT4OID:
+        case DATEOID:
+            pq_sendint32(buf, DatumGetInt32(attr));
+            break;
+        case OIDOID:
+            pq_sendint32(buf, DatumGetObjectId(attr));
+            break;
+        case FLOAT4OID:
+            pq_sendfloat4(buf, DatumGetFloat4(attr));
+            break;
+        case FLOAT8OID:
+            pq_sendfloat8(buf, DatumGetFloat8(attr));
+            break;
+#ifdef HAVE_INT64_TIMESTAMP
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+        case TIMEOID:
+            pq_sendint64(buf, DatumGetInt64(attr));
+            break;
+#else
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+        case TIMEOID:
+            pq_sendfloat8(buf, DatumGetFloat8(attr));
+            break;
+#endif
+        default:
+            Assert(false);
+            break;
+    }
+}
+
+void printtupColumns(DestReceiver* self, TupleDesc typeinfo, const Datum* values, const bool* isnull, int nrows)
+{
+    DR_printtup* my_state = (DR_printtup*)self;
+    StringInfo buf = &my_state->buf;
+    int natts = typeinfo->natts;
+
+    /* Set or update my derived attribute info, if needed */
+    if (my_state->attrinfo != typeinfo || my_state->nattrs != natts)
+        printtup_prepare_info(my_state, typeinfo, natts);
+
+    pq_beginmessage_reuse(buf, 'Y');
+    pq_sendint16(buf, natts);
+    pq_sendint32(buf, nrows);
+
+    for (int i = 0; i < natts; i++) {
+        PrinttupAttrInfo* this_state = my_state->myinfo + i;
+        Oid typid = typeinfo->attrs[i]->atttypid;
+        int width = printtup_column_width(typid);
+        uint8 nullbits = 0;
+
+        pq_sendint32(buf, width);
+
+        for (int j = 0; j < nrows; j++) {
+            if (isnull[j * natts + i])
+                nullbits |= (uint8)(1 << (j % 8));
+            if (j % 8 == 7 || j == nrows - 1) {
+                pq_sendbyte(buf, nullbits);
+                nullbits = 0;
+            }
+        }
+
+        for (int j = 0; j < nrows; j++) {
+            Datum origattr = values[j * natts + i];
+            Datum attr;
+            bytea* outputbytes = NULL;
+
+            if (isnull[j * natts + i])
+                continue;
+
+            if (width > 0) {
+                printtup_send_fixed(buf, typid, origattr);
+                continue;
+            }
+
+            /* As in printtup(), detoast here to avoid leaking in the send function */
+            if (this_state->typisvarlena)
+                attr = PointerGetDatum(PG_DETOAST_DATUM(origattr));
+            else
+                attr = origattr;
+
+            outputbytes = SendFunctionCall(&this_state->finfo, attr);
+            pq_sendint32(buf, VARSIZE(outputbytes) - VARHDRSZ);
+            pq_sendbytes(buf, VARDATA(outputbytes), VARSIZE(outputbytes) - VARHDRSZ);
+            pfree(outputbytes);
+
+            if (DatumGetPointer(attr) != DatumGetPointer(origattr))
+                pfree(DatumGetPointer(attr));
+        }
+    }
+
+    printtup_putrow(my_state, buf);
 }
 
 /* ----------------
@@ -1140,6 +1365,14 @@ static void printtup_shutdown(DestReceiver* self)
 {
     DR_printtup* my_state = (DR_printtup*)self;
 
+    printtup_flush_rows(my_state);
+    pq_unregister_pending_rows(&my_state->rowbuf);
+    if (my_state->rowbuf.data != NULL) {
+        /* startup allocates it anew for every batch a portal runs */
+        pfree(my_state->rowbuf.data);
+        my_state->rowbuf.data = NULL;
+    }
+
     if (my_state->myinfo != NULL)
         pfree(my_state->myinfo);
     my_state->myinfo = NULL;
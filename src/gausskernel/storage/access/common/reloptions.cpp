@@ -21,6 +21,7 @@
 #include "access/nbtree.h"
 #include "access/reloptions.h"
 #include "access/spgist.h"
+#include "access/tuptoaster.h"
 #include "catalog/pg_ts_parser.h"
 #include "catalog/pg_type.h"
 #include "commands/defrem.h"
@@ -64,6 +65,7 @@ static void ValidateStrOptSpcAddress(const char* val);
 static void ValidateStrOptSpcCfgPath(const char* val);
 static void ValidateStrOptSpcStorePath(const char* val);
 static void check_append_mode(const char* val);
+static void ValidateStrOptToastCompression(const char* val);
 
 static relopt_bool boolRelOpts[] = {
     {{"autovacuum_enabled", "Enables autovacuum in this relation", RELOPT_KIND_HEAP | RELOPT_KIND_TOAST}, true},
@@ -355,6 +357,13 @@ static relopt_string string_rel_opts[] = {
         NULL,
         "",
     },
+    {
+        {"toast_compression", "Compression method for new TOAST values of this column", RELOPT_KIND_ATTRIBUTE},
+        0,
+        true,
+        ValidateStrOptToastCompression,
+        "",
+    },
     /* list terminator */
     {{NULL}}};
 
@@ -1596,7 +1605,8 @@ bytea* attribute_reloptions(Datum reloptions, bool validate)
     AttributeOpts* aopts = NULL;
     int numoptions;
     static const relopt_parse_elt tab[] = {{"n_distinct", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct)},
-        {"n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited)}};
+        {"n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited)},
+        {"toast_compression", RELOPT_TYPE_STRING, offsetof(AttributeOpts, toast_compression)}};
 
     options = parseRelOptions(reloptions, validate, RELOPT_KIND_ATTRIBUTE, &numoptions);
 
@@ -1772,6 +1782,18 @@ static void ValidateStrOptCompression(const char* val)
                           "\"lz4\" for dfs table.")));
 }
 
+/*
+ * Brief        : Check the toast_compression option for a column.
+ * Input        : val, the compression method name.
+ * Output       : None.
+ * Return Value : None.
+ * Notes        : None.
+ */
+static void ValidateStrOptToastCompression(const char* val)
+{
+    (void)toast_compression_method_from_name(val);
+}
+
 /*
  * Brief        : Check the filesystem option for tablespace.
  * Input        : val, the filesystem option value.
@@ -28,6 +28,7 @@
 #include "knl/knl_variable.h"
 
 #include "csv_parser.h"
+#include "bulkload/simd_scan.h"
 #include "mb/pg_wchar.h"
 
 namespace dfs {
@@ -144,6 +145,14 @@ ParserResult CsvParserImpl::splitLine(LineBuffer *line_buf)
     bool need_data = false;
     char cur_char;
     char *temp_buffer_pos = NULL;
+    SimdScanSet scan_set;
+
+    /* bytes that can change the line state, everything else is skipped in bulk */
+    SimdScanSetInit(&scan_set);
+    SimdScanSetAdd(&scan_set, '\r');
+    SimdScanSetAdd(&scan_set, '\n');
+    SimdScanSetAdd(&scan_set, m_options->quote);
+    SimdScanSetAdd(&scan_set, m_options->escape);
 
     /* the distance of the m_buffer_pos and  temp_buffer_pos will be one line data length.
      *
@@ -232,7 +241,17 @@ ParserResult CsvParserImpl::splitLine(LineBuffer *line_buf)
                 }
             }
         } else {
-            temp_buffer_pos++;
+            /*
+             * Move to the next structural byte, but never past the last byte
+             * of the buffer so that the refill branch above still sees it.
+             */
+            char *last = m_buffer + m_buffer_len - 1;
+            size_t skip = SimdScanFind(&scan_set, temp_buffer_pos + 1, last - (temp_buffer_pos + 1));
+
+            if (skip > 0) {
+                prev_char_is_escape = false;
+            }
+            temp_buffer_pos += skip + 1;
         }
     }
 
@@ -28,16 +28,15 @@
 #include "knl/knl_variable.h"
 
 #include "text_parser.h"
+#include "bulkload/simd_scan.h"
 #include "mb/pg_wchar.h"
 
-#define TEXT_SEARCH_CHUNK_SZ 128
-
 #define ISOCTAL(c) (((c) >= '0') && ((c) <= '7'))
 #define OCTVALUE(c) ((c) - '0')
 
 namespace dfs {
 /*
- * @Description: using memchr find eol from s  to len ,  allow '\0' in string buffer
+ * @Description: find eol from s to len with the vectorized scanner, allow '\0' in string buffer
  * @IN s: string buffer pointer
  * @IN len: string len
  * @Return: eol postion or NULL from not found
@@ -45,25 +44,14 @@ namespace dfs {
  */
 static inline char *FindEolChar(char *s, size_t len)
 {
-    char *end = NULL;
-    char *cr = NULL;
-    char *lf = NULL;
-    end = s + len;
-    while (s < end) {
-        size_t chunk = (s + TEXT_SEARCH_CHUNK_SZ < end) ? TEXT_SEARCH_CHUNK_SZ : (end - s);
-        cr = (char *)memchr(s, '\r', chunk);
-        lf = (char *)memchr(s, '\n', chunk);
-        if (cr != NULL) {
-            if (lf != NULL && lf < cr) {
-                return lf;
-            }
-            return cr;
-        } else if (lf != NULL) {
-            return lf;
-        }
-        s += TEXT_SEARCH_CHUNK_SZ;
-    }
-    return NULL;
+    SimdScanSet eol_set;
+    size_t pos;
+
+    SimdScanSetInit(&eol_set);
+    SimdScanSetAdd(&eol_set, '\r');
+    SimdScanSetAdd(&eol_set, '\n');
+    pos = SimdScanFind(&eol_set, s, len);
+    return (pos < len) ? (s + pos) : NULL;
 }
 
 TextParserImpl::~TextParserImpl()
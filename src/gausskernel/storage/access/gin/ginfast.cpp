@@ -58,15 +58,15 @@ static int32 writeListPage(Relation index, Buffer buffer, IndexTuple* tuples, in
     errno_t ret = EOK;
 
     /* workspace could be a local array; we use palloc for alignment */
-    ADIO_RUN()
+    DIO_RUN()
     {
         workspace = (char*)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         workspace = (char*)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     START_CRIT_SECTION();
 
@@ -135,16 +135,16 @@ static int32 writeListPage(Relation index, Buffer buffer, IndexTuple* tuples, in
 
     END_CRIT_SECTION();
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(workspace);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree(workspace);
         workspace = NULL;
     }
-    ADIO_END();
+    DIO_END();
 
     return freesize;
 }
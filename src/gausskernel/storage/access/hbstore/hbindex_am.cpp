@@ -67,7 +67,7 @@ HBktIdxScanDesc hbkt_idx_beginscan(Relation heap_relation,
     BucketInfo* bucket_info = ((Scan*)(scan_state->ps.plan))->bucketInfo;
 
     /* Step 1: load bucket */
-    bucket_list = hbkt_load_buckets(heap_relation, bucket_info);
+    bucket_list = hbkt_load_buckets(heap_relation, bucket_info, scan_state);
     if (bucket_list == NIL) {
         return NULL;
     }
@@ -137,10 +137,17 @@ void hbkt_idx_rescan(AbsIdxScanDesc scan, ScanKey keys, int nkeys,
     Assert(hp_scan);
     Assert(scan->type == T_ScanDesc_HBucketIndex);
 
+    (void)hbkt_reload_pruned_buckets(hp_scan->rs_rd, hp_scan->scanState, &hp_scan->hBktList);
+    hp_scan->curr_slot = 0;
+    if (hp_scan->hBktList == NIL) {
+        /* no bucket holds the new key value; keep the old bucket open for endscan */
+        index_rescan(hp_scan->currBktIdxScan, keys, nkeys, orderbys, norderbys);
+        return;
+    }
+
     Snapshot snapshot = hp_scan->currBktIdxScan->xs_snapshot;
     free_hbucket_idxscan(hp_scan->currBktIdxScan, hp_scan->currBktHeapRel, hp_scan->currBktIdxRel);
 
-    hp_scan->curr_slot = 0;
     int2 bucketid = list_nth_int(hp_scan->hBktList, hp_scan->curr_slot);	
     hp_scan->currBktHeapRel = bucketGetRelation(hp_scan->rs_rd,  NULL, bucketid);
     hp_scan->currBktIdxRel  = bucketGetRelation(hp_scan->idx_rd, NULL, bucketid);
@@ -260,6 +267,11 @@ ItemPointer hbkt_idx_getnext_tid(AbsIdxScanDesc scan, ScanDirection direction)
 
     Assert(scan->type == T_ScanDesc_HBucketIndex);
 
+    /* no bucket holds the key value */
+    if (hp_scan->curr_slot >= list_length(hp_scan->hBktList)) {
+        return NULL;
+    }
+
     ItemPointer tidptr = index_getnext_tid(hp_scan->currBktIdxScan, direction);
     if (tidptr != NULL) {
         return tidptr;
@@ -31,7 +31,10 @@
 #include "executor/executor.h"
 #include "knl/knl_session.h"
 #include "nodes/execnodes.h"
+#include "nodes/nodeFuncs.h"
 #include "nodes/plannodes.h"
+#include "optimizer/bucketpruning.h"
+#include "optimizer/var.h"
 #include "utils/memutils.h"
 #include "utils/tqual.h"
 #include "utils/syscache.h"
@@ -49,11 +52,56 @@ const TableAm g_HBucketTblAm = {
     .table_init_parallel_seqscan = hbkt_tbl_init_parallel_seqscan
 };
 
-List* hbkt_load_buckets(Relation relation, BucketInfo* bkt_info)
+/*
+ * The bucket that the run-time value of the bucket key selects (see
+ * BucketInfo.pruningExpr), or -1 if there is no such value or it cannot be
+ * evaluated yet.  Nestloop and initplan params are only set by the time the
+ * scan is rescanned, so at the start of the scan only external params count.
+ */
+static int hbkt_runtime_bucket(BucketInfo* bkt_info, ScanState* state, bool rescan)
+{
+    ExprContext* econtext = NULL;
+    ExprState* expr_state = NULL;
+    MemoryContext old_context;
+    Datum value;
+    bool isnull = false;
+    int bucketid;
+
+    if (bkt_info == NULL || bkt_info->pruningExpr == NULL || state == NULL ||
+        (econtext = state->ps.ps_ExprContext) == NULL) {
+        return -1;
+    }
+
+    if (!rescan && check_param_clause((Node*)bkt_info->pruningExpr)) {
+        return -1;
+    }
+
+    /* the expression state is thrown away with the per-tuple memory */
+    old_context = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+    expr_state = ExecInitExpr(bkt_info->pruningExpr, NULL);
+    value = ExecEvalExpr(expr_state, econtext, &isnull, NULL);
+    bucketid = GetBucketIdByValue(exprType((Node*)bkt_info->pruningExpr), value, isnull);
+    (void)MemoryContextSwitchTo(old_context);
+    ResetExprContext(econtext);
+
+    return bucketid;
+}
+
+List* hbkt_load_buckets(Relation relation, BucketInfo* bkt_info, ScanState* state, bool rescan)
 {
     ListCell *bkt_id_cell = NULL;
     List    *bucket_list = NIL;
 	oidvector *blist = searchHashBucketByOid(relation->rd_bucketoid);
+    int pruned_bkt_id = hbkt_runtime_bucket(bkt_info, state, rescan);
+
+    if (pruned_bkt_id >= 0) {
+        /* only rows stored in this bucket can equal the value */
+        Assert(bkt_info->buckets == NIL);
+        if (lookupHBucketid(blist, 0, pruned_bkt_id) == -1) {
+            return NIL;
+        }
+        return list_make1_int(pruned_bkt_id);
+    }
 
     if (bkt_info == NULL || bkt_info->buckets == NIL) {
 		// load all buckets
@@ -79,6 +127,24 @@ List* hbkt_load_buckets(Relation relation, BucketInfo* bkt_info)
     return bucket_list;
 }
 
+/*
+ * On rescan, reload the bucket list of a scan that depends on the run-time
+ * value of the bucket key, which may have changed.  Returns false, leaving
+ * the list alone, if the scan has no such value.
+ */
+bool hbkt_reload_pruned_buckets(Relation relation, ScanState* state, List** bucket_list)
+{
+    BucketInfo* bkt_info = (state != NULL) ? ((Scan*)state->ps.plan)->bucketInfo : NULL;
+
+    if (bkt_info == NULL || bkt_info->pruningExpr == NULL) {
+        return false;
+    }
+
+    list_free_ext(*bucket_list);
+    *bucket_list = hbkt_load_buckets(relation, bkt_info, state, true);
+    return true;
+}
+
 static inline void free_hbucket_scan(HeapScanDesc bkt_scan, Relation bkt_rel)
 {
     Assert(bkt_rel != NULL);
@@ -97,7 +163,7 @@ static HBktTblScanDesc hbkt_tbl_create_scan(Relation relation, ScanState* state)
     }
 
     /* Step 1: load bucket */
-    bucket_list = hbkt_load_buckets(relation, bkt_info);
+    bucket_list = hbkt_load_buckets(relation, bkt_info, state);
     if (bucket_list == NIL) {
         return NULL;
     }
@@ -239,9 +305,16 @@ void hbkt_tbl_rescan(AbsTblScanDesc scan, ScanKey key)
     Snapshot snapshot = hp_scan->currBktScan->rs_snapshot;
     int nkeys = hp_scan->currBktScan->rs_nkeys;
 
+    (void)hbkt_reload_pruned_buckets(hp_scan->rs_rd, hp_scan->scanState, &hp_scan->hBktList);
+    hp_scan->curr_slot = 0;
+    if (hp_scan->hBktList == NIL) {
+        /* no bucket holds the new key value; keep the old bucket open for endscan */
+        heap_rescan(hp_scan->currBktScan, key);
+        return;
+    }
+
     free_hbucket_scan(hp_scan->currBktScan, hp_scan->currBktRel);
 
-    hp_scan->curr_slot = 0;
     int2 bucketid = list_nth_int(hp_scan->hBktList, hp_scan->curr_slot);		
     hp_scan->currBktRel = bucketGetRelation(hp_scan->rs_rd,  NULL, bucketid);
 
@@ -250,15 +323,41 @@ void hbkt_tbl_rescan(AbsTblScanDesc scan, ScanKey key)
     heap_rescan(hp_scan->currBktScan, key);
 }
 
-static inline void try_init_bucket_parallel(HeapScanDesc next_bkt_scan, ScanState* sstate)
+static inline void try_init_bucket_parallel(HBktTblScanDesc hp_scan, HeapScanDesc next_bkt_scan)
 {
+    ScanState* sstate = hp_scan->scanState;
+
     if (sstate != NULL && *(NodeTag*)sstate == T_SeqScanState) {
-        heap_init_parallel_seqscan(next_bkt_scan,
-            sstate->ps.plan->dop, sstate->partScanDirection);
+        /* when the threads split the buckets, each one reads its buckets whole */
+        if (hp_scan->bktDop == 0) {
+            heap_init_parallel_seqscan(next_bkt_scan,
+                sstate->ps.plan->dop, sstate->partScanDirection);
+        }
         next_bkt_scan->rs_ss_accessor = sstate->ss_scanaccessor;
     }
 }
 
+/*
+ * The first slot from slot on whose bucket this SMP thread scans, or
+ * list_length(hBktList) if there is none.
+ */
+static int hbkt_next_slot(HBktTblScanDesc hp_scan, int slot)
+{
+    int nbuckets = list_length(hp_scan->hBktList);
+
+    if (hp_scan->bktDop <= 1) {
+        return slot;
+    }
+
+    for (; slot < nbuckets; slot++) {
+        int bucketid = list_nth_int(hp_scan->hBktList, slot);
+        if ((uint32)(bucketid % hp_scan->bktDop) == u_sess->stream_cxt.smp_id) {
+            break;
+        }
+    }
+    return slot;
+}
+
 /*
  * If the scan of current bucket is finished, we continue to switch and scan
  * the next non-empty bucket
@@ -272,12 +371,13 @@ static HeapTuple switch_and_scan_next_tbl_hbkt(HBktTblScanDesc hp_scan, ScanDire
 
     for (;;) {
         /* Step 1. To check whether all bucket have been scanned. */
-        if (hp_scan->curr_slot + 1 >= list_length(hp_scan->hBktList)) {
+        int next_slot = hbkt_next_slot(hp_scan, hp_scan->curr_slot + 1);
+        if (next_slot >= list_length(hp_scan->hBktList)) {
             return NULL;
         }
 
         /* Step 2. Get the next bucket and its relation */
-        hp_scan->curr_slot++;
+        hp_scan->curr_slot = next_slot;
         int2 bucketid = list_nth_int(hp_scan->hBktList, hp_scan->curr_slot);
         next_bkt_rel = bucketGetRelation(hp_scan->rs_rd,  NULL, bucketid);
 
@@ -287,7 +387,7 @@ static HeapTuple switch_and_scan_next_tbl_hbkt(HBktTblScanDesc hp_scan, ScanDire
             curr_bkt_scan->rs_nkeys, curr_bkt_scan->rs_key,
             curr_bkt_scan->rs_isRangeScanInRedis);
 
-        try_init_bucket_parallel(next_bkt_scan, hp_scan->scanState);
+        try_init_bucket_parallel(hp_scan, next_bkt_scan);
 
         /* Step 4. Fetch a tuple from the next bucket, if no tuple is 
 		 * in this bucket, then release the handles and continue to scan 
@@ -316,6 +416,11 @@ HeapTuple hbkt_tbl_getnext(AbsTblScanDesc scan, ScanDirection direction)
 
     Assert(scan->type == T_ScanDesc_HBucket);
 
+    /* no bucket left for this thread, or none holds the key value */
+    if (hp_scan->curr_slot >= list_length(hp_scan->hBktList)) {
+        return NULL;
+    }
+
     HeapTuple htup = heap_getnext(hp_scan->currBktScan, direction);
     if (htup != NULL) {
         return htup;
@@ -351,8 +456,7 @@ bool hbkt_sampling_scan_nextbucket(HBktTblScanDesc hp_scan)
         curr_bkt_scan->rs_isRangeScanInRedis);
 
     /* Step 4. Set the parallel scan parameter */
-    ScanState* sstate = hp_scan->scanState;
-    try_init_bucket_parallel(next_bkt_scan, sstate);
+    try_init_bucket_parallel(hp_scan, next_bkt_scan);
 
     /* Step 5. If the next bucket has tuples, then we switch the old scan 
 		* to next */
@@ -424,7 +528,44 @@ void hbkt_tbl_init_parallel_seqscan(AbsTblScanDesc scan, int32 dop, ScanDirectio
 
     Assert(scan->type == T_ScanDesc_HBucket);
 
-    heap_init_parallel_seqscan(hp_scan->currBktScan, dop, dir);
+    /*
+     * With at least as many buckets as threads, each thread scans whole
+     * buckets, chosen by bucket id, instead of every thread reading a share
+     * of the blocks of every bucket.  The bucket id rather than the slot
+     * decides, so that all threads agree however the list was pruned.
+     * Sampling scans move through the buckets on their own and keep the
+     * block split.
+     */
+    if (dop <= 1 || list_length(hp_scan->hBktList) < dop || hp_scan->scanState == NULL ||
+        ((SeqScanState*)hp_scan->scanState)->isSampleScan) {
+        hp_scan->bktDop = 0;
+        heap_init_parallel_seqscan(hp_scan->currBktScan, dop, dir);
+        return;
+    }
+
+    hp_scan->bktDop = dop;
+    int slot = hbkt_next_slot(hp_scan, hp_scan->curr_slot);
+    if (slot >= list_length(hp_scan->hBktList)) {
+        /* nothing to scan here; the current bucket stays open for endscan */
+        hp_scan->curr_slot = slot;
+        return;
+    }
+
+    if (slot != hp_scan->curr_slot) {
+        HeapScanDesc curr_bkt_scan = hp_scan->currBktScan;
+        int2 bucketid = list_nth_int(hp_scan->hBktList, slot);
+        Relation next_bkt_rel = bucketGetRelation(hp_scan->rs_rd, NULL, bucketid);
+
+        (void)reset_scan_qual(next_bkt_rel, hp_scan->scanState);
+        HeapScanDesc next_bkt_scan = heap_beginscan(next_bkt_rel, curr_bkt_scan->rs_snapshot,
+            curr_bkt_scan->rs_nkeys, curr_bkt_scan->rs_key, curr_bkt_scan->rs_isRangeScanInRedis);
+        free_hbucket_scan(curr_bkt_scan, hp_scan->currBktRel);
+
+        hp_scan->curr_slot = slot;
+        hp_scan->currBktRel = next_bkt_rel;
+        hp_scan->currBktScan = next_bkt_scan;
+    }
+    try_init_bucket_parallel(hp_scan, hp_scan->currBktScan);
 }
 
 /*
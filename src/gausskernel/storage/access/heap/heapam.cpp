@@ -59,6 +59,7 @@
 #include "catalog/namespace.h"
 #include "catalog/pg_proc.h"
 #include "commands/dbcommands.h"
+#include "commands/tablespace.h"
 #include "commands/verify.h"
 #include "executor/nodeModifyTable.h"
 #include "miscadmin.h"
@@ -73,6 +74,7 @@
 #include "storage/procarray.h"
 #include "storage/smgr.h"
 #include "storage/standby.h"
+#include "utils/aiomem.h"
 #include "utils/datum.h"
 #include "utils/inval.h"
 #include "utils/lsyscache.h"
@@ -220,6 +222,7 @@ static void initscan(HeapScanDesc scan, ScanKey key, bool is_rescan)
     ItemPointerSetInvalid(&scan->rs_ctup.t_self);
     scan->rs_cbuf = InvalidBuffer;
     scan->rs_cblock = InvalidBlockNumber;
+    scan->rs_readahead_end = 0;
     scan->rs_ss_accessor = NULL;
     scan->dop = 1;
 
@@ -246,6 +249,72 @@ static void initscan(HeapScanDesc scan, ScanKey key, bool is_rescan)
     }
 }
 
+/*
+ * heap_direct_read_ahead - read ahead of a forward scan when direct I/O is on
+ *
+ * Data files opened with O_DIRECT get no read-ahead from the kernel, so a
+ * sequential scan would wait for every page separately.  Instead, each time
+ * the scan gets within half a window of the end of what it read ahead last,
+ * read the next direct_io_read_ahead blocks into shared buffers.  Scans
+ * joined by the synchronized scan logic move through the table together, so
+ * whichever of them is in front reads ahead for the others, who find the
+ * pages already cached.  The pages go into the scan's own buffer ring, so
+ * the window is at most the ring size.  The adio prefetcher does the same job
+ * when it is enabled.
+ */
+static void heap_direct_read_ahead(HeapScanDesc scan, BlockNumber page)
+{
+    int window = u_sess->attr.attr_storage.direct_io_read_ahead;
+    BlockNumber start;
+    BlockNumber end;
+
+    if (!g_instance.attr.attr_storage.enable_direct_io || g_instance.attr.attr_storage.enable_adio_function ||
+        window <= 0) {
+        return;
+    }
+    if (scan->rs_bitmapscan || scan->rs_samplescan || scan->rs_isRangeScanInRedis) {
+        return;
+    }
+
+    /* read-ahead beyond the scan's buffer ring would evict itself before use */
+    if (scan->rs_strategy != NULL) {
+        window = Min(window, scan->rs_strategy->ring_size);
+    }
+
+    /* only moving forward; a synchronized scan wraps around to block 0 */
+    if (scan->rs_cblock != InvalidBlockNumber && page <= scan->rs_cblock) {
+        if (page != 0 || scan->rs_cblock != scan->rs_nblocks - 1) {
+            return;
+        }
+        scan->rs_readahead_end = 0;
+    }
+
+    /* still well inside what was read ahead last time */
+    if (page < scan->rs_readahead_end && scan->rs_readahead_end - page > (BlockNumber)(window / 2)) {
+        return;
+    }
+
+    start = Max(page, scan->rs_readahead_end);
+    end = Min(page + (BlockNumber)window, scan->rs_nblocks);
+
+    /* after wrapping around, stop where the scan started */
+    if (page < scan->rs_startblock) {
+        end = Min(end, scan->rs_startblock);
+    }
+
+    /* a parallel worker only reads its own stripe of PARALLEL_SCAN_GAP blocks */
+    if (scan->dop > 1 && page >= scan->rs_startblock) {
+        end = Min(end, page - (page - scan->rs_startblock) % PARALLEL_SCAN_GAP + PARALLEL_SCAN_GAP);
+    }
+
+    if (start >= end) {
+        return;
+    }
+
+    scan->rs_readahead_end = end;
+    PageRangeReadAhead(scan->rs_rd, MAIN_FORKNUM, start, (int32)(end - start), scan->rs_strategy);
+}
+
 /*
  * heapgetpage - subroutine for heapgettup()
  *
@@ -285,6 +354,8 @@ void heapgetpage(HeapScanDesc scan, BlockNumber page)
      */
     CHECK_FOR_INTERRUPTS();
 
+    heap_direct_read_ahead(scan, page);
+
     /* read page using selected strategy */
     scan->rs_cbuf = ReadBufferExtended(scan->rs_rd, MAIN_FORKNUM, page, RBM_NORMAL, scan->rs_strategy);
     scan->rs_cblock = page;
@@ -3579,6 +3650,157 @@ int heap_multi_insert(Relation relation, Relation parent, HeapTuple* tuples, int
     return ndone;
 }
 
+/*
+ *	heap_begin_direct_load - prepare to load tuples bypassing shared buffers
+ *
+ * Direct-path load builds heap pages in backend-private memory and appends
+ * them to the relation with smgrextend(), skipping the buffer manager,
+ * the FSM and per-tuple WAL.  This is only safe when nobody else can see
+ * the relation's storage: the caller must guarantee that the relfilenode was
+ * created in the current transaction and is still empty, that there are no
+ * indexes to maintain while loading, and that no logical decoding or
+ * data replication needs per-tuple records.  If the transaction aborts the
+ * new relfilenode is simply dropped.
+ */
+HeapDirectLoad heap_begin_direct_load(Relation relation, CommandId cid, int options)
+{
+    HeapDirectLoad state = (HeapDirectLoad)palloc0(sizeof(HeapDirectLoadData));
+
+    Assert(!RELATION_IS_PARTITIONED(relation) && !RelationIsBucket(relation));
+
+    state->rel = relation;
+    state->cid = cid;
+    state->options = options | HEAP_INSERT_SKIP_FSM;
+    state->use_wal = !(options & HEAP_INSERT_SKIP_WAL) && RelationNeedsWAL(relation);
+    state->xid = GetCurrentTransactionId();
+    state->save_free_space = RelationGetTargetPageFreeSpace(relation, HEAP_DEFAULT_FILLFACTOR);
+    DIO_RUN()
+    {
+        state->page = (Page)adio_align_alloc(BLCKSZ);
+    }
+    DIO_ELSE()
+    {
+        state->page = (Page)palloc(BLCKSZ);
+    }
+    DIO_END();
+    state->page_valid = false;
+
+    RelationOpenSmgr(relation);
+    state->blockno = smgrnblocks(relation->rd_smgr, MAIN_FORKNUM);
+
+    return state;
+}
+
+/*
+ * Write out the page being built.  As in rewriteheap.c, the page goes to the
+ * smgr without requesting an fsync; heap_end_direct_load() syncs the whole
+ * relation once at the end.
+ */
+static void heap_direct_load_flush_page(HeapDirectLoad state)
+{
+    char* bufToWrite = NULL;
+
+    /* check tablespace size limitation when extending new file. */
+    STORAGE_SPACE_OPERATION(state->rel, BLCKSZ);
+
+    if (state->use_wal)
+        (void)log_newpage(&state->rel->rd_node, MAIN_FORKNUM, state->blockno, state->page, true);
+
+    RelationOpenSmgr(state->rel);
+
+    bufToWrite = PageDataEncryptIfNeed(state->page);
+    PageSetChecksumInplace((Page)bufToWrite, state->blockno);
+    smgrextend(state->rel->rd_smgr, MAIN_FORKNUM, state->blockno, bufToWrite, true);
+
+    state->blockno++;
+    state->page_valid = false;
+}
+
+/*
+ *	heap_direct_load_insert - add one tuple to a direct-path load
+ *
+ * The tuple's t_self is set to its final location, so the caller can use
+ * it, e.g. for AFTER triggers, once heap_end_direct_load() has returned.
+ */
+void heap_direct_load_insert(HeapDirectLoad state, HeapTuple tup)
+{
+    Relation relation = state->rel;
+    Page page = state->page;
+    HeapTuple heaptup;
+    Size len;
+    OffsetNumber offnum;
+    ItemId itemid;
+
+    heaptup = heap_prepare_insert(relation, tup, state->cid, state->options);
+
+    len = MAXALIGN(heaptup->t_len); /* be conservative */
+    if (len > MaxHeapTupleSize)
+        ereport(ERROR,
+            (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                errmsg("row is too big: size %lu, maximum size %lu",
+                    (unsigned long)len,
+                    (unsigned long)MaxHeapTupleSize)));
+
+    if (state->page_valid && len + state->save_free_space > PageGetHeapFreeSpace(page))
+        heap_direct_load_flush_page(state);
+
+    if (!state->page_valid) {
+        HeapPageHeader phdr = (HeapPageHeader)page;
+
+        PageInit(page, BLCKSZ, 0, true);
+        phdr->pd_xid_base = state->xid - FirstNormalTransactionId;
+        phdr->pd_multi_base = 0;
+        state->page_valid = true;
+    }
+
+    HeapTupleCopyBaseFromPage(heaptup, page);
+    heaptup->t_data->t_choice.t_heap.t_xmin =
+        NormalTransactionIdToShort(((HeapPageHeader)page)->pd_xid_base, state->xid);
+
+    offnum = PageAddItem(page, (Item)heaptup->t_data, heaptup->t_len, InvalidOffsetNumber, false, true);
+    if (offnum == InvalidOffsetNumber)
+        ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("failed to add tuple")));
+
+    ItemPointerSet(&heaptup->t_self, state->blockno, offnum);
+    itemid = PageGetItemId(page, offnum);
+    ((HeapTupleHeader)PageGetItem(page, itemid))->t_ctid = heaptup->t_self;
+
+    /* Copy t_self back to the caller's tuple, and release any toasted copy */
+    if (heaptup != tup) {
+        tup->t_self = heaptup->t_self;
+        heap_freetuple(heaptup);
+    }
+
+    pgstat_count_heap_insert(relation, 1);
+}
+
+/*
+ *	heap_end_direct_load - write the last page and sync the relation
+ */
+void heap_end_direct_load(HeapDirectLoad state)
+{
+    if (state->page_valid)
+        heap_direct_load_flush_page(state);
+
+    /*
+     * The pages never went through shared buffers, so a checkpoint taken
+     * during the load did not flush them: fsync even if we WAL-logged them.
+     * heap_sync() also takes care of the toast relation.
+     */
+    heap_sync(state->rel);
+
+    DIO_RUN()
+    {
+        adio_align_free(state->page);
+    }
+    DIO_ELSE()
+    {
+        pfree_ext(state->page);
+    }
+    DIO_END();
+    pfree_ext(state);
+}
+
 /*
  *	simple_heap_insert - insert a tuple
  *
@@ -296,7 +296,15 @@ RewriteState begin_heap_rewrite(
     }
     ADIO_ELSE()
     {
-        state->rs_buffer = (Page)palloc(BLCKSZ);
+        DIO_RUN()
+        {
+            state->rs_buffer = (Page)adio_align_alloc(BLCKSZ);
+        }
+        DIO_ELSE()
+        {
+            state->rs_buffer = (Page)palloc(BLCKSZ);
+        }
+        DIO_END();
     }
     ADIO_END();
 
@@ -313,17 +321,17 @@ RewriteState begin_heap_rewrite(
     state->rs_doCmprFlag = RowRelationIsCompressed(new_heap);
     if (state->rs_doCmprFlag) {
         state->rs_compressor = New(rw_cxt) PageCompress(new_heap, rw_cxt);
-        ADIO_RUN()
+        DIO_RUN()
         {
             state->rs_cmprBuffer = (Page)adio_align_alloc(BLCKSZ);
             errorno = memset_s(state->rs_cmprBuffer, BLCKSZ, 0, BLCKSZ);
             securec_check(errorno, "", "");
         }
-        ADIO_ELSE()
+        DIO_ELSE()
         {
             state->rs_cmprBuffer = (Page)palloc0(BLCKSZ);
         }
-        ADIO_END();
+        DIO_END();
         state->rs_tupBuf = (HeapTuple*)palloc(sizeof(HeapTuple) * DEFAULTBUFFEREDTUPLES);
         state->rs_nTups = 0;
         state->rs_size = 0;
@@ -438,12 +446,16 @@ void end_heap_rewrite(RewriteState state)
         heap_sync(state->rs_new_rel);
 
     logical_end_heap_rewrite(state);
-    ADIO_RUN()
+    DIO_RUN()
     {
         if (state->rs_cmprBuffer != NULL) {
             adio_align_free(state->rs_cmprBuffer);
         }
         adio_align_free(state->rs_buffer);
+    }
+    DIO_END();
+    ADIO_RUN()
+    {
         adio_align_free(state->rs_buffers_queue_ptr);
         pfree(state->rs_buffers_handler_ptr);
     }
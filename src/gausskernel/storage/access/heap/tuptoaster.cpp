@@ -35,13 +35,17 @@
 #include "access/tuptoaster.h"
 #include "access/xact.h"
 #include "catalog/catalog.h"
+#include "catalog/pg_index.h"
+#include "utils/attoptcache.h"
 #include "utils/fmgroids.h"
 #include "utils/pg_lzcompress.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
+#include "utils/syscache.h"
 #include "utils/typcache.h"
 #include "utils/tqual.h"
 #include "commands/vacuum.h"
+#include "lz4.h"
 
 #undef TOAST_DEBUG
 
@@ -50,6 +54,7 @@ static Datum toast_save_datum(Relation rel, Datum value, struct varlena* oldexte
 static bool toastid_valueid_exists(Oid toastrelid, Oid valueid, int2 bucketid);
 static struct varlena* toast_fetch_datum(struct varlena* attr);
 static struct varlena* toast_fetch_datum_slice(struct varlena* attr, int32 sliceoffset, int32 length);
+static struct varlena* toast_decompress_datum_slice(struct varlena* attr, int32 slicelength);
 
 /* ----------
  * heap_tuple_fetch_attr -
@@ -121,11 +126,9 @@ struct varlena* heap_tuple_untoast_attr(struct varlena* attr)
         attr = toast_fetch_datum(attr);
         /* If it's compressed, decompress it */
         if (VARATT_IS_COMPRESSED(attr)) {
-            PGLZ_Header* tmp = (PGLZ_Header*)attr;
+            struct varlena* tmp = attr;
 
-            attr = (struct varlena*)palloc(PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-            SET_VARSIZE(attr, PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-            pglz_decompress(tmp, VARDATA(attr));
+            attr = toast_decompress_datum(tmp);
             pfree(tmp);
         }
     } else if (VARATT_IS_EXTERNAL_INDIRECT(attr)) {
@@ -141,11 +144,7 @@ struct varlena* heap_tuple_untoast_attr(struct varlena* attr)
         /*
          * This is a compressed value inside of the main tuple
          */
-        PGLZ_Header* tmp = (PGLZ_Header*)attr;
-
-        attr = (struct varlena*)palloc(PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-        SET_VARSIZE(attr, PGLZ_RAW_SIZE(tmp) + VARHDRSZ);
-        pglz_decompress(tmp, VARDATA(attr));
+        attr = toast_decompress_datum(attr);
     } else if (VARATT_IS_SHORT(attr)) {
         /*
          * This is a short-header varlena --- convert to 4-byte header format
@@ -178,8 +177,16 @@ struct varlena* heap_tuple_untoast_attr_slice(struct varlena* attr, int32 slice_
     struct varlena* result = NULL;
     char* attrdata = NULL;
     int32 attrsize;
+    bool prefix_only = false;
     errno_t rc = EOK;
 
+    /*
+     * Only a compressed value is worth decoding just up to the end of the
+     * slice, and only if that end is known and representable.
+     */
+    prefix_only = (VARATT_IS_EXTENDED(attr) && slice_offset >= 0 && slice_length >= 0 &&
+                   (int64)slice_offset + slice_length <= PG_INT32_MAX);
+
     if (VARATT_IS_EXTERNAL_ONDISK_B(attr)) {
         struct varatt_external toast_pointer;
 
@@ -189,8 +196,26 @@ struct varlena* heap_tuple_untoast_attr_slice(struct varlena* attr, int32 slice_
         if (!VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
             return toast_fetch_datum_slice(attr, slice_offset, slice_length);
 
-        /* fetch it back (compressed marker will get set automatically) */
-        preslice = toast_fetch_datum(attr);
+        /*
+         * A pglz stream can be decoded from its head, so when the slice has
+         * a known end we only fetch the leading chunks that can possibly
+         * cover it.  The method is only known once the first chunk is in;
+         * LZ4 needs the whole block, so for it we fall back to fetching
+         * everything, and it is still only decoded as far as the slice
+         * reaches (see below).  The compressed marker gets set
+         * automatically either way.
+         */
+        if (prefix_only) {
+            int32 max_size = pglz_maximum_compressed_size(slice_offset + slice_length, toast_pointer.va_extsize);
+
+            preslice = toast_fetch_datum_slice(attr, 0, max_size);
+            if (max_size < toast_pointer.va_extsize && VARCMETHOD_4B_C(preslice) != TOAST_PGLZ_COMPRESSION_ID) {
+                pfree(preslice);
+                preslice = toast_fetch_datum(attr);
+            }
+        } else {
+            preslice = toast_fetch_datum(attr);
+        }
     } else if (VARATT_IS_EXTERNAL_INDIRECT(attr)) {
         struct varatt_indirect redirect;
         VARATT_EXTERNAL_GET_POINTER(redirect, attr);
@@ -203,14 +228,15 @@ struct varlena* heap_tuple_untoast_attr_slice(struct varlena* attr, int32 slice_
         preslice = attr;
 
     if (VARATT_IS_COMPRESSED(preslice)) {
-        PGLZ_Header* tmp = (PGLZ_Header*)preslice;
-        Size size = PGLZ_RAW_SIZE(tmp) + VARHDRSZ;
+        struct varlena* tmp = preslice;
 
-        preslice = (struct varlena*)palloc(size);
-        SET_VARSIZE(preslice, size);
-        pglz_decompress(tmp, VARDATA(preslice));
+        /* decompress no further than the end of the slice */
+        if (prefix_only)
+            preslice = toast_decompress_datum_slice(tmp, slice_offset + slice_length);
+        else
+            preslice = toast_decompress_datum(tmp);
 
-        if (tmp != (PGLZ_Header*)attr)
+        if (tmp != attr)
             pfree(tmp);
     }
 
@@ -638,7 +664,7 @@ HeapTuple toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtu
         i = biggest_attno;
         if (att[i]->attstorage == 'x') {
             old_value = toast_values[i];
-            new_value = toast_compress_datum(old_value);
+            new_value = toast_compress_datum(old_value, toast_get_compression_method(rel, i + 1));
             if (DatumGetPointer(new_value) != NULL) {
                 /* successful compression */
                 if (toast_free[i]) {
@@ -772,7 +798,7 @@ HeapTuple toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtu
          */
         i = biggest_attno;
         old_value = toast_values[i];
-        new_value = toast_compress_datum(old_value);
+        new_value = toast_compress_datum(old_value, toast_get_compression_method(rel, i + 1));
         if (DatumGetPointer(new_value) != NULL) {
             /* successful compression */
             if (toast_free[i]) {
@@ -1159,10 +1185,201 @@ Datum toast_flatten_tuple_attribute(Datum value, Oid typeId, int32 typeMod)
     return PointerGetDatum(new_data);
 }
 
+/* ----------
+ * toast_compression_method_from_name -
+ *
+ *	Map a compression method name to its ToastCompressionId
+ * ----------
+ */
+int toast_compression_method_from_name(const char* name)
+{
+    if (pg_strcasecmp(name, "pglz") == 0)
+        return TOAST_PGLZ_COMPRESSION_ID;
+    if (pg_strcasecmp(name, "lz4") == 0)
+        return TOAST_LZ4_COMPRESSION_ID;
+
+    ereport(ERROR,
+        (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+            errmsg("invalid TOAST compression method \"%s\"", name),
+            errhint("Valid methods are \"pglz\" and \"lz4\".")));
+    return TOAST_PGLZ_COMPRESSION_ID; /* keep compiler quiet */
+}
+
+/* ----------
+ * toast_get_compression_method -
+ *
+ *	The method used to compress new values of attribute attnum of rel: the
+ *	column's toast_compression option if set, else default_toast_compression.
+ *	Changing the option affects only values stored afterwards; existing
+ *	values keep the method recorded in their own header.
+ * ----------
+ */
+int toast_get_compression_method(Relation rel, int attnum)
+{
+    return toast_get_attr_compression_method(RelationGetRelid(rel), attnum);
+}
+
+/* ----------
+ * toast_get_attr_compression_method -
+ *
+ *	As toast_get_compression_method, for attribute attnum of relation relid
+ * ----------
+ */
+int toast_get_attr_compression_method(Oid relid, int attnum)
+{
+    AttributeOpts* aopts = get_attribute_options(relid, attnum);
+    int cmethod = u_sess->attr.attr_storage.default_toast_compression;
+
+    if (aopts != NULL) {
+        if (aopts->toast_compression != 0)
+            cmethod = toast_compression_method_from_name((char*)aopts + aopts->toast_compression);
+        pfree(aopts);
+    }
+
+    return cmethod;
+}
+
+/* ----------
+ * toast_get_index_compression_method -
+ *
+ *	The method used to compress a value of index attribute att in-line.
+ *	An index column that is a plain table column follows that column's
+ *	setting, so a value is compressed alike in the table and its indexes.
+ *	Expression columns, and tuple descriptors that don't belong to an
+ *	index, use default_toast_compression.
+ * ----------
+ */
+int toast_get_index_compression_method(Form_pg_attribute att)
+{
+    HeapTuple tuple;
+    int cmethod = u_sess->attr.attr_storage.default_toast_compression;
+
+    if (!OidIsValid(att->attrelid) || att->attnum <= 0)
+        return cmethod;
+
+    tuple = SearchSysCache1(INDEXRELID, ObjectIdGetDatum(att->attrelid));
+    if (HeapTupleIsValid(tuple)) {
+        Form_pg_index index = (Form_pg_index)GETSTRUCT(tuple);
+
+        if (att->attnum <= index->indnatts && index->indkey.values[att->attnum - 1] != 0)
+            cmethod = toast_get_attr_compression_method(index->indrelid, index->indkey.values[att->attnum - 1]);
+        ReleaseSysCache(tuple);
+    }
+
+    return cmethod;
+}
+
+/* ----------
+ * toast_decompress_datum -
+ *
+ *	Decompress a compressed-in-line datum into a new palloc'd plain varlena.
+ *	The method comes from the datum's own header, so values written with
+ *	different methods can be mixed freely in one column.
+ * ----------
+ */
+struct varlena* toast_decompress_datum(struct varlena* attr)
+{
+    int32 rawsize = VARRAWSIZE_4B_C(attr);
+    struct varlena* result = NULL;
+
+    Assert(VARATT_IS_COMPRESSED(attr));
+
+    result = (struct varlena*)palloc(rawsize + VARHDRSZ);
+    SET_VARSIZE(result, rawsize + VARHDRSZ);
+
+    switch (VARCMETHOD_4B_C(attr)) {
+        case TOAST_PGLZ_COMPRESSION_ID:
+            pglz_decompress((PGLZ_Header*)attr, VARDATA(result));
+            break;
+        case TOAST_LZ4_COMPRESSION_ID:
+            if (LZ4_decompress_safe(VARDATA_4B_C(attr), VARDATA(result), VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+                rawsize) != rawsize)
+                ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("compressed lz4 data is corrupt")));
+            break;
+        default:
+            ereport(ERROR,
+                (errcode(ERRCODE_DATA_CORRUPTED),
+                    errmsg("invalid compression method id %u", (uint32)VARCMETHOD_4B_C(attr))));
+    }
+
+    return result;
+}
+
+/* ----------
+ * toast_decompress_datum_slice -
+ *
+ *	Decompress only the first slicelength bytes of a compressed datum.
+ *	attr may be just the leading part of the compressed value, as fetched
+ *	by toast_fetch_datum_slice(), in which case VARSIZE(attr) tells how
+ *	much of it is present.
+ * ----------
+ */
+static struct varlena* toast_decompress_datum_slice(struct varlena* attr, int32 slicelength)
+{
+    int32 rawsize = VARRAWSIZE_4B_C(attr);
+    struct varlena* result = NULL;
+    int32 len = 0;
+
+    Assert(VARATT_IS_COMPRESSED(attr));
+
+    if (slicelength >= rawsize)
+        return toast_decompress_datum(attr);
+
+    result = (struct varlena*)palloc(slicelength + VARHDRSZ);
+
+    switch (VARCMETHOD_4B_C(attr)) {
+        case TOAST_PGLZ_COMPRESSION_ID:
+            len = pglz_decompress_prefix((PGLZ_Header*)attr, VARSIZE(attr), VARDATA(result), slicelength);
+            break;
+        case TOAST_LZ4_COMPRESSION_ID:
+            len = LZ4_decompress_safe_partial(
+                VARDATA_4B_C(attr), VARDATA(result), VARSIZE(attr) - TOAST_COMPRESS_HDRSZ, slicelength, slicelength);
+            break;
+        default:
+            ereport(ERROR,
+                (errcode(ERRCODE_DATA_CORRUPTED),
+                    errmsg("invalid compression method id %u", (uint32)VARCMETHOD_4B_C(attr))));
+    }
+
+    if (len != slicelength)
+        ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("compressed data is corrupt")));
+
+    SET_VARSIZE(result, slicelength + VARHDRSZ);
+    return result;
+}
+
+/*
+ * LZ4 flavour of toast_compress_datum.  The output buffer is sized so that
+ * LZ4 gives up as soon as the result would not save more than 2 bytes,
+ * instead of compressing everything and discarding it afterwards.
+ */
+static Datum toast_compress_datum_lz4(const char* data, int32 valsize)
+{
+    struct varlena* tmp = NULL;
+    int32 maxlen = valsize - 3 - TOAST_COMPRESS_HDRSZ;
+    int len;
+
+    if (maxlen <= 0)
+        return PointerGetDatum(NULL);
+
+    tmp = (struct varlena*)palloc(TOAST_COMPRESS_HDRSZ + maxlen);
+    len = LZ4_compress_default(data, VARDATA_4B_C(tmp), valsize, maxlen);
+    if (len <= 0) {
+        /* incompressible data */
+        pfree(tmp);
+        return PointerGetDatum(NULL);
+    }
+
+    SET_VARSIZE_COMPRESSED(tmp, len + TOAST_COMPRESS_HDRSZ);
+    SET_VARRAWSIZE_4B_C(tmp, valsize, TOAST_LZ4_COMPRESSION_ID);
+    return PointerGetDatum(tmp);
+}
+
 /* ----------
  * toast_compress_datum -
  *
- *	Create a compressed version of a varlena datum
+ *	Create a compressed version of a varlena datum using the given
+ *	ToastCompressionId
  *
  *	If we fail (ie, compressed result is actually bigger than original)
  *	then return NULL.  We must not use compressed data if it'd expand
@@ -1172,7 +1389,7 @@ Datum toast_flatten_tuple_attribute(Datum value, Oid typeId, int32 typeMod)
  *	copying them.  But we can't handle external or compressed datums.
  * ----------
  */
-Datum toast_compress_datum(Datum value)
+Datum toast_compress_datum(Datum value, int cmethod)
 {
     struct varlena* tmp = NULL;
     int32 valsize = VARSIZE_ANY_EXHDR(DatumGetPointer(value));
@@ -1182,9 +1399,15 @@ Datum toast_compress_datum(Datum value)
 
     /*
      * No point in wasting a palloc cycle if value size is out of the allowed
-     * range for compression
+     * range for compression.  LZ4 has no upper limit of its own.
      */
-    if (valsize < PGLZ_strategy_default->min_input_size || valsize > PGLZ_strategy_default->max_input_size)
+    if (valsize < PGLZ_strategy_default->min_input_size)
+        return PointerGetDatum(NULL);
+
+    if (cmethod == TOAST_LZ4_COMPRESSION_ID)
+        return toast_compress_datum_lz4(VARDATA_ANY(DatumGetPointer(value)), valsize);
+
+    if (valsize > PGLZ_strategy_default->max_input_size)
         return PointerGetDatum(NULL);
 
     tmp = (struct varlena*)palloc(PGLZ_MAX_OUTPUT(valsize));
@@ -1780,10 +2003,11 @@ static struct varlena* toast_fetch_datum_slice(struct varlena* attr, int32 slice
     VARATT_EXTERNAL_GET_POINTER_B(toast_pointer, attr, bucketid);
 
     /*
-     * It's nonsense to fetch slices of a compressed datum -- this isn't lo_*
-     * we can't return a compressed datum which is meaningful to toast later
+     * It's nonsense to fetch slices of a compressed datum unless the slice
+     * starts at the beginning: a leading part of a compressed value can
+     * still be decoded as far as it goes, anything else cannot.
      */
-    Assert(!VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer));
+    Assert(!VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer) || sliceoffset == 0);
 
     attrsize = toast_pointer.va_extsize;
     totalchunks = ((attrsize - 1) / TOAST_MAX_CHUNK_SIZE) + 1;
@@ -589,15 +589,15 @@ static void vm_extend(Relation rel, BlockNumber vm_nblocks)
     BlockNumber vm_nblocks_now;
     Page pg;
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         pg = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pg = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     PageInit(pg, BLCKSZ, 0);
 
@@ -653,17 +653,17 @@ static void vm_extend(Relation rel, BlockNumber vm_nblocks)
 
     UnlockRelationForExtension(rel, ExclusiveLock);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(pg);
         pg = NULL;
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree(pg);
         pg = NULL;
     }
-    ADIO_END();
+    DIO_END();
 }
 
 BlockNumber VisibilityMapCalTruncBlkNo(BlockNumber rel_blk_no)
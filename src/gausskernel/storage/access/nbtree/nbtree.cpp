@@ -162,15 +162,15 @@ Datum btbuildempty(PG_FUNCTION_ARGS)
     Page metapage;
 
     /* Construct metapage. */
-    ADIO_RUN()
+    DIO_RUN()
     {
         metapage = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         metapage = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     STORAGE_SPACE_OPERATION(index, BLCKSZ);
 
@@ -198,15 +198,15 @@ Datum btbuildempty(PG_FUNCTION_ARGS)
      */
     smgrimmedsync(index->rd_smgr, INIT_FORKNUM);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(metapage);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree(metapage);
     }
-    ADIO_END();
+    DIO_END();
 
     PG_RETURN_VOID();
 }
@@ -197,15 +197,15 @@ static Page _bt_blnewpage(uint32 level)
     Page page;
     BTPageOpaqueInternal opaque;
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         page = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         page = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     /* Zero the page and set up standard page header info */
     _bt_pageinit(page, BLCKSZ);
@@ -254,17 +254,17 @@ static void _bt_blwritepage(BTWriteState* wstate, Page page, BlockNumber blkno)
      */
     while (blkno > wstate->btws_pages_written) {
         if (!wstate->btws_zeropage) {
-            ADIO_RUN()
+            DIO_RUN()
             {
                 wstate->btws_zeropage = (Page)adio_align_alloc(BLCKSZ);
                 errorno = memset_s(wstate->btws_zeropage, BLCKSZ, 0, BLCKSZ);
                 securec_check_c(errorno, "", "");
             }
-            ADIO_ELSE()
+            DIO_ELSE()
             {
                 wstate->btws_zeropage = (Page)palloc0(BLCKSZ);
             }
-            ADIO_END();
+            DIO_END();
             need_free = true;
         }
 
@@ -312,7 +312,7 @@ static void _bt_blwritepage(BTWriteState* wstate, Page page, BlockNumber blkno)
         smgrwrite(wstate->index->rd_smgr, MAIN_FORKNUM, blkno, (char*)bufToWrite, true);
     }
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         if (need_free) {
             adio_align_free(wstate->btws_zeropage);
@@ -320,7 +320,7 @@ static void _bt_blwritepage(BTWriteState* wstate, Page page, BlockNumber blkno)
         }
         adio_align_free(page);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         if (need_free) {
             pfree(wstate->btws_zeropage);
@@ -329,7 +329,7 @@ static void _bt_blwritepage(BTWriteState* wstate, Page page, BlockNumber blkno)
         pfree(page);
         page = NULL;
     }
-    ADIO_END();
+    DIO_END();
 }
 
 /*
@@ -656,15 +656,15 @@ void _bt_uppershutdown(BTWriteState* wstate, BTPageState* state)
      * by filling in a valid magic number in the metapage.
      */
     // free in function _bt_blwritepage()
-    ADIO_RUN()
+    DIO_RUN()
     {
         metapage = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         metapage = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
     _bt_initmetapage(metapage, rootblkno, rootlevel);
     _bt_blwritepage(wstate, metapage, BTREE_METAPAGE);
 }
@@ -147,15 +147,15 @@ Datum spgbuildempty(PG_FUNCTION_ARGS)
     Page page;
 
     /* Construct metapage. */
-    ADIO_RUN()
+    DIO_RUN()
     {
         page = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         page = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     SpGistInitMetapage(page);
 
@@ -191,15 +191,15 @@ Datum spgbuildempty(PG_FUNCTION_ARGS)
      */
     smgrimmedsync(index->rd_smgr, INIT_FORKNUM);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(page);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree(page);
     }
-    ADIO_END();
+    DIO_END();
 
     PG_RETURN_VOID();
 }
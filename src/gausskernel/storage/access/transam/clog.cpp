@@ -637,9 +637,15 @@ CLogXidStatus CLogGetStatus(TransactionId xid, XLogRecPtr* lsn)
  * can be simultaneously in flight will be even larger.  But that will
  * apparently require more than just changing the formula, so for now we take
  * the easy way out.
+ *
+ * The count is per CLOG partition.  clog_buffers overrides the formula;
+ * anything above SLRU_BANK_SIZE is split into banks, so a larger setting
+ * does not make page lookups slower.
  */
 Size CLOGShmemBuffers(void)
 {
+    if (g_instance.attr.attr_storage.clog_buffers > 0)
+        return Max(4, g_instance.attr.attr_storage.clog_buffers);
     return Min(256, Max(4, g_instance.attr.attr_storage.NBuffers / 512));
 }
 
@@ -156,6 +156,60 @@ void CSNLogSetCommitSeqNo(TransactionId xid, int nsubxids, TransactionId* subxid
     }
 }
 
+/*
+ * CSNLogSetCommitSeqNoBatch
+ *
+ * Stamp the CSNs of a batch of committed top-level transactions that have no
+ * subtransactions, as done by the leader of a group XID clear.  Each entry
+ * is equivalent to CSNLogSetCommitSeqNo(xids[i], 0, NULL, csns[i]); entries
+ * with an invalid xid are skipped.
+ *
+ * Consecutive entries on the same CSNLOG page are stamped under a single
+ * acquisition of the page's partition lock.  Transactions that commit
+ * together almost always have xids on the same page, so a whole group
+ * usually costs one lock acquisition instead of one per member.
+ */
+void CSNLogSetCommitSeqNoBatch(int nxids, const TransactionId* xids, const CommitSeqNo* csns)
+{
+    int i = 0;
+
+    while (i < nxids) {
+        int64 pageno;
+        int slotno;
+        bool modified = false;
+
+        if (!TransactionIdIsValid(xids[i])) {
+            i++;
+            continue;
+        }
+
+        /* Let the general path deal with errors and page re-initialization */
+        if (csns[i] == InvalidCommitSeqNo || RecoveryInProgress()) {
+            CSNLogSetCommitSeqNo(xids[i], 0, NULL, csns[i]);
+            i++;
+            continue;
+        }
+
+        pageno = TransactionIdToCSNPage(xids[i]);
+
+        /* lock is acquired by SimpleLruReadPage_ReadOnly */
+        slotno = SimpleLruReadPage_ReadOnly(CsnlogCtl(pageno), pageno, xids[i]);
+        for (; i < nxids; i++) {
+            if (!TransactionIdIsValid(xids[i]))
+                continue;
+            if ((int64)TransactionIdToCSNPage(xids[i]) != pageno || csns[i] == InvalidCommitSeqNo)
+                break;
+            if (CSNLogSetCSN(CsnlogCtl(pageno), xids[i], csns[i], slotno))
+                modified = true;
+        }
+
+        if (modified)
+            CsnlogCtl(pageno)->shared->page_dirty[slotno] = true;
+
+        CSN_LWLOCK_RELEASE(pageno);
+    }
+}
+
 /**
  * @Description: Record the final state of transaction entries in the csn log for
  * 	all entries on a single page.  Atomic only on this page.
@@ -560,11 +614,13 @@ end:
 }
 
 /**
- * @Description: Number of shared CSNLOG buffers.
+ * @Description: Number of shared CSNLOG buffers of each partition, csnlog_buffers if set.
  * @return -  return the number of shared CSNLOG buffers.
  */
 Size CSNLOGShmemBuffers(void)
 {
+    if (g_instance.attr.attr_storage.csnlog_buffers > 0)
+        return Max(BATCH_SIZE, g_instance.attr.attr_storage.csnlog_buffers);
     return Min(256, Max(BATCH_SIZE, g_instance.attr.attr_storage.NBuffers / 512));
 }
 
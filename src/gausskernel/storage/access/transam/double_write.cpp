@@ -635,6 +635,7 @@ static void dw_recover_partial_write(dw_context_t* ctx)
     uint16 reading_pages;
     uint16 remain_pages;
     bool dw_file_broken = false;
+    char* unaligned_data_page = NULL;
     char* data_page = NULL;
     MemoryContext old_mem_ctx;
 
@@ -648,7 +649,9 @@ static void dw_recover_partial_write(dw_context_t* ctx)
     reading_pages = Min(GET_DW_BATCH_MAX, (DW_FILE_PAGE - ctx->file_head->start));
 
     old_mem_ctx = MemoryContextSwitchTo(ctx->mem_ctx);
-    data_page = (char*)palloc0(BLCKSZ);
+    /* data files may be opened with O_DIRECT, so read the data page into an aligned buffer */
+    unaligned_data_page = (char*)palloc0(BLCKSZ + ALIGNOF_BUFFER);
+    data_page = (char*)BUFFERALIGN(unaligned_data_page);
 
     for (;;) {
         dw_read_pages(&read_asst, reading_pages);
@@ -700,7 +703,7 @@ static void dw_recover_partial_write(dw_context_t* ctx)
         dw_recover_batch_head(ctx, curr_head);
     }
     dw_log_recover_state(ctx, LOG, "Finish", curr_head);
-    pfree(data_page);
+    pfree(unaligned_data_page);
     MemoryContextSwitchTo(old_mem_ctx);
 }
 
@@ -8,10 +8,15 @@
  * traffic will occur mostly to the latest page (and to the just-prior
  * page, soon after a page transition).  Read traffic will probably touch
  * a larger span of pages, but in any case a fairly small number of page
- * buffers should be sufficient.  So, we just search the buffers using plain
- * linear search; there's no need for a hashtable or anything fancy.
- * The management algorithm is straight LRU except that we will never swap
- * out the latest page (since we know it's going to be hit again eventually).
+ * buffers should be sufficient.
+ *
+ * Larger SLRUs are split into banks of SLRU_BANK_SIZE slots and a page is
+ * only ever cached in the bank selected by hashing its page number, which
+ * makes the bank a small set-associative cache: we search it using plain
+ * linear search, and the cost of a lookup does not grow with the number of
+ * slots.  The management algorithm is straight LRU within each bank except
+ * that we will never swap out the latest page (since we know it's going to
+ * be hit again eventually).
  *
  * We use a control LWLock to protect the shared data structures, plus
  * per-buffer LWLocks that synchronize I/O for each buffer.  The control lock
@@ -100,13 +105,38 @@ typedef struct SlruFlushData* SlruFlush;
  * gain from allowing concurrent reads of SLRU pages seems worth it.
  */
 #define SlruRecentlyUsed(shared, slotno) do { \
-    int new_lru_count = (shared)->cur_lru_count;             \
-    if (new_lru_count != (shared)->page_lru_count[slotno]) { \
-        (shared)->cur_lru_count = ++new_lru_count;           \
-        (shared)->page_lru_count[slotno] = new_lru_count;    \
-    }                                                        \
+    int bankno_ = (slotno) / (shared)->bank_size;                 \
+    int new_lru_count = (shared)->bank_cur_lru_count[bankno_];   \
+    if (new_lru_count != (shared)->page_lru_count[slotno]) {     \
+        (shared)->bank_cur_lru_count[bankno_] = ++new_lru_count; \
+        (shared)->page_lru_count[slotno] = new_lru_count;        \
+    }                                                            \
 } while (0)
 
+/*
+ * First slot of the bank that may hold pageno.  SLRUs such as CLOG are split
+ * into partitions by pageno modulo a power of two, so the page number is
+ * mixed (Fibonacci hashing) before it is reduced to a bank number.
+ */
+static inline int SlruBankStart(SlruShared shared, int64 pageno)
+{
+    uint32 bankno = 0;
+
+    if (shared->num_banks > 1)
+        bankno = (uint32)(((uint64)pageno * UINT64CONST(0x9E3779B97F4A7C15)) >> 32) % (uint32)shared->num_banks;
+    return (int)bankno * shared->bank_size;
+}
+
+/*
+ * Round a requested slot count so that it splits into whole banks.
+ */
+static int SimpleLruAdjustSlots(int nslots)
+{
+    if (nslots <= SLRU_BANK_SIZE)
+        return nslots;
+    return nslots - nslots % SLRU_BANK_SIZE;
+}
+
 static void SimpleLruZeroLSNs(SlruCtl ctl, int slotno);
 static void SlruInternalWritePage(SlruCtl ctl, int slotno, SlruFlush fdata);
 static bool SlruPhysicalReadPage(SlruCtl ctl, int64 pageno, int slotno);
@@ -117,10 +147,11 @@ static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno);
 static inline int execSimpleLruReadPageReadOnly(SlruCtl ctl, int64 pageno, TransactionId xid)
 {
     SlruShared shared = ctl->shared;
+    int bankstart = SlruBankStart(shared, pageno);
     int slotno;
 
     /* See if page is already in a buffer */
-    for (slotno = 0; slotno < shared->num_slots; slotno++) {
+    for (slotno = bankstart; slotno < bankstart + shared->bank_size; slotno++) {
         if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY &&
             shared->page_status[slotno] != SLRU_PAGE_READ_IN_PROGRESS) {
             /* See comments for SlruRecentlyUsed macro */
@@ -139,6 +170,8 @@ Size SimpleLruShmemSize(int nslots, int nlsns)
 {
     Size sz;
 
+    nslots = SimpleLruAdjustSlots(nslots);
+
     /* we assume nslots isn't so large as to risk overflow */
     sz = MAXALIGN(sizeof(SlruSharedData));
     sz += MAXALIGN(nslots * sizeof(char*));          /* page_buffer[] */
@@ -147,6 +180,7 @@ Size SimpleLruShmemSize(int nslots, int nlsns)
     sz += MAXALIGN(nslots * sizeof(int64));          /* page_number[] */
     sz += MAXALIGN(nslots * sizeof(int));            /* page_lru_count[] */
     sz += MAXALIGN(nslots * sizeof(LWLock*));        /* buffer_locks[] */
+    sz += MAXALIGN(nslots * sizeof(int));            /* bank_cur_lru_count[], at most one per slot */
 
     if (nlsns > 0)
         sz += MAXALIGN(nslots * nlsns * sizeof(XLogRecPtr)); /* group_lsn[] */
@@ -161,6 +195,7 @@ void SimpleLruInit(
     bool found = false;
     errno_t rc = EOK;
 
+    nslots = SimpleLruAdjustSlots(nslots);
     shared = (SlruShared)ShmemInitStruct(name, SimpleLruShmemSize(nslots, nlsns), &found);
 
     if (!IsUnderPostmaster) {
@@ -176,8 +211,9 @@ void SimpleLruInit(
 
         shared->control_lock = ctllock;
         shared->num_slots = nslots;
+        shared->bank_size = Min(nslots, SLRU_BANK_SIZE);
+        shared->num_banks = nslots / shared->bank_size;
         shared->lsn_groups_per_page = nlsns;
-        shared->cur_lru_count = 0;
         shared->force_check_first_xid = false;
 
         /* shared->latest_page_number will be set later */
@@ -195,6 +231,8 @@ void SimpleLruInit(
         offset += MAXALIGN(nslots * sizeof(int));
         shared->buffer_locks = (LWLock**)(ptr + offset);
         offset += MAXALIGN(nslots * sizeof(LWLock*));
+        shared->bank_cur_lru_count = (int*)(ptr + offset);
+        offset += MAXALIGN(nslots * sizeof(int));
 
         if (nlsns > 0) {
             shared->group_lsn = (XLogRecPtr*)(ptr + offset);
@@ -211,6 +249,8 @@ void SimpleLruInit(
             shared->buffer_locks[slotno] = LWLockAssign(trancheId);
             ptr += BLCKSZ;
         }
+        for (int bankno = 0; bankno < shared->num_banks; bankno++)
+            shared->bank_cur_lru_count[bankno] = 0;
     } else
         Assert(found);
 
@@ -955,6 +995,9 @@ static void SlruReportIOError(SlruCtl ctl, int64 pageno, TransactionId xid)
 static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
 {
     SlruShared shared = ctl->shared;
+    int bankstart = SlruBankStart(shared, pageno);
+    int bankend = bankstart + shared->bank_size;
+    int bankno = bankstart / shared->bank_size;
 
     /* Outer loop handles restart after I/O */
     for (;;) {
@@ -967,15 +1010,15 @@ static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
         int best_invalid_delta = -1;
         int64 best_invalid_page_number = 0; /* keep compiler quiet */
 
-        /* See if page already has a buffer assigned */
-        for (slotno = 0; slotno < shared->num_slots; slotno++) {
+        /* See if page already has a buffer assigned; it can only be in its own bank */
+        for (slotno = bankstart; slotno < bankend; slotno++) {
             if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY)
                 return slotno;
         }
 
         /*
-         * If we find any EMPTY slot, just select that one. Else choose a
-         * victim page to replace.	We normally take the least recently used
+         * If we find any EMPTY slot in the bank, just select that one. Else
+         * choose a victim page of the bank to replace.	We normally take the least recently used
          * valid page, but we will never take the slot containing
          * latest_page_number, even if it appears least recently used.	We
          * will select a slot that is already I/O busy only if there is no
@@ -992,7 +1035,7 @@ static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
          * acquire the same lru_count values.  In that case we break ties by
          * choosing the furthest-back page.
          *
-         * Notice that this next line forcibly advances cur_lru_count to a
+         * Notice that this next line forcibly advances the bank's LRU count to a
          * value that is certainly beyond any value that will be in the
          * page_lru_count array after the loop finishes.  This ensures that
          * the next execution of SlruRecentlyUsed will mark the page newly
@@ -1000,8 +1043,8 @@ static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
          * That gets us back on the path to having good data when there are
          * multiple pages with the same lru_count.
          */
-        cur_count = (shared->cur_lru_count)++;
-        for (slotno = 0; slotno < shared->num_slots; slotno++) {
+        cur_count = (shared->bank_cur_lru_count[bankno])++;
+        for (slotno = bankstart; slotno < bankend; slotno++) {
             int this_delta;
             int64 this_page_number;
 
@@ -1044,6 +1044,141 @@ void PageListPrefetchAbort()
     u_sess->storage_cxt.AsyncSubmitIOCount = 0;
 }
 
+/*
+ * @Description: Read a range of blocks of a relation fork into shared buffers
+ * ahead of a sequential scan.  With enable_direct_io the kernel no longer
+ * reads ahead for us, so the scan asks for the next blocks here instead.
+ * With enable_io_uring all the reads are started before any is waited for,
+ * so they overlap; otherwise each run of consecutive blocks not cached yet
+ * is read with a single preadv().  Blocks that are cached already, or that
+ * someone else is reading, are skipped.  A block that cannot be read or
+ * fails verification is left invalid; ReadBuffer reads it again and reports
+ * the problem there.
+ *
+ * The buffers come from the scan's strategy, so a bulk read keeps to its
+ * ring; the caller must not ask for more blocks than the ring holds, or the
+ * last ones read evict the first before the scan gets to them.
+ * @Param[IN] reln: relation
+ * @Param[IN] fork_num: fork Num
+ * @Param[IN] block_num: start block Num
+ * @Param[IN] n: block count, at most MAX_PREFETCH_REQSIZ are read
+ * @Param[IN] strategy: the scan's buffer access strategy, or NULL
+ * @See also:
+ */
+void PageRangeReadAhead(
+    Relation reln, ForkNumber fork_num, BlockNumber block_num, int32 n, BufferAccessStrategy strategy)
+{
+    SMgrAioRequest* reqs = NULL;
+    BufferDesc** bufs = NULL;
+    char** pages = NULL;
+    bool async = false;
+    volatile int nbufs = 0;    /* buffers allocated and marked IO_IN_PROGRESS */
+    volatile int nstarted = 0; /* of those, reads started */
+    volatile int ndone = 0;    /* of those, buffers released again */
+    instr_time io_start, io_time;
+
+    RelationOpenSmgr(reln);
+
+    /* no read-ahead into local buffers */
+    if (SmgrIsTemp(reln->rd_smgr) || n <= 0) {
+        return;
+    }
+
+    /* every buffer being read holds its io_in_progress lock until we are done */
+    n = Min(n, MAX_PREFETCH_REQSIZ);
+    async = FileAioIsAsync();
+
+    reqs = (SMgrAioRequest*)palloc0(sizeof(SMgrAioRequest) * n);
+    bufs = (BufferDesc**)palloc(sizeof(BufferDesc*) * n);
+    pages = (char**)palloc(sizeof(char*) * n);
+
+    PG_TRY();
+    {
+        INSTR_TIME_SET_CURRENT(io_start);
+
+        for (int i = 0; i < n; i++) {
+            BufferDesc* buf_desc = NULL;
+            bool found = false;
+
+            /* Make sure we will have room to remember the buffer pin */
+            ResourceOwnerEnlargeBuffers(t_thrd.utils_cxt.CurrentResourceOwner);
+
+            buf_desc = (BufferDesc*)PageListBufferAlloc(
+                reln->rd_smgr, reln->rd_rel->relpersistence, fork_num, block_num + i, strategy, &found);
+            if (buf_desc == NULL) {
+                continue;
+            }
+            pages[nbufs] = (char*)BufHdrGetBlock(buf_desc);
+            bufs[nbufs++] = buf_desc;
+
+            if (async) {
+                smgrstartread(reln->rd_smgr, fork_num, block_num + i, pages[nstarted], &reqs[nstarted]);
+                nstarted++;
+            }
+        }
+
+        /* read each run of consecutive blocks at once, and fill in the results as FileAioWait() would */
+        while (!async && nstarted < nbufs) {
+            int first = nstarted;
+            int run = 1;
+            int nread;
+
+            while (first + run < nbufs &&
+                   bufs[first + run]->tag.blockNum == bufs[first]->tag.blockNum + (BlockNumber)run) {
+                run++;
+            }
+
+            nread = smgrreadv(reln->rd_smgr, fork_num, bufs[first]->tag.blockNum, &pages[first], run);
+            for (int i = 0; i < run; i++) {
+                reqs[first + i].io.result = (i < nread) ? BLCKSZ : -1;
+            }
+            nstarted += run;
+        }
+
+        for (; ndone < nstarted; ndone++) {
+            BufferDesc* buf_desc = bufs[ndone];
+            Page page = (Page)pages[ndone];
+            uint32 set_flag_bits = 0;
+
+            /* smgrwaitio() would error out on a short read; leave that to ReadBuffer */
+            FileAioWait(&reqs[ndone].io);
+            if (reqs[ndone].io.result == BLCKSZ && PageIsVerified(page, buf_desc->tag.blockNum)) {
+                PageDataDecryptIfNeed(page);
+                set_flag_bits = BM_VALID;
+                u_sess->instr_cxt.pg_buffer_usage->shared_blks_read++;
+            }
+
+            AsyncTerminateBufferIO(buf_desc, false, set_flag_bits);
+            UnpinBuffer(buf_desc, true);
+        }
+
+        INSTR_TIME_SET_CURRENT(io_time);
+        INSTR_TIME_SUBTRACT(io_time, io_start);
+        if (u_sess->attr.attr_common.track_io_timing) {
+            pgstat_count_buffer_read_time(INSTR_TIME_GET_MICROSEC(io_time));
+            INSTR_TIME_ADD(u_sess->instr_cxt.pg_buffer_usage->blk_read_time, io_time);
+        }
+        pgstatCountBlocksReadTime4SessionLevel(INSTR_TIME_GET_MICROSEC(io_time));
+    }
+    PG_CATCH();
+    {
+        /* the reads still write into the buffers, so let them finish first */
+        for (int i = ndone; i < nbufs; i++) {
+            if (i < nstarted) {
+                FileAioWait(&reqs[i].io);
+            }
+            AsyncTerminateBufferIO(bufs[i], false, BM_IO_ERROR);
+            UnpinBuffer(bufs[i], true);
+        }
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    pfree(reqs);
+    pfree(bufs);
+    pfree(pages);
+}
+
 /*
  * @Description: Write sequential buffers from a database relation fork.
  * @Param[IN] bufferIdx: starting buffer index
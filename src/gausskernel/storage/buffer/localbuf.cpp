@@ -515,8 +515,12 @@ static Block GetLocalBufferStorage(void)
         /* And don't overflow MaxAllocSize, either */
         num_bufs = Min((unsigned int)(num_bufs), MaxAllocSize / BLCKSZ);
 
-        t_thrd.storage_cxt.cur_block =
-            (char*)MemoryContextAlloc(t_thrd.storage_cxt.LocalBufferContext, num_bufs * BLCKSZ);
+        /*
+         * Temp relation files are opened with O_DIRECT too when direct I/O is
+         * on, so align the block the same way shared buffers are.
+         */
+        t_thrd.storage_cxt.cur_block = (char*)BUFFERALIGN(
+            MemoryContextAlloc(t_thrd.storage_cxt.LocalBufferContext, num_bufs * BLCKSZ + ALIGNOF_BUFFER));
         t_thrd.storage_cxt.next_buf_in_block = 0;
         t_thrd.storage_cxt.num_bufs_in_block = num_bufs;
     }
@@ -31,6 +31,7 @@
 #include <string>
 
 #include "storage/gds_utils.h"
+#include "bulkload/simd_scan.h"
 
 #ifdef GDS_SERVER
 #include "parser.h"
@@ -63,7 +64,6 @@
 #define MAX_SEGMENT_NUM 2147483600
 #define SEGMENT_SIZE 2147483648
 #define FILEHEADER_BUF_SIZE (1024 * 1024)
-#define CHUNK_SZ 128
 const int GDS_HEADER_LEN = 4;
 
 using namespace std;
@@ -105,23 +105,16 @@ static void NopCleanup(Parser* self);
 
 static char* FindEolChar(char* s, size_t len, const char* eol, int* eol_cur, int* eol_cur_saved)
 {
-    char* end = NULL;
-    char* cr = NULL;
-    char* lf = NULL;
-    end = s + len;
     if (eol == NULL) {
-        while (s < end) {
-            size_t chunk = (s + CHUNK_SZ < end) ? CHUNK_SZ : (end - s);
-            cr = (char*)memchr(s, '\r', chunk);
-            lf = (char*)memchr(s, '\n', chunk);
-            if (cr != NULL) {
-                if (lf != NULL && lf < cr)
-                    return lf;
-                return cr;
-            } else if (lf != NULL)
-                return lf;
-            s += CHUNK_SZ;
-        }
+        SimdScanSet eol_set;
+        size_t pos;
+
+        SimdScanSetInit(&eol_set);
+        SimdScanSetAdd(&eol_set, '\r');
+        SimdScanSetAdd(&eol_set, '\n');
+        pos = SimdScanFind(&eol_set, s, len);
+        if (pos < len)
+            return s + pos;
     } else {
         int eol_len = strlen(eol);
         *eol_cur_saved = *eol_cur;
@@ -80,6 +80,7 @@
 #include "executor/executor.h"
 #include "pgstat.h"
 #include "storage/fd.h"
+#include "storage/fileaio.h"
 #include "storage/vfd.h"
 #include "storage/ipc.h"
 #include "storage/shmem.h"
@@ -144,6 +145,17 @@
 
 #define FileUnknownPos ((off_t)-1)
 
+/*
+ * A file opened with O_DIRECT bypasses the kernel page cache; the buffer,
+ * offset and length of every transfer must be multiples of the device's
+ * logical block size, which ALIGNOF_BUFFER is chosen to cover.
+ */
+#define FileIsDirect(file) ((u_sess->storage_cxt.VfdCache[file].fileFlags & O_DIRECT) != 0)
+
+#define FileDirectIOAligned(buffer, amount, offset)                                     \
+    (((uintptr_t)(buffer) % ALIGNOF_BUFFER) == 0 && ((amount) % ALIGNOF_BUFFER) == 0 && \
+        ((offset) % ALIGNOF_BUFFER) == 0)
+
 /* these are the assigned bits in fdstate below: */
 #define FD_TEMPORARY (1 << 0)        /* T = delete when closed */
 #define FD_XACT_TEMPORARY (1 << 1)   /* T = delete at eoXact */
@@ -262,6 +274,43 @@ void ReportResumeInsuffDataInstFileDesc()
     AlarmReporter(alarmItem, ALM_AT_Resume, &tempAdditionalParam);
 }
 
+/*
+ * The thread-shared file id cache is split into partitions, each guarded by
+ * its own mutex, so that threads opening different data files do not
+ * serialize on one lock.  We use mutexes rather than LWLocks because threads
+ * close their files on exit, after t_thrd.proc is gone.
+ *
+ * A row-store entry whose last reference goes away keeps its kernel fd open
+ * and is put on its partition's idle list, oldest first.  A session that
+ * evicts a segment from its own LRU ring and touches it again later then
+ * just takes a reference, without an open() call; with hundreds of
+ * thousands of segments this churn used to be the main cost of the VFD
+ * layer.  Idle fds are closed when the cache holds more than
+ * max_userdatafiles fds, when more than a small fraction of the process's
+ * RLIMIT_NOFILE are idle, when open() runs out of fds, and when their file
+ * is unlinked.
+ */
+#define NUM_DATAFILE_ID_CACHE_PARTITIONS 64
+
+/* idle fds may take at most 1/DATAFILE_ID_CACHE_IDLE_FRACTION of RLIMIT_NOFILE */
+#define DATAFILE_ID_CACHE_IDLE_FRACTION 8
+
+#define DataFileIdCachePartition(hashcode) \
+    (&t_thrd.storage_cxt.DataFileIdCacheCtl->partitions[(hashcode) % NUM_DATAFILE_ID_CACHE_PARTITIONS])
+
+typedef struct DataFileIdCachePart {
+    pthread_mutex_t mutex;
+    Dllist idle_files; /* entries with refcount 0, least recently used first */
+} DataFileIdCachePart;
+
+typedef struct DataFileIdCacheControl {
+    pg_atomic_uint32 nfiles;      /* kernel fds held by the cache */
+    pg_atomic_uint32 nidle;       /* of those, fds on the idle lists */
+    uint32 max_idle;              /* limit of nidle */
+    pg_atomic_uint32 next_victim; /* partition to close idle fds from next */
+    DataFileIdCachePart partitions[NUM_DATAFILE_ID_CACHE_PARTITIONS];
+} DataFileIdCacheControl;
+
 /*
  * Estimate space needed for mapping hashtable
  */
@@ -270,7 +319,27 @@ Size DataFileIdCacheSize(void)
     t_thrd.storage_cxt.max_userdatafiles =
         Max(g_instance.attr.attr_common.max_files_per_process, t_thrd.storage_cxt.max_userdatafiles);
 
-    return hash_estimate_size(t_thrd.storage_cxt.max_userdatafiles, sizeof(DataFileIdCacheEntry));
+    return add_size(hash_estimate_size(t_thrd.storage_cxt.max_userdatafiles, sizeof(DataFileIdCacheEntry)),
+        sizeof(DataFileIdCacheControl));
+}
+
+/*
+ * The number of idle fds the cache may keep: a fraction of the fds the
+ * process may have open, as all threads draw on that one budget.
+ */
+static uint32 DataFileIdCacheMaxIdle(void)
+{
+    uint64 budget = (uint64)g_instance.attr.attr_common.max_files_per_process;
+
+#if defined(HAVE_GETRLIMIT) && defined(RLIMIT_NOFILE)
+    struct rlimit rlim;
+
+    if (getrlimit(RLIMIT_NOFILE, &rlim) == 0 && rlim.rlim_cur != RLIM_INFINITY) {
+        budget = (uint64)rlim.rlim_cur;
+    }
+#endif
+
+    return (uint32)Min(Max(budget / DATAFILE_ID_CACHE_IDLE_FRACTION, NUM_DATAFILE_ID_CACHE_PARTITIONS), PG_UINT32_MAX);
 }
 
 /*
@@ -281,6 +350,7 @@ Size DataFileIdCacheSize(void)
 void InitDataFileIdCache(void)
 {
     HASHCTL ctl;
+    bool found = false;
 
     /* hash accessed by database file id */
     errno_t rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
@@ -288,10 +358,221 @@ void InitDataFileIdCache(void)
     ctl.keysize = sizeof(RelFileNodeForkNum);
     ctl.entrysize = sizeof(DataFileIdCacheEntry);
     ctl.hash = tag_hash;
-    t_thrd.storage_cxt.DataFileIdCache = HeapMemInitHash(
-        "Shared FileId hash by request", 256, t_thrd.storage_cxt.max_userdatafiles, &ctl, HASH_ELEM | HASH_FUNCTION);
+    ctl.num_partitions = NUM_DATAFILE_ID_CACHE_PARTITIONS;
+    /* a partitioned hash table never expands, so size it for the fd limit up front */
+    t_thrd.storage_cxt.DataFileIdCache = HeapMemInitHash("Shared FileId hash by request",
+        t_thrd.storage_cxt.max_userdatafiles,
+        t_thrd.storage_cxt.max_userdatafiles,
+        &ctl,
+        HASH_ELEM | HASH_FUNCTION | HASH_PARTITION);
     if (!t_thrd.storage_cxt.DataFileIdCache)
         ereport(FATAL, (errmsg("could not initialize shared file id hash table")));
+
+    t_thrd.storage_cxt.DataFileIdCacheCtl = (DataFileIdCacheControl*)HeapmemInitStruct(
+        "Shared FileId cache control", sizeof(DataFileIdCacheControl), &found);
+    if (!found) {
+        DataFileIdCacheControl* cacheCtl = t_thrd.storage_cxt.DataFileIdCacheCtl;
+
+        pg_atomic_init_u32(&cacheCtl->nfiles, 0);
+        pg_atomic_init_u32(&cacheCtl->nidle, 0);
+        cacheCtl->max_idle = DataFileIdCacheMaxIdle();
+        pg_atomic_init_u32(&cacheCtl->next_victim, 0);
+        for (int i = 0; i < NUM_DATAFILE_ID_CACHE_PARTITIONS; i++) {
+            (void)pthread_mutex_init(&cacheCtl->partitions[i].mutex, NULL);
+            DLInitList(&cacheCtl->partitions[i].idle_files);
+        }
+    }
+}
+
+/*
+ * Put an entry whose last reference went away on its partition's idle list,
+ * or take it off again.  The caller holds the partition's mutex.
+ */
+static void DataFileIdCacheIdleAdd(DataFileIdCachePart* part, DataFileIdCacheEntry* entry)
+{
+    DLAddTail(&part->idle_files, &entry->idle_elem);
+    (void)pg_atomic_fetch_add_u32(&t_thrd.storage_cxt.DataFileIdCacheCtl->nidle, 1);
+}
+
+static void DataFileIdCacheIdleRemove(DataFileIdCacheEntry* entry)
+{
+    DLRemove(&entry->idle_elem);
+    (void)pg_atomic_fetch_sub_u32(&t_thrd.storage_cxt.DataFileIdCacheCtl->nidle, 1);
+}
+
+/*
+ * Close a kernel fd that the file id cache has given up.  Nobody can be
+ * using it, so there is nothing to retry if close() fails.
+ */
+static void DataFileIdCacheCloseFd(int fd)
+{
+    if (close(fd) < 0) {
+        ereport(data_sync_elevel(WARNING),
+            (errcode_for_file_access(), errmsg("[Global] could not close idle file fd(%d), %m", fd)));
+    }
+    (void)pg_atomic_fetch_sub_u32(&t_thrd.storage_cxt.DataFileIdCacheCtl->nfiles, 1);
+}
+
+/*
+ * Close idle fds, least recently released first, until the cache holds at
+ * most max_userdatafiles fds and at most max_idle idle ones, or nothing idle
+ * is left.  Partitions are visited round robin, which approximates a global
+ * LRU without a global lock.  Also called with force set when open() has run
+ * out of fds, in which case a batch is closed regardless of the limits.
+ * Returns the number of fds closed.
+ */
+static int DataFileIdCacheShrink(bool force)
+{
+    DataFileIdCacheControl* cacheCtl = t_thrd.storage_cxt.DataFileIdCacheCtl;
+    uint32 limit = force ? 0 : (uint32)t_thrd.storage_cxt.max_userdatafiles;
+    uint32 idle_limit = 0;
+    int nclose = force ? NUM_DATAFILE_ID_CACHE_PARTITIONS : INT_MAX;
+    int nclosed = 0;
+    int nempty = 0;
+
+    /* not set up yet in this thread, e.g. an open() early in startup */
+    if (cacheCtl == NULL) {
+        return 0;
+    }
+    idle_limit = force ? 0 : cacheCtl->max_idle;
+
+    while (nclose > 0 && nempty < NUM_DATAFILE_ID_CACHE_PARTITIONS &&
+           (pg_atomic_read_u32(&cacheCtl->nfiles) > limit || pg_atomic_read_u32(&cacheCtl->nidle) > idle_limit)) {
+        uint32 partno = pg_atomic_fetch_add_u32(&cacheCtl->next_victim, 1) % NUM_DATAFILE_ID_CACHE_PARTITIONS;
+        DataFileIdCachePart* part = &cacheCtl->partitions[partno];
+        Dlelem* elem = NULL;
+        int fd = -1;
+
+        AutoMutexLock partLock(&part->mutex);
+        partLock.lock();
+        elem = DLGetHead(&part->idle_files);
+        if (elem != NULL) {
+            DataFileIdCacheEntry* entry = (DataFileIdCacheEntry*)DLE_VAL(elem);
+
+            Assert(entry->refcount == 0);
+            DataFileIdCacheIdleRemove(entry);
+            fd = entry->fd;
+            (void)hash_search(t_thrd.storage_cxt.DataFileIdCache, (void*)&entry->dbfid, HASH_REMOVE, NULL);
+        }
+        partLock.unLock();
+
+        if (fd < 0) {
+            nempty++;
+            continue;
+        }
+        nempty = 0;
+        nclose--;
+        nclosed++;
+        DataFileIdCacheCloseFd(fd);
+    }
+
+    return nclosed;
+}
+
+/*
+ * Take a reference to the cached fd of fileNode.  Returns -1 if it is not
+ * cached, or if it belongs to a file that is being dropped.  An idle fd
+ * whose file has been unlinked behind our back is closed rather than handed
+ * out, since the relfilenode may have been reused for a new file since.
+ */
+static int DataFileIdCacheAcquire(const RelFileNodeForkNum& fileNode)
+{
+    uint32 hashcode = get_hash_value(t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode);
+    DataFileIdCachePart* part = DataFileIdCachePartition(hashcode);
+    DataFileIdCacheEntry* entry = NULL;
+    int fd = -1;
+    int stalefd = -1;
+
+    AutoMutexLock partLock(&part->mutex);
+    partLock.lock();
+
+    entry = (DataFileIdCacheEntry*)hash_search_with_hash_value(
+        t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, hashcode, HASH_FIND, NULL);
+    if (entry != NULL && !entry->dropped) {
+        Assert(entry->fd >= 0);
+        if (entry->refcount > 0) {
+            entry->refcount++;
+            fd = entry->fd;
+        } else {
+            struct stat st;
+
+            DataFileIdCacheIdleRemove(entry);
+            if (fstat(entry->fd, &st) == 0 && st.st_nlink > 0) {
+                entry->refcount = 1;
+                fd = entry->fd;
+            } else {
+                stalefd = entry->fd;
+                (void)hash_search_with_hash_value(
+                    t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, hashcode, HASH_REMOVE, NULL);
+            }
+        }
+    }
+    partLock.unLock();
+
+    if (stalefd >= 0)
+        DataFileIdCacheCloseFd(stalefd);
+
+    return fd;
+}
+
+/*
+ * Enter the fd we have just opened for fileNode into the cache with one
+ * reference, and return the fd to use.  If another thread has entered the
+ * file meanwhile we share its fd and close ours, unless its fd is idle:
+ * then ours replaces it, as ours is known to refer to the current file.
+ * If the entry there belongs to a file being dropped, ours is not cached
+ * at all and *cached is set to false.
+ */
+static int DataFileIdCacheInsert(const RelFileNodeForkNum& fileNode, int fd, bool* cached)
+{
+    uint32 hashcode = get_hash_value(t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode);
+    DataFileIdCachePart* part = DataFileIdCachePartition(hashcode);
+    DataFileIdCacheEntry* entry = NULL;
+    bool found = false;
+    int closefd = -1;
+
+    START_CRIT_SECTION();
+    AutoMutexLock partLock(&part->mutex);
+    partLock.lock();
+
+    *cached = true;
+    entry = (DataFileIdCacheEntry*)hash_search_with_hash_value(
+        t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, hashcode, HASH_ENTER, &found);
+    if (found && entry->dropped) {
+        /* still referenced, or it would be gone; keep our fd to ourselves */
+        Assert(entry->refcount > 0);
+        *cached = false;
+    } else if (!found) {
+        entry->fd = fd;
+        entry->refcount = 1;
+        entry->dropped = false;
+        DLInitElem(&entry->idle_elem, entry);
+    } else if (entry->refcount == 0) {
+        DataFileIdCacheIdleRemove(entry);
+        closefd = entry->fd;
+        entry->fd = fd;
+        entry->refcount = 1;
+    } else {
+        /* already opened, close my open */
+        Assert(entry->fd >= 0);
+        entry->refcount++;
+        closefd = fd;
+        fd = entry->fd;
+    }
+    partLock.unLock();
+    END_CRIT_SECTION();
+
+    if (!*cached) {
+        return fd;
+    }
+    if (closefd >= 0) {
+        (void)close(closefd);
+    } else {
+        (void)pg_atomic_fetch_add_u32(&t_thrd.storage_cxt.DataFileIdCacheCtl->nfiles, 1);
+        (void)DataFileIdCacheShrink(false);
+    }
+
+    return fd;
 }
 
 RelFileNodeForkNum RelFileNodeForkNumFill(const RelFileNodeBackend& rnode, ForkNumber forknum, BlockNumber segno)
@@ -785,7 +1066,8 @@ tryAgain:
 #endif
 
         errno = 0;
-        if (ReleaseLruFile()) {
+        /* idle fds of the file id cache are the cheapest ones to give up */
+        if (DataFileIdCacheShrink(true) > 0 || ReleaseLruFile()) {
             goto tryAgain;
         }
         errno = save_errno;
@@ -1120,16 +1402,18 @@ static void DataFileIdCloseFile(Vfd* vfdP)
         return;
     }
 
+    uint32 hashcode = get_hash_value(t_thrd.storage_cxt.DataFileIdCache, (void*)&vfdP->fileNode);
+    DataFileIdCachePart* part = DataFileIdCachePartition(hashcode);
+
     // lock to prevent conflicts with other threads
-    // do not use LWLock, because when thread exit t_thrd.proc = NULL
-    AutoMutexLock vfdLock(&gVfdMutex);
-    vfdLock.lock();
+    AutoMutexLock partLock(&part->mutex);
+    partLock.lock();
 
     // find the opened file
-    entry =
-        (DataFileIdCacheEntry*)hash_search(t_thrd.storage_cxt.DataFileIdCache, (void*)&vfdP->fileNode, HASH_FIND, NULL);
+    entry = (DataFileIdCacheEntry*)hash_search_with_hash_value(
+        t_thrd.storage_cxt.DataFileIdCache, (void*)&vfdP->fileNode, hashcode, HASH_FIND, NULL);
     if (entry == NULL) {
-        vfdLock.unLock();
+        partLock.unLock();
         ereport(PANIC, (errmsg("file cache corrupted, file %s not opened with handle: %d", vfdP->fileName, vfdP->fd)));
     }
 
@@ -1139,22 +1423,35 @@ static void DataFileIdCloseFile(Vfd* vfdP)
     entry->refcount--;
     vfdP->infdCache = false;
 
-    // need to close and remove from cache
-    if (entry->refcount == 0) {
-        entry = (DataFileIdCacheEntry*)hash_search(
-            t_thrd.storage_cxt.DataFileIdCache, (void*)&vfdP->fileNode, HASH_REMOVE, NULL);
-        Assert(entry);
-        vfdLock.unLock();
+    if (entry->refcount > 0) {
+        partLock.unLock();
+        return;
+    }
 
-        if (close(vfdP->fd) < 0) {
-            ereport(LogLevelOfCloseFileFailed(vfdP),
-                (errcode_for_file_access(),
-                    errmsg("[Global] File(%s) fd(%d) have been closed, %m", vfdP->fileName, vfdP->fd)));
-        }
+    /*
+     * Keep the fd of a row-store file open for the next user.  Column-store
+     * files are dropped without going through md.c, which would not tell us,
+     * so those are closed as before.
+     */
+    if (entry->dbfid.storage == ROW_STORE && !entry->dropped) {
+        DataFileIdCacheIdleAdd(part, entry);
+        partLock.unLock();
+        (void)DataFileIdCacheShrink(false);
         return;
     }
 
-    vfdLock.unLock();
+    // need to close and remove from cache
+    entry = (DataFileIdCacheEntry*)hash_search_with_hash_value(
+        t_thrd.storage_cxt.DataFileIdCache, (void*)&vfdP->fileNode, hashcode, HASH_REMOVE, NULL);
+    Assert(entry);
+    partLock.unLock();
+    (void)pg_atomic_fetch_sub_u32(&t_thrd.storage_cxt.DataFileIdCacheCtl->nfiles, 1);
+
+    if (close(vfdP->fd) < 0) {
+        ereport(LogLevelOfCloseFileFailed(vfdP),
+            (errcode_for_file_access(),
+                errmsg("[Global] File(%s) fd(%d) have been closed, %m", vfdP->fileName, vfdP->fd)));
+    }
 }
 
 /*
@@ -1182,7 +1479,8 @@ static File PathNameOpenFile_internal(
     char* fnamecopy = NULL;
     Vfd* vfdP = NULL;
     bool newVfd = false;
-    DataFileIdCacheEntry* entry = NULL;
+    int cachedFd = -1;
+    bool cached = false;
 
     Assert(file != 0);
     DO_DB(ereport(LOG, (errmsg("PathNameOpenFile: %s %x %o", fileName, fileFlags, fileMode))));
@@ -1203,25 +1501,14 @@ static File PathNameOpenFile_internal(
     ReleaseLruFiles();
 
     // Search in fd cache to avoid consuming file handles.
-    if (useFileCache) {
-        // lock to prevent conflicts with other threads
-        AutoMutexLock vfdLock(&gVfdMutex);
-        vfdLock.lock();
-
-        // find the opened file
-        entry =
-            (DataFileIdCacheEntry*)hash_search(t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, HASH_FIND, NULL);
-        if (entry != NULL) {
-            Assert(entry->fd >= 0);
-            entry->refcount++;
-        }
-        vfdLock.unLock();
-    }
+    if (useFileCache)
+        cachedFd = DataFileIdCacheAcquire(fileNode);
 
     // found in file id cache
-    if (entry != NULL)
-        vfdP->fd = entry->fd;
-    else {
+    if (cachedFd >= 0) {
+        vfdP->fd = cachedFd;
+        cached = true;
+    } else {
         Assert(FileIsNotOpen(file));
         vfdP->fd = BasicOpenFile(fileName, fileFlags, fileMode);
     }
@@ -1252,32 +1539,10 @@ static File PathNameOpenFile_internal(
     }
 
     // Not found in fd cache, then enter it into cache
-    if (useFileCache && (entry == NULL)) {
-        bool found = false;
-        START_CRIT_SECTION();
-        AutoMutexLock vfdLock(&gVfdMutex);
-        vfdLock.lock();
-
-        // find place to enter
-        entry = (DataFileIdCacheEntry*)hash_search(
-            t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, HASH_ENTER, &found);
-        if (found) {
-            // already opened, close my open
-            Assert(entry->fd >= 0);
-            entry->refcount++;
-            vfdLock.unLock();
-            (void)close(vfdP->fd);
-            vfdP->fd = entry->fd;
-        } else {
-            Assert(vfdP->fd >= 0);
-            entry->fd = vfdP->fd;
-            entry->refcount = 1;
-            vfdLock.unLock();
-        }
-        END_CRIT_SECTION();
-    }
+    if (useFileCache && cachedFd < 0)
+        vfdP->fd = DataFileIdCacheInsert(fileNode, vfdP->fd, &cached);
 
-    vfdP->infdCache = useFileCache;
+    vfdP->infdCache = cached;
 
     return file;
 }
@@ -1631,6 +1896,10 @@ int FilePrefetch(File file, off_t offset, int amount, uint32 wait_event_info)
             (int64)offset,
             amount))));
 
+    /* the kernel's copy would never be used, reads go around the page cache */
+    if (FileIsDirect(file))
+        return 0;
+
     returnCode = FileAccess(file);
     if (returnCode < 0)
         return returnCode;
@@ -1681,6 +1950,7 @@ int FilePRead(File file, char* buffer, int amount, off_t offset, uint32 wait_eve
     int returnCode;
 
     Assert(FileIsValid(file));
+    Assert(!FileIsDirect(file) || FileDirectIOAligned(buffer, amount, offset));
 
     DO_DB(ereport(LOG,
         (errmsg("FilePRead: %d (%s) " INT64_FORMAT " %d",
@@ -1742,6 +2012,46 @@ retry:
     return returnCode;
 }
 
+// FilePReadV
+// 		Read from a file at a given offset into several buffers with one
+// 		preadv(), so that a range of blocks takes a single system call.
+// 		Returns the number of bytes read, or -1 with errno set.
+// 		NOTE: The file offset is not changed.
+int FilePReadV(File file, const struct iovec* iov, int iovcnt, off_t offset, uint32 wait_event_info)
+{
+    int returnCode;
+    size_t amount = 0;
+
+    Assert(FileIsValid(file));
+
+    for (int i = 0; i < iovcnt; i++) {
+        Assert(!FileIsDirect(file) || FileDirectIOAligned(iov[i].iov_base, iov[i].iov_len, offset));
+        amount += iov[i].iov_len;
+    }
+
+    returnCode = FileAccess(file);
+    if (returnCode < 0)
+        return returnCode;
+
+    /* collect io info for statistics */
+    if (u_sess->attr.attr_resource.use_workload_manager && u_sess->attr.attr_resource.enable_logical_io_statistics)
+        IOStatistics(IO_TYPE_READ, 1, (int)amount);
+
+    do {
+        PROFILING_MDIO_START();
+        pgstat_report_waitevent(wait_event_info);
+        PGSTAT_INIT_TIME_RECORD();
+        PGSTAT_START_TIME_RECORD();
+        returnCode = (int)preadv(u_sess->storage_cxt.VfdCache[file].fd, iov, iovcnt, offset);
+        PGSTAT_END_TIME_RECORD(DATA_IO_TIME);
+        pgstat_report_waitevent(WAIT_EVENT_END);
+        PROFILING_MDIO_END_READ((uint32)amount, returnCode);
+        /* OK to retry if interrupted */
+    } while (returnCode < 0 && errno == EINTR);
+
+    return returnCode;
+}
+
 int FileWrite(File file, const char* buffer, int amount, off_t offset)
 {
     int returnCode;
@@ -1807,6 +2117,7 @@ int FilePWrite(File file, const char* buffer, int amount, off_t offset, uint32 w
     int returnCode;
 
     Assert(FileIsValid(file));
+    Assert(!FileIsDirect(file) || FileDirectIOAligned(buffer, amount, offset));
 
     DO_DB(ereport(LOG,
         (errmsg("FilePWrite: %d (%s) " INT64_FORMAT " %d",
@@ -2306,6 +2617,25 @@ int FileFd(File file)
     return u_sess->storage_cxt.VfdCache[file].fd;
 }
 
+/*
+ * @Description: like FileFd(), but reopens the file first if the VFD LRU
+ *     has closed it.  Returns -1 with errno set if that fails.
+ * @in file -  file descriptor
+ * @return -  The returned fd is valid until the next VFD operation.
+ */
+int FileAccessFd(File file)
+{
+    int returnCode;
+
+    Assert(FileIsValid(file));
+
+    returnCode = FileAccess(file);
+    if (returnCode < 0)
+        return returnCode;
+
+    return u_sess->storage_cxt.VfdCache[file].fd;
+}
+
 /*
  * Make room for another allocatedDescs[] array entry if needed and possible.
  * Returns true if an array element is available.
@@ -2423,7 +2753,7 @@ restart:
 #endif
 
                 errno = 0;
-                if (ReleaseLruFile())
+                if (DataFileIdCacheShrink(true) > 0 || ReleaseLruFile())
                     goto TryAgain;
                 errno = save_errno;
             } else
@@ -2587,7 +2917,7 @@ TryAgain:
 #endif
 
         errno = 0;
-        if (ReleaseLruFile())
+        if (DataFileIdCacheShrink(true) > 0 || ReleaseLruFile())
             goto TryAgain;
         errno = save_errno;
     }
@@ -2793,7 +3123,7 @@ TryAgain:
 #endif
 
         errno = 0;
-        if (ReleaseLruFile())
+        if (DataFileIdCacheShrink(true) > 0 || ReleaseLruFile())
             goto TryAgain;
         errno = save_errno;
     }
@@ -3021,6 +3351,7 @@ void AtEOSubXact_Files(bool isCommit, SubTransactionId mySubid, SubTransactionId
  */
 void AtEOXact_Files(void)
 {
+    AtEOXact_FileAio();
     CleanupTempFiles(false);
     u_sess->storage_cxt.tempTableSpaces = NULL;
     u_sess->storage_cxt.numTempTableSpaces = -1;
@@ -3438,21 +3769,87 @@ bool FdRefcntIsZero(SMgrRelation reln, ForkNumber forkNum)
 {
     DataFileIdCacheEntry* entry = NULL;
     RelFileNodeForkNum fileNode = RelFileNodeForkNumFill(reln->smgr_rnode, forkNum, 0);
+    uint32 hashcode = get_hash_value(t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode);
+    DataFileIdCachePart* part = DataFileIdCachePartition(hashcode);
+    bool result = true;
 
-    AutoMutexLock vfdLock(&gVfdMutex);
-    vfdLock.lock();
+    AutoMutexLock partLock(&part->mutex);
+    partLock.lock();
 
-    entry = (DataFileIdCacheEntry*)hash_search(t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, HASH_FIND, NULL);
+    entry = (DataFileIdCacheEntry*)hash_search_with_hash_value(
+        t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, hashcode, HASH_FIND, NULL);
     if (entry != NULL) {
         Assert(entry->fd >= 0);
-        Assert(entry->refcount > 0);
+        result = (entry->refcount == 0);
+    }
+    partLock.unLock();
 
-        vfdLock.unLock();
-        return false;
+    return result;
+}
+
+/*
+ * A data file is about to be unlinked: close its fd in the file id cache if
+ * it is idle, so that the disk space is given back at once.  If it is still
+ * referenced, it is closed when the last reference goes away instead of
+ * being kept idle.
+ */
+void ForgetDataFileIdCache(const RelFileNodeForkNum& fileNode)
+{
+    DataFileIdCacheEntry* entry = NULL;
+    uint32 hashcode = get_hash_value(t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode);
+    DataFileIdCachePart* part = DataFileIdCachePartition(hashcode);
+    int fd = -1;
+
+    AutoMutexLock partLock(&part->mutex);
+    partLock.lock();
+
+    entry = (DataFileIdCacheEntry*)hash_search_with_hash_value(
+        t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, hashcode, HASH_FIND, NULL);
+    if (entry != NULL) {
+        if (entry->refcount > 0) {
+            entry->dropped = true;
+        } else {
+            DataFileIdCacheIdleRemove(entry);
+            fd = entry->fd;
+            (void)hash_search_with_hash_value(
+                t_thrd.storage_cxt.DataFileIdCache, (void*)&fileNode, hashcode, HASH_REMOVE, NULL);
+        }
     }
-    vfdLock.unLock();
+    partLock.unLock();
 
-    return true;
+    if (fd >= 0)
+        DataFileIdCacheCloseFd(fd);
+}
+
+/*
+ * Close the idle fds of all files of a database that is being dropped or
+ * moved.  Referenced ones are left alone; a stale fd that goes idle later
+ * is noticed by DataFileIdCacheAcquire() or closed by the LRU sweep.
+ */
+void ForgetDatabaseDataFileIdCache(Oid dbid)
+{
+    DataFileIdCacheControl* cacheCtl = t_thrd.storage_cxt.DataFileIdCacheCtl;
+
+    for (int i = 0; i < NUM_DATAFILE_ID_CACHE_PARTITIONS; i++) {
+        DataFileIdCachePart* part = &cacheCtl->partitions[i];
+        Dlelem* elem = NULL;
+        Dlelem* next = NULL;
+
+        AutoMutexLock partLock(&part->mutex);
+        partLock.lock();
+        for (elem = DLGetHead(&part->idle_files); elem != NULL; elem = next) {
+            DataFileIdCacheEntry* entry = (DataFileIdCacheEntry*)DLE_VAL(elem);
+
+            next = DLGetSucc(elem);
+            if (entry->dbfid.rnode.node.dbNode != dbid)
+                continue;
+
+            DataFileIdCacheIdleRemove(entry);
+            DataFileIdCacheCloseFd(entry->fd);
+            (void)hash_search(t_thrd.storage_cxt.DataFileIdCache, (void*)&entry->dbfid, HASH_REMOVE, NULL);
+        }
+        partLock.unLock();
+    }
 }
 
 /*
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * fileaio.cpp
+ *        Asynchronous I/O on virtual file descriptors, on io_uring when available
+ *
+ * Each thread that uses io_uring owns one ring, created on first use and
+ * closed at thread exit.  The ring is driven with the raw system calls, so
+ * no liburing is needed.  Every request is submitted to the kernel as soon
+ * as it is queued: the kernel takes its own reference to the file at that
+ * point, so the VFD layer is free to close the descriptor again (to stay
+ * under max_files_per_process) while the I/O is in flight.  For the same
+ * reason the descriptors are not registered as fixed files.
+ *
+ * Without io_uring (older kernel or headers, enable_io_uring off, or ring
+ * setup failure) requests are carried out synchronously at submit time.  A
+ * ring whose submissions start failing is given up the same way: the request
+ * at hand and all later ones of the thread are done synchronously, while
+ * requests already in flight on it are still waited for.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/file/fileaio.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+#include <unistd.h>
+
+#include "pgstat.h"
+#include "storage/barrier.h"
+#include "storage/fd.h"
+#include "storage/fileaio.h"
+#include "storage/ipc.h"
+#include "utils/memutils.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define USE_IO_URING
+#endif
+#endif
+#endif
+
+#ifdef USE_IO_URING
+
+/* submission queue depth of each thread's ring */
+#define FILE_AIO_RING_ENTRIES 128
+
+typedef struct FileAioRing {
+    int fd;
+    uint32 entries;
+    int inflight;
+
+    /* submission queue */
+    volatile uint32* sq_head;
+    volatile uint32* sq_tail;
+    uint32 sq_mask;
+    uint32* sq_array;
+    struct io_uring_sqe* sqes;
+
+    /* completion queue */
+    volatile uint32* cq_head;
+    volatile uint32* cq_tail;
+    uint32 cq_mask;
+    struct io_uring_cqe* cqes;
+
+    /* mappings, for teardown */
+    void* sq_ptr;
+    size_t sq_size;
+    void* cq_ptr;
+    size_t cq_size;
+    size_t sqes_size;
+} FileAioRing;
+
+static int io_uring_enter_call(int fd, uint32 to_submit, uint32 min_complete, uint32 flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static void FileAioRingRelease(FileAioRing* ring)
+{
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        (void)munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ptr != NULL && ring->cq_ptr != MAP_FAILED) {
+        (void)munmap(ring->cq_ptr, ring->cq_size);
+    }
+    if (ring->sq_ptr != NULL && ring->sq_ptr != MAP_FAILED) {
+        (void)munmap(ring->sq_ptr, ring->sq_size);
+    }
+    if (ring->fd >= 0) {
+        (void)close(ring->fd);
+    }
+    pfree(ring);
+}
+
+static void FileAioRingShutdown(int code, Datum arg)
+{
+    FileAioRing* ring = t_thrd.storage_cxt.FileAioUring;
+
+    if (ring == NULL) {
+        return;
+    }
+
+    /* let the kernel finish with any buffers still in use before unmapping */
+    AtEOXact_FileAio();
+    t_thrd.storage_cxt.FileAioUring = NULL;
+    FileAioRingRelease(ring);
+}
+
+/*
+ * Push a no-op through a new ring and wait for it, so that a ring the kernel
+ * accepts but cannot run (e.g. blocked by seccomp) is caught here rather
+ * than when real I/O is submitted.
+ */
+static bool FileAioRingCheck(FileAioRing* ring)
+{
+    struct io_uring_sqe* sqe = NULL;
+    struct io_uring_cqe* cqe = NULL;
+    uint32 tail = *ring->sq_tail;
+    uint32 index = tail & ring->sq_mask;
+    uint32 head;
+    int ret;
+    errno_t rc;
+
+    sqe = &ring->sqes[index];
+    rc = memset_s(sqe, sizeof(*sqe), 0, sizeof(*sqe));
+    securec_check(rc, "", "");
+    sqe->opcode = IORING_OP_NOP;
+    ring->sq_array[index] = index;
+
+    pg_write_barrier();
+    *ring->sq_tail = tail + 1;
+
+    do {
+        ret = io_uring_enter_call(ring->fd, 1, 1, IORING_ENTER_GETEVENTS);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        return false;
+    }
+
+    head = *ring->cq_head;
+    pg_read_barrier();
+    if (head == *ring->cq_tail) {
+        errno = EIO;
+        return false;
+    }
+    cqe = &ring->cqes[head & ring->cq_mask];
+    ret = cqe->res;
+    pg_memory_barrier();
+    *ring->cq_head = head + 1;
+
+    if (ret < 0) {
+        errno = -ret;
+        return false;
+    }
+    return true;
+}
+
+static FileAioRing* FileAioRingCreate(void)
+{
+    struct io_uring_params params;
+    FileAioRing* ring = NULL;
+    errno_t rc;
+
+    rc = memset_s(&params, sizeof(params), 0, sizeof(params));
+    securec_check(rc, "", "");
+
+    ring = (FileAioRing*)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(FileAioRing));
+    ring->fd = (int)syscall(__NR_io_uring_setup, FILE_AIO_RING_ENTRIES, &params);
+    if (ring->fd < 0) {
+        ereport(LOG, (errcode_for_file_access(), errmsg("could not set up io_uring, using synchronous I/O: %m")));
+        pfree(ring);
+        return NULL;
+    }
+
+    ring->entries = params.sq_entries;
+    ring->sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32);
+    ring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+        IORING_OFF_SQ_RING);
+    ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+        IORING_OFF_CQ_RING);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ptr == MAP_FAILED || ring->cq_ptr == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        ereport(LOG, (errcode_for_file_access(), errmsg("could not map io_uring queues, using synchronous I/O: %m")));
+        FileAioRingRelease(ring);
+        return NULL;
+    }
+
+    ring->sq_head = (volatile uint32*)((char*)ring->sq_ptr + params.sq_off.head);
+    ring->sq_tail = (volatile uint32*)((char*)ring->sq_ptr + params.sq_off.tail);
+    ring->sq_mask = *(uint32*)((char*)ring->sq_ptr + params.sq_off.ring_mask);
+    ring->sq_array = (uint32*)((char*)ring->sq_ptr + params.sq_off.array);
+    ring->cq_head = (volatile uint32*)((char*)ring->cq_ptr + params.cq_off.head);
+    ring->cq_tail = (volatile uint32*)((char*)ring->cq_ptr + params.cq_off.tail);
+    ring->cq_mask = *(uint32*)((char*)ring->cq_ptr + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)((char*)ring->cq_ptr + params.cq_off.cqes);
+
+    if (!FileAioRingCheck(ring)) {
+        ereport(LOG, (errcode_for_file_access(), errmsg("could not use io_uring, using synchronous I/O: %m")));
+        FileAioRingRelease(ring);
+        return NULL;
+    }
+
+    on_proc_exit(FileAioRingShutdown, 0);
+
+    return ring;
+}
+
+/*
+ * The ring to queue new requests on, or NULL to do them synchronously.
+ */
+static FileAioRing* FileAioGetRing(void)
+{
+    if (!u_sess->attr.attr_storage.enable_io_uring || t_thrd.storage_cxt.FileAioUringFailed) {
+        return NULL;
+    }
+
+    if (t_thrd.storage_cxt.FileAioUring == NULL) {
+        t_thrd.storage_cxt.FileAioUring = FileAioRingCreate();
+        t_thrd.storage_cxt.FileAioUringFailed = (t_thrd.storage_cxt.FileAioUring == NULL);
+    }
+    return t_thrd.storage_cxt.FileAioUring;
+}
+
+/*
+ * Collect all completions currently posted.  With discard set the requests
+ * themselves are not touched, as they may already have been freed.
+ */
+static void FileAioReap(FileAioRing* ring, bool discard)
+{
+    uint32 head = *ring->cq_head;
+    uint32 tail = *ring->cq_tail;
+
+    pg_read_barrier();
+
+    while (head != tail) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & ring->cq_mask];
+
+        if (!discard) {
+            FileAioRequest* req = (FileAioRequest*)(uintptr_t)cqe->user_data;
+
+            if (cqe->res < 0) {
+                req->result = -1;
+                req->error = -cqe->res;
+            } else {
+                req->result = (req->op == FILE_AIO_FSYNC) ? 0 : cqe->res;
+            }
+            req->inflight = false;
+        }
+        ring->inflight--;
+        head++;
+    }
+
+    pg_memory_barrier();
+    *ring->cq_head = head;
+}
+
+/* Block until at least one more completion is posted. */
+static void FileAioWaitOne(FileAioRing* ring, uint32 wait_event_info)
+{
+    int ret;
+
+    pgstat_report_waitevent(wait_event_info);
+    do {
+        ret = io_uring_enter_call(ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+    } while (ret < 0 && errno == EINTR);
+    pgstat_report_waitevent(WAIT_EVENT_END);
+
+    if (ret < 0) {
+        ereport(PANIC, (errcode_for_file_access(), errmsg("could not wait for io_uring completions: %m")));
+    }
+}
+
+/*
+ * Queue req on the ring and hand it to the kernel.  Returns false, with the
+ * request taken back off the ring, if the kernel would not accept it.
+ */
+static bool FileAioRingSubmit(FileAioRing* ring, FileAioRequest* req)
+{
+    struct io_uring_sqe* sqe = NULL;
+    uint32 tail;
+    uint32 index;
+    int fd;
+    int ret;
+    errno_t rc;
+
+    fd = FileAccessFd(req->file);
+    if (fd < 0) {
+        req->result = -1;
+        req->error = errno;
+        return true;
+    }
+
+    /* make room if the kernel may still be holding a full queue of ours */
+    while (ring->inflight >= (int)ring->entries) {
+        FileAioReap(ring, false);
+        if (ring->inflight >= (int)ring->entries) {
+            FileAioWaitOne(ring, req->wait_event_info);
+        }
+    }
+
+    tail = *ring->sq_tail;
+    index = tail & ring->sq_mask;
+    sqe = &ring->sqes[index];
+    rc = memset_s(sqe, sizeof(*sqe), 0, sizeof(*sqe));
+    securec_check(rc, "", "");
+
+    sqe->fd = fd;
+    sqe->user_data = (uint64)(uintptr_t)req;
+    switch (req->op) {
+        case FILE_AIO_READ:
+        case FILE_AIO_WRITE:
+            req->iov.iov_base = req->buffer;
+            req->iov.iov_len = (size_t)req->amount;
+            sqe->opcode = (req->op == FILE_AIO_READ) ? IORING_OP_READV : IORING_OP_WRITEV;
+            sqe->addr = (uint64)(uintptr_t)&req->iov;
+            sqe->len = 1;
+            sqe->off = (uint64)req->offset;
+            break;
+        case FILE_AIO_FSYNC:
+            sqe->opcode = IORING_OP_FSYNC;
+            break;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("unrecognized file aio operation %d", req->op)));
+    }
+    ring->sq_array[index] = index;
+
+    pg_write_barrier();
+    *ring->sq_tail = tail + 1;
+
+    req->inflight = true;
+    ring->inflight++;
+
+    for (;;) {
+        ret = io_uring_enter_call(ring->fd, 1, 0, 0);
+        if (ret >= 0) {
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EBUSY) {
+            /* kernel is short of resources or completions; drain some and retry */
+            FileAioReap(ring, false);
+            if (ring->inflight > 1) {
+                FileAioWaitOne(ring, req->wait_event_info);
+            } else {
+                pg_usleep(1000L);
+            }
+            continue;
+        }
+
+        /*
+         * Nothing was consumed, so the entry, the only one not yet submitted,
+         * can simply be taken back.
+         */
+        ereport(LOG,
+            (errcode_for_file_access(), errmsg("could not submit io_uring request, using synchronous I/O: %m")));
+        *ring->sq_tail = tail;
+        req->inflight = false;
+        ring->inflight--;
+        return false;
+    }
+
+    return true;
+}
+#endif /* USE_IO_URING */
+
+/* Carry out the request right away, as the plain VFD routines would. */
+static void FileAioSyncIO(FileAioRequest* req)
+{
+    int ret = -1;
+
+    switch (req->op) {
+        case FILE_AIO_READ:
+            ret = FilePRead(req->file, req->buffer, req->amount, req->offset, req->wait_event_info);
+            break;
+        case FILE_AIO_WRITE:
+            ret = FilePWrite(req->file, req->buffer, req->amount, req->offset, req->wait_event_info);
+            break;
+        case FILE_AIO_FSYNC:
+            ret = FileSync(req->file, req->wait_event_info);
+            break;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("unrecognized file aio operation %d", req->op)));
+    }
+
+    req->result = (ret < 0) ? -1 : ret;
+    req->error = (ret < 0) ? errno : 0;
+}
+
+/*
+ * FileAioIsAsync
+ *      Return true if FileAioSubmit() would leave requests in flight, false if
+ *      it would carry them out synchronously.
+ */
+bool FileAioIsAsync(void)
+{
+#ifdef USE_IO_URING
+    return FileAioGetRing() != NULL;
+#else
+    return false;
+#endif
+}
+
+/*
+ * FileAioSubmit
+ *      Start the I/O described by req.  The result is available once
+ *      FileAioPoll() returns true or FileAioWait() returns.
+ */
+void FileAioSubmit(FileAioRequest* req)
+{
+    Assert(!req->inflight);
+
+    req->result = 0;
+    req->error = 0;
+
+    /* nothing to do, as in pg_fsync_no_writethrough() */
+    if (req->op == FILE_AIO_FSYNC && !u_sess->attr.attr_storage.enableFsync) {
+        return;
+    }
+
+#ifdef USE_IO_URING
+    FileAioRing* ring = FileAioGetRing();
+
+    if (ring != NULL) {
+        if (FileAioRingSubmit(ring, req)) {
+            return;
+        }
+        t_thrd.storage_cxt.FileAioUringFailed = true;
+    }
+#endif
+
+    FileAioSyncIO(req);
+}
+
+/*
+ * FileAioPoll
+ *      Return true if req has completed, without blocking.
+ */
+bool FileAioPoll(FileAioRequest* req)
+{
+#ifdef USE_IO_URING
+    if (req->inflight) {
+        FileAioReap(t_thrd.storage_cxt.FileAioUring, false);
+    }
+#endif
+    return !req->inflight;
+}
+
+/*
+ * FileAioWait
+ *      Block until req has completed.
+ */
+void FileAioWait(FileAioRequest* req)
+{
+#ifdef USE_IO_URING
+    FileAioRing* ring = t_thrd.storage_cxt.FileAioUring;
+
+    while (req->inflight) {
+        FileAioReap(ring, false);
+        if (!req->inflight) {
+            break;
+        }
+        /* dropped by AtEOXact_FileAio() without being waited for */
+        if (ring->inflight == 0) {
+            ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("file aio request was abandoned")));
+        }
+        FileAioWaitOne(ring, req->wait_event_info);
+    }
+#else
+    Assert(!req->inflight);
+#endif
+}
+
+/*
+ * AtEOXact_FileAio
+ *      Wait out requests left in flight, e.g. by an error, so the kernel no
+ *      longer writes into memory about to be released.  Their results are
+ *      dropped.
+ */
+void AtEOXact_FileAio(void)
+{
+#ifdef USE_IO_URING
+    FileAioRing* ring = t_thrd.storage_cxt.FileAioUring;
+
+    if (ring == NULL) {
+        return;
+    }
+
+    FileAioReap(ring, true);
+    while (ring->inflight > 0) {
+        FileAioWaitOne(ring, WAIT_EVENT_END);
+        FileAioReap(ring, true);
+    }
+#endif
+}
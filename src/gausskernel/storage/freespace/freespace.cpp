@@ -580,15 +580,15 @@ static void fsm_extend(Relation rel, BlockNumber fsm_nblocks)
     BlockNumber fsm_nblocks_now;
     Page pg;
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         pg = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pg = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     PageInit(pg, BLCKSZ, 0);
 
@@ -634,15 +634,15 @@ static void fsm_extend(Relation rel, BlockNumber fsm_nblocks)
 
     UnlockRelationForExtension(rel, ExclusiveLock);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(pg);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree(pg);
     }
-    ADIO_END();
+    DIO_END();
 }
 
 /*
@@ -63,7 +63,6 @@
 
 /* we use semaphore not LWLOCK, because when thread InitGucConfig, it does not get a t_thrd.proc */
 pthread_mutex_t gLocaleMutex = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t gVfdMutex = PTHREAD_MUTEX_INITIALIZER;
 
 extern void SetShmemCxt(void);
 
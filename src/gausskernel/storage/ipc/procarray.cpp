@@ -546,9 +546,12 @@ static void ProcArrayGroupClearXid(PGPROC* proc, TransactionId latestXid)
     TransactionId xid[PROCARRAY_MAXPROCS];
     uint32 nsubxids[PROCARRAY_MAXPROCS];
     uint32 index = 0;
+    uint32 nmembers;
     CommitSeqNo commitcsn[PROCARRAY_MAXPROCS];
+    TransactionId batchxid[PROCARRAY_MAXPROCS];
     CommitSeqNo maxcsn = 0;
     CommitSeqNo csn;
+    bool updateCsnLog = useLocalXid || !IsPostmasterEnvironment || GTM_FREE_MODE;
 
     /* We should definitely have an XID to clear. */
     /* Add ourselves to the list of processes needing a group XID clear. */
@@ -630,6 +633,32 @@ static void ProcArrayGroupClearXid(PGPROC* proc, TransactionId latestXid)
 
     /* We're done with the lock now. */
     LWLockRelease(ProcArrayLock);
+    nmembers = index;
+
+    /*
+     * Stamp the CSN log for every member that committed a transaction
+     * without subtransactions in one batch, so that members whose xids share
+     * a CSNLOG page take the page's partition lock only once.  Aborts and
+     * transactions with subtransactions are done one by one below.
+     */
+    if (updateCsnLog) {
+        for (index = 0; index < nmembers; index++) {
+            bool isCommit = (commitcsn[index] != COMMITSEQNO_ABORTED);
+
+#ifdef ENABLE_MULTIPLE_NODES
+            commitcsn[index] = commitcsn[index] ? commitcsn[index] : csn;
+#endif
+            batchxid[index] = InvalidTransactionId;
+            if (isCommit && TransactionIdIsNormal(xid[index]) && nsubxids[index] == 0) {
+                Assert(commitcsn[index] >= COMMITSEQNO_FROZEN);
+                batchxid[index] = xid[index];
+#ifndef ENABLE_MULTIPLE_NODES
+                commitcsn[index] &= ~COMMITSEQNO_COMMIT_INPROGRESS;
+#endif
+            }
+        }
+        CSNLogSetCommitSeqNoBatch((int)nmembers, batchxid, commitcsn);
+    }
 
     /*
      * Now that we've released the lock, go back and wake everybody up.  We
@@ -650,19 +679,17 @@ static void ProcArrayGroupClearXid(PGPROC* proc, TransactionId latestXid)
 
         proc_member->procArrayGroupMember = false;
 
-        /* Update CSN log. */
-        if (useLocalXid || !IsPostmasterEnvironment || GTM_FREE_MODE) {
-            CommitSeqNo commitCsn = commitcsn[index];
-
-#ifdef ENABLE_MULTIPLE_NODES
-            commitCsn = commitCsn ? commitCsn: csn;
-#endif
-            UpdateCSNLogAtTransactionEND(proc_member,
-                xid[index],
-                nsubxids[index],
-                proc_member->subxids.xids,
-                commitCsn,
-                commitcsn[index] != COMMITSEQNO_ABORTED);
+        /* Update CSN log, unless it was done in the batch above. */
+        if (updateCsnLog) {
+            if (TransactionIdIsValid(batchxid[index]))
+                ResetProcXidCache(proc_member, true);
+            else
+                UpdateCSNLogAtTransactionEND(proc_member,
+                    xid[index],
+                    nsubxids[index],
+                    proc_member->subxids.xids,
+                    commitcsn[index],
+                    commitcsn[index] != COMMITSEQNO_ABORTED);
         }
 
         if (proc_member != t_thrd.proc)
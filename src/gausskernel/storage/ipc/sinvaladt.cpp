@@ -29,6 +29,7 @@
 #include "storage/spin.h"
 #include "gs_thread.h"
 #include "threadpool/threadpool.h"
+#include "utils/globalplancache.h"
 
 /*
  * Conceptually, the shared cache invalidation messages are stored in an
@@ -72,12 +73,9 @@
  * of "stuck" backends, we won't need a lot of extra interrupts, since ones
  * that aren't stuck will propagate their interrupts to the next guy.
  *
- * We would have problems if the MsgNum values overflow an integer, so
- * whenever minMsgNum exceeds MSGNUMWRAPAROUND, we subtract MSGNUMWRAPAROUND
- * from all the MsgNum variables simultaneously.  MSGNUMWRAPAROUND can be
- * large so that we don't need to do this often.  It must be a multiple of
- * MAXNUMMESSAGES so that the existing circular-buffer entries don't need
- * to be moved when we do it.
+ * The MsgNum values are 64-bit counters that are never decremented, so they
+ * cannot overflow in practice and there is no wraparound processing that
+ * would have to touch every backend's state.
  *
  * Access to the shared sinval array is protected by two locks, SInvalReadLock
  * and SInvalWriteLock.  Readers take SInvalReadLock in shared mode; this
@@ -96,13 +94,18 @@
  * read maxMsgNum if you are not holding SInvalWriteLock, and you need the
  * spinlock to write maxMsgNum unless you are holding both locks.)
  *
- * Note: since maxMsgNum is an int and hence presumably atomically readable/
- * writable, the spinlock might seem unnecessary.  The reason it is needed
- * is to provide a memory barrier: we need to be sure that messages written
- * to the array are actually there before maxMsgNum is increased, and that
- * readers will see that data after fetching maxMsgNum.  Multiprocessors
- * that have weak memory-ordering guarantees can fail without the memory
- * barrier instructions that are included in the spinlock sequences.
+ * Note: besides making the 64-bit maxMsgNum atomically readable on every
+ * platform, the spinlock provides a memory barrier: we need to be sure that
+ * messages written to the array are actually there before maxMsgNum is
+ * increased, and that readers will see that data after fetching maxMsgNum.
+ * Multiprocessors that have weak memory-ordering guarantees can fail without
+ * the memory barrier instructions that are included in the spinlock
+ * sequences.
+ *
+ * Readers drop catcache, catalog, relcache, partcache and relmap messages
+ * that belong to another database while copying them out of the queue, so
+ * the receiving session never has to dispatch them.  Smgr messages cannot be
+ * filtered that way, since any backend may have the file open.
  */
 /*
  * Configurable parameters.
@@ -110,9 +113,6 @@
  * MAXNUMMESSAGES: max number of shared-inval messages we can buffer.
  * Must be a power of 2 for speed.
  *
- * MSGNUMWRAPAROUND: how often to reduce MsgNum variables to avoid overflow.
- * Must be a multiple of MAXNUMMESSAGES.  Should be large.
- *
  * CLEANUP_MIN: the minimum number of messages that must be in the buffer
  * before we bother to call SICleanupQueue.
  *
@@ -128,7 +128,6 @@
  * per iteration.
  */
 #define MAXNUMMESSAGES 4096
-#define MSGNUMWRAPAROUND (MAXNUMMESSAGES * 262144)
 #define CLEANUP_MIN (MAXNUMMESSAGES / 2)
 #define CLEANUP_QUANTUM (MAXNUMMESSAGES / 16)
 #define SIG_THRESHOLD (MAXNUMMESSAGES / 2)
@@ -140,7 +139,7 @@ typedef struct ProcState {
     ThreadId procPid; /* PID of backend, for signaling */
     PGPROC* proc;     /* PGPROC of backend */
     /* nextMsgNum is meaningless if procPid == 0 or resetState is true. */
-    int nextMsgNum;   /* next message number to read */
+    int64 nextMsgNum; /* next message number to read */
     bool resetState;  /* backend needs to reset its state */
     bool signaled;    /* backend has been sent catchup signal */
     bool hasMessages; /* backend has unread messages */
@@ -167,9 +166,9 @@ typedef struct SISeg {
     /*
      * General state information
      */
-    int minMsgNum;     /* oldest message still needed */
-    int maxMsgNum;     /* next message number to be assigned */
-    int nextThreshold; /* # of messages to call SICleanupQueue */
+    int64 minMsgNum;     /* oldest message still needed */
+    int64 maxMsgNum;     /* next message number to be assigned */
+    int nextThreshold;   /* # of messages to call SICleanupQueue */
     int lastBackend;   /* index of last active procState entry, +1 */
     int lastreserveBackend;
     int maxBackends; /* size of procState array */
@@ -542,7 +541,7 @@ void SIInsertDataEntries(const SharedInvalidationMessage* data, int n)
     while (n > 0) {
         int nthistime = Min(n, WRITE_QUANTUM);
         int numMsgs;
-        int max;
+        int64 max;
         int i;
 
         n -= nthistime;
@@ -557,7 +556,7 @@ void SIInsertDataEntries(const SharedInvalidationMessage* data, int n)
          * after any call of SICleanupQueue.
          */
         for (;;) {
-            numMsgs = segP->maxMsgNum - segP->minMsgNum;
+            numMsgs = (int)(segP->maxMsgNum - segP->minMsgNum);
 
             if (numMsgs + nthistime > MAXNUMMESSAGES || numMsgs >= segP->nextThreshold) {
                 SICleanupQueue(true, nthistime);
@@ -605,6 +604,41 @@ void SIInsertDataEntries(const SharedInvalidationMessage* data, int n)
     }
 }
 
+/*
+ * SIMessageIsForOtherDatabase
+ *		Can msg be skipped by a session connected to MyDatabaseId?
+ *
+ * This mirrors the database tests in LocalExecuteInvalidationMessage.  The
+ * global plan cache looks at every message, so nothing is skipped while it
+ * is enabled.
+ */
+static inline bool SIMessageIsForOtherDatabase(const SharedInvalidationMessage* msg)
+{
+    Oid myDatabaseId = u_sess->proc_cxt.MyDatabaseId;
+    Oid dbId;
+
+    if (!OidIsValid(myDatabaseId) || ENABLE_DN_GPC) {
+        return false;
+    }
+
+    if (msg->id >= 0) {
+        dbId = msg->cc.dbId;
+    } else if (msg->id == SHAREDINVALCATALOG_ID) {
+        dbId = msg->cat.dbId;
+    } else if (msg->id == SHAREDINVALRELCACHE_ID) {
+        dbId = msg->rc.dbId;
+    } else if (msg->id == SHAREDINVALRELMAP_ID) {
+        dbId = msg->rm.dbId;
+    } else if (msg->id == SHAREDINVALPARTCACHE_ID) {
+        dbId = msg->pc.dbId;
+    } else {
+        /* smgr messages, or something LocalExecuteInvalidationMessage complains about */
+        return false;
+    }
+
+    return OidIsValid(dbId) && dbId != myDatabaseId;
+}
+
 /*
  * SIGetDataEntries
  *		get next SI message(s) for current backend, if there are any
@@ -616,7 +650,9 @@ void SIInsertDataEntries(const SharedInvalidationMessage* data, int n)
  *
  * If the return value is less than the array size "datasize", the caller
  * can assume that there are no more SI messages after the one(s) returned.
- * Otherwise, another call is needed to collect more messages.
+ * Otherwise, another call is needed to collect more messages.  Messages for
+ * other databases are consumed without being returned, so 0 may also mean
+ * that everything pending was irrelevant to us.
  *
  * NB: this can run in parallel with other instances of SIGetDataEntries
  * executing on behalf of other backends, since each instance will modify only
@@ -637,7 +673,8 @@ int SIGetDataEntries(SharedInvalidationMessage* data, int datasize)
 {
     SISeg* segP = NULL;
     ProcState* stateP = NULL;
-    int max;
+    int64 max;
+    int64 next;
     int n;
 
     segP = t_thrd.shemem_ptr_cxt.shmInvalBuffer;
@@ -699,20 +736,27 @@ int SIGetDataEntries(SharedInvalidationMessage* data, int datasize)
     }
 
     /*
-     * Retrieve messages and advance backend's counter, until data array is
-     * full or there are no more messages.
+     * Retrieve messages until data array is full or there are no more
+     * messages, skipping those that can't concern us.
      *
      * There may be other backends that haven't read the message(s), so we
      * cannot delete them here.  SICleanupQueue() will eventually remove them
      * from the queue.
      */
     n = 0;
+    next = stateP->nextMsgNum;
+
+    while (n < datasize && next < max) {
+        SharedInvalidationMessage* msg = &segP->buffer[next % MAXNUMMESSAGES];
 
-    while (n < datasize && stateP->nextMsgNum < max) {
-        data[n++] = segP->buffer[stateP->nextMsgNum % MAXNUMMESSAGES];
-        stateP->nextMsgNum++;
+        next++;
+        if (!SIMessageIsForOtherDatabase(msg)) {
+            data[n++] = *msg;
+        }
     }
 
+    stateP->nextMsgNum = next;
+
     /*
      * If we have caught up completely, reset our "signaled" flag so that
      * we'll get another signal if we fall behind again.
@@ -720,7 +764,7 @@ int SIGetDataEntries(SharedInvalidationMessage* data, int datasize)
      * If we haven't caught up completely, reset the hasMessages flag so that
      * we see the remaining messages next time.
      */
-    if (stateP->nextMsgNum >= max) {
+    if (next >= max) {
         stateP->signaled = false;
     } else {
         stateP->hasMessages = true;
@@ -749,7 +793,8 @@ int SIGetDataEntries(SharedInvalidationMessage* data, int datasize)
 void SICleanupQueue(bool callerHasWriteLock, int minFree)
 {
     SISeg* segP = t_thrd.shemem_ptr_cxt.shmInvalBuffer;
-    int min, minsig, lowbound, numMsgs, i;
+    int64 min, minsig, lowbound;
+    int numMsgs, i;
     ProcState* needSig = NULL;
 
     /* Lock out all writers and readers */
@@ -772,7 +817,7 @@ void SICleanupQueue(bool callerHasWriteLock, int minFree)
 
     for (i = 0; i < segP->lastBackend; i++) {
         ProcState* stateP = &segP->procState[i];
-        int n = stateP->nextMsgNum;
+        int64 n = stateP->nextMsgNum;
 
         /* Ignore if inactive or already in reset state */
         if (stateP->procPid == 0 || stateP->resetState || stateP->sendOnly) {
@@ -803,27 +848,11 @@ void SICleanupQueue(bool callerHasWriteLock, int minFree)
 
     segP->minMsgNum = min;
 
-    /*
-     * When minMsgNum gets really large, decrement all message counters so as
-     * to forestall overflow of the counters.  This happens seldom enough that
-     * folding it into the previous loop would be a loser.
-     */
-    if (min >= MSGNUMWRAPAROUND) {
-        segP->minMsgNum -= MSGNUMWRAPAROUND;
-        segP->maxMsgNum -= MSGNUMWRAPAROUND;
-
-        for (i = 0; i < segP->lastBackend; i++) {
-            /* we don't bother skipping inactive entries here */
-            if (segP->procState[i].procPid != 0)
-                segP->procState[i].nextMsgNum -= MSGNUMWRAPAROUND;
-        }
-    }
-
     /*
      * Determine how many messages are still in the queue, and set the
      * threshold at which we should repeat SICleanupQueue().
      */
-    numMsgs = segP->maxMsgNum - segP->minMsgNum;
+    numMsgs = (int)(segP->maxMsgNum - segP->minMsgNum);
 
     if (numMsgs < CLEANUP_MIN) {
         segP->nextThreshold = CLEANUP_MIN;
@@ -132,21 +132,47 @@ typedef struct TwoPhaseLockRecord {
     LOCKMODE lockmode;
 } TwoPhaseLockRecord;
 
+/*
+ * Fast-path slot layout.  Slot n lives in group n / FP_LOCK_SLOTS_PER_GROUP
+ * and its lock modes are kept in that group's entry of proc->fpLockBits.
+ */
+#define FAST_PATH_GROUPS (g_instance.proc_base->fpLockGroupsPerBackend)
+#define FAST_PATH_SLOTS (FAST_PATH_GROUPS * FP_LOCK_SLOTS_PER_GROUP)
+#define FAST_PATH_SLOT(group, index) \
+    (AssertMacro((index) < FP_LOCK_SLOTS_PER_GROUP), (uint32)((group) * FP_LOCK_SLOTS_PER_GROUP + (index)))
+#define FAST_PATH_GROUP(n) ((n) / FP_LOCK_SLOTS_PER_GROUP)
+#define FAST_PATH_INDEX(n) ((n) % FP_LOCK_SLOTS_PER_GROUP)
+
+/*
+ * Group of a relation or partition lock.  The partition oid takes part in
+ * the hash so that the partitions of one table spread over all groups
+ * instead of competing for the slots of their parent's group.  Both
+ * multipliers are odd and FAST_PATH_GROUPS is a power of two, so
+ * consecutive oids map to distinct groups.
+ */
+#define FAST_PATH_REL_GROUP(relid, partitionid) \
+    ((uint32)(((uint64)(relid) * 49157 + (uint64)(partitionid) * 12289) & (FAST_PATH_GROUPS - 1)))
+#define FAST_PATH_TAG_GROUP(tag) FAST_PATH_REL_GROUP((tag).relid, (tag).partitionid)
+#define FAST_PATH_LOCKTAG_GROUP(locktag) FAST_PATH_REL_GROUP((locktag)->locktag_field2, (locktag)->locktag_field3)
+
 /* Macros for manipulating proc->fpLockBits */
 #define FAST_PATH_BITS_PER_SLOT 3
 #define FAST_PATH_LOCKNUMBER_OFFSET 1
 #define FAST_PATH_MASK ((1 << FAST_PATH_BITS_PER_SLOT) - 1)
-#define FAST_PATH_GET_BITS(proc, n) (((proc)->fpLockBits >> (FAST_PATH_BITS_PER_SLOT * (n))) & FAST_PATH_MASK)
+#define FAST_PATH_BITS(proc, n) (proc)->fpLockBits[FAST_PATH_GROUP(n)].bits
+#define FAST_PATH_GET_BITS(proc, n) \
+    ((FAST_PATH_BITS(proc, n) >> (FAST_PATH_BITS_PER_SLOT * FAST_PATH_INDEX(n))) & FAST_PATH_MASK)
 #define FAST_PATH_BIT_POSITION(n, l)                                           \
     (AssertMacro((l) >= FAST_PATH_LOCKNUMBER_OFFSET),                          \
      AssertMacro((l) < FAST_PATH_BITS_PER_SLOT + FAST_PATH_LOCKNUMBER_OFFSET), \
-     AssertMacro((n) < FP_LOCK_SLOTS_PER_BACKEND), ((l)-FAST_PATH_LOCKNUMBER_OFFSET + FAST_PATH_BITS_PER_SLOT * (n)))
+     AssertMacro((n) < FAST_PATH_SLOTS),                                       \
+     ((l)-FAST_PATH_LOCKNUMBER_OFFSET + FAST_PATH_BITS_PER_SLOT * FAST_PATH_INDEX(n)))
 #define FAST_PATH_SET_LOCKMODE(proc, n, l) \
-    (proc)->fpLockBits |= UINT64CONST(UINT64CONST(1) << FAST_PATH_BIT_POSITION(n, l))
+    FAST_PATH_BITS(proc, n) |= UINT64CONST(UINT64CONST(1) << FAST_PATH_BIT_POSITION(n, l))
 #define FAST_PATH_CLEAR_LOCKMODE(proc, n, l) \
-    (proc)->fpLockBits &= ~(UINT64CONST(UINT64CONST(1) << FAST_PATH_BIT_POSITION(n, l)))
+    FAST_PATH_BITS(proc, n) &= ~(UINT64CONST(UINT64CONST(1) << FAST_PATH_BIT_POSITION(n, l)))
 #define FAST_PATH_CHECK_LOCKMODE(proc, n, l) \
-    ((proc)->fpLockBits & (UINT64CONST(UINT64CONST(1) << FAST_PATH_BIT_POSITION(n, l))))
+    (FAST_PATH_BITS(proc, n) & (UINT64CONST(UINT64CONST(1) << FAST_PATH_BIT_POSITION(n, l))))
 
 #define PRINT_WAIT_LENTH (8 + 1)
 
@@ -751,16 +777,16 @@ static LockAcquireResult LockAcquireExtendedXC(const LOCKTAG *locktag, LOCKMODE
 
     /*
      * Attempt to take lock via fast path, if eligible.  But if we remember
-     * having filled up the fast path array, we don't attempt to make any
-     * further use of it until we release some locks.  It's possible that some
-     * other backend has transferred some of those locks to the shared hash
-     * table, leaving space free, but it's not worth acquiring the LWLock just
-     * to check.  It's also possible that we're acquiring a second or third
+     * having filled up the fast path group of this relation, we don't attempt
+     * to make any further use of it until we release some locks.  It's
+     * possible that some other backend has transferred some of those locks to
+     * the shared hash table, leaving space free, but it's not worth acquiring
+     * the LWLock just to check.  It's also possible that we're acquiring a second or third
      * lock type on a relation we have already locked using the fast-path, but
      * for now we don't worry about that case either.
      */
     if (EligibleForRelationFastPath(locktag, lockmode) &&
-        t_thrd.storage_cxt.FastPathLocalUseCount < FP_LOCK_SLOTS_PER_BACKEND) {
+        t_thrd.storage_cxt.FastPathLocalUseCounts[FAST_PATH_LOCKTAG_GROUP(locktag)] < FP_LOCK_SLOTS_PER_GROUP) {
         uint32 fasthashcode = FastPathStrongLockHashPartition(hashcode);
         bool acquired = false;
 
@@ -1813,7 +1839,8 @@ bool LockRelease(const LOCKTAG *locktag, LOCKMODE lockmode, bool sessionLock)
         return TRUE;
 
     /* Attempt fast release of any lock eligible for the fast path. */
-    if (EligibleForRelationFastPath(locktag, lockmode) && t_thrd.storage_cxt.FastPathLocalUseCount > 0) {
+    if (EligibleForRelationFastPath(locktag, lockmode) &&
+        t_thrd.storage_cxt.FastPathLocalUseCounts[FAST_PATH_LOCKTAG_GROUP(locktag)] > 0) {
         bool released = false;
         FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
 
@@ -2133,16 +2160,21 @@ void LockReleaseAll(LOCKMETHODID lockmethodid, bool allLocks)
 void Check_FastpathBit()
 {
     uint32 f;
+    uint32 group;
     bool leaked = false;
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    errno_t rc;
+    for (f = 0; f < FAST_PATH_SLOTS; f++) {
         if (FAST_PATH_GET_BITS(t_thrd.proc, f) != 0) {
             Assert(0);
             leaked = true;
         }
     }
     /* reset fastpath bit num and use count, also report leak */
-    t_thrd.storage_cxt.FastPathLocalUseCount = 0;
-    t_thrd.proc->fpLockBits = 0;
+    rc = memset_s(t_thrd.storage_cxt.FastPathLocalUseCounts, sizeof(t_thrd.storage_cxt.FastPathLocalUseCounts), 0,
+                  sizeof(t_thrd.storage_cxt.FastPathLocalUseCounts));
+    securec_check(rc, "\0", "\0");
+    for (group = 0; group < FAST_PATH_GROUPS; group++)
+        t_thrd.proc->fpLockBits[group].bits = 0;
     if (leaked == true)
         ereport(WARNING, (errmsg("Fast path bit num leak.")));
 }
@@ -2290,15 +2322,19 @@ void LockReassignCurrentOwner(void)
 
 /*
  * FastPathGrantRelationLock
- *		Grant lock using per-backend fast-path array, if there is space.
+ *		Grant lock using per-backend fast-path array, if there is space in
+ *		the group of the relation.
  */
 static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 {
-    uint32 f;
-    uint32 unused_slot = FP_LOCK_SLOTS_PER_BACKEND;
+    uint32 i;
+    uint32 group = FAST_PATH_TAG_GROUP(tag);
+    uint32 unused_slot = FAST_PATH_SLOTS;
 
     /* Scan for existing entry for this relid, remembering empty slot. */
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    for (i = 0; i < FP_LOCK_SLOTS_PER_GROUP; i++) {
+        uint32 f = FAST_PATH_SLOT(group, i);
+
         if (FAST_PATH_GET_BITS(t_thrd.proc, f) == 0)
             unused_slot = f;
         else if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag)) {
@@ -2309,10 +2345,10 @@ static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
     }
 
     /* If no existing entry, use any empty slot. */
-    if (unused_slot < FP_LOCK_SLOTS_PER_BACKEND) {
+    if (unused_slot < FAST_PATH_SLOTS) {
         t_thrd.proc->fpRelId[unused_slot] = tag;
         FAST_PATH_SET_LOCKMODE(t_thrd.proc, unused_slot, lockmode);
-        ++t_thrd.storage_cxt.FastPathLocalUseCount;
+        ++t_thrd.storage_cxt.FastPathLocalUseCounts[group];
         return true;
     }
 
@@ -2327,19 +2363,22 @@ static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
  */
 static bool FastPathUnGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 {
-    uint32 f;
+    uint32 i;
+    uint32 group = FAST_PATH_TAG_GROUP(tag);
     bool result = false;
 
-    t_thrd.storage_cxt.FastPathLocalUseCount = 0;
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    t_thrd.storage_cxt.FastPathLocalUseCounts[group] = 0;
+    for (i = 0; i < FP_LOCK_SLOTS_PER_GROUP; i++) {
+        uint32 f = FAST_PATH_SLOT(group, i);
+
         if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag) && FAST_PATH_CHECK_LOCKMODE(t_thrd.proc, f, lockmode)) {
             Assert(!result);
             FAST_PATH_CLEAR_LOCKMODE(t_thrd.proc, f, lockmode);
             result = true;
-            /* we continue iterating so as to update FastPathLocalUseCount */
+            /* we continue iterating so as to update FastPathLocalUseCounts */
         }
         if (FAST_PATH_GET_BITS(t_thrd.proc, f) != 0)
-            ++t_thrd.storage_cxt.FastPathLocalUseCount;
+            ++t_thrd.storage_cxt.FastPathLocalUseCounts[group];
     }
     return result;
 }
@@ -2355,6 +2394,7 @@ static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCK
 {
     LWLock *partitionLock = LockHashPartitionLock(hashcode);
     FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
+    uint32 group = FAST_PATH_TAG_GROUP(tag);
     uint32 i;
 
     /*
@@ -2365,11 +2405,13 @@ static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCK
      */
     for (i = 0; i < g_instance.proc_base->allNonPreparedProcCount; i++) {
         PGPROC *proc = g_instance.proc_base_all_procs[i];
-        uint32 f;
+        uint32 j;
 
         LWLockAcquire(proc->backendLock, LW_EXCLUSIVE);
 
-        for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+        /* A relation can only have been entered into its own group. */
+        for (j = 0; j < FP_LOCK_SLOTS_PER_GROUP; j++) {
+            uint32 f = FAST_PATH_SLOT(group, j);
             uint32 lockmode;
 
             /* Look for an allocated slot matching the given relid. */
@@ -2414,11 +2456,13 @@ static PROCLOCK *FastPathGetRelationLockEntry(LOCALLOCK *locallock)
     PROCLOCK *proclock = NULL;
     LWLock *partitionLock = LockHashPartitionLock(locallock->hashcode);
     FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
-    uint32 f;
+    uint32 group = FAST_PATH_TAG_GROUP(tag);
+    uint32 i;
 
     LWLockAcquire(t_thrd.proc->backendLock, LW_EXCLUSIVE);
 
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    for (i = 0; i < FP_LOCK_SLOTS_PER_GROUP; i++) {
+        uint32 f = FAST_PATH_SLOT(group, i);
         uint32 lockmode;
 
         /* Look for an allocated slot matching the given relid. */
@@ -2536,6 +2580,7 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
     if (ConflictsWithRelationFastPath(locktag, lockmode)) {
         int i;
         FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
+        uint32 group = FAST_PATH_TAG_GROUP(tag);
         VirtualTransactionId vxid;
 
         /*
@@ -2550,7 +2595,7 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
          */
         for (i = 0; (unsigned int)(i) < g_instance.proc_base->allNonPreparedProcCount; i++) {
             PGPROC *proc = g_instance.proc_base_all_procs[i];
-            uint32 f;
+            uint32 j;
 
             /* A backend never blocks itself */
             if (proc == t_thrd.proc)
@@ -2558,7 +2603,8 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
 
             LWLockAcquire(proc->backendLock, LW_SHARED);
 
-            for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+            for (j = 0; j < FP_LOCK_SLOTS_PER_GROUP; j++) {
+                uint32 f = FAST_PATH_SLOT(group, j);
                 uint32 lockmask;
 
                 /* Look for an allocated slot matching the given relid. */
@@ -3128,7 +3174,7 @@ LockData *GetLockStatusData(void)
 
         LWLockAcquire(proc->backendLock, LW_SHARED);
 
-        for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; ++f) {
+        for (f = 0; f < FAST_PATH_SLOTS; ++f) {
             LockInstanceData *instance = NULL;
             uint32 lockbits = FAST_PATH_GET_BITS(proc, f);
 
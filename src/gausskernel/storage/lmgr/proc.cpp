@@ -227,6 +227,9 @@ void InitProcGlobal(void)
     PGPROC **procs = NULL;
     int i, j;
     uint32 TotalProcs = (uint32)(GLOBAL_ALL_PROCS);
+    uint32 fpLockGroups = 1;
+    FastPathGroupBits *fpLockBits = NULL;
+    FastPathTag *fpRelIds = NULL;
 
     MemoryContext oldContext = MemoryContextSwitchTo(g_instance.instance_context);
     /* Create the g_instance.proc_base shared structure */
@@ -309,6 +312,23 @@ void InitProcGlobal(void)
     g_instance.proc_base->allPgXact =
         (PGXACT *)CACHELINEALIGN(palloc0(TotalProcs * sizeof(PGXACT) + PG_CACHE_LINE_SIZE));
 
+    /*
+     * Size the fast-path lock arrays so that every backend can hold about
+     * max_locks_per_transaction weak relation locks without touching the
+     * shared lock table.  The number of groups must be a power of two, see
+     * FAST_PATH_REL_GROUP.  Prepared xact dummy PGPROCs never take fast-path
+     * locks and get no slots.
+     */
+    while (fpLockGroups < FP_LOCK_GROUPS_PER_BACKEND_MAX &&
+           fpLockGroups * FP_LOCK_SLOTS_PER_GROUP < (uint32)g_instance.attr.attr_storage.max_locks_per_xact)
+        fpLockGroups *= 2;
+    g_instance.proc_base->fpLockGroupsPerBackend = fpLockGroups;
+    fpLockBits = (FastPathGroupBits *)CACHELINEALIGN(palloc0(g_instance.proc_base->allNonPreparedProcCount *
+                                                             fpLockGroups * sizeof(FastPathGroupBits) +
+                                                             PG_CACHE_LINE_SIZE));
+    fpRelIds = (FastPathTag *)palloc0(g_instance.proc_base->allNonPreparedProcCount * fpLockGroups *
+                                      FP_LOCK_SLOTS_PER_GROUP * sizeof(FastPathTag));
+
     for (i = 0; (unsigned int)(i) < TotalProcs; i++) {
         /* Common initialization for all PGPROCs, regardless of type.
          *
@@ -320,6 +340,8 @@ void InitProcGlobal(void)
             PGSemaphoreCreate(&(procs[i]->sem));
             InitSharedLatch(&(procs[i]->procLatch));
             procs[i]->backendLock = LWLockAssign(LWTRANCHE_PROC);
+            procs[i]->fpLockBits = &fpLockBits[i * fpLockGroups];
+            procs[i]->fpRelId = &fpRelIds[i * fpLockGroups * FP_LOCK_SLOTS_PER_GROUP];
         }
         /*
          * Starting from MaxBackends + NUM_AUXILIARY_PROCS, subxidsLock could still be used by prepared xacts.
@@ -558,7 +580,8 @@ void InitProcess(void)
     t_thrd.proc->lxid = InvalidLocalTransactionId;
     t_thrd.proc->fpVXIDLock = false;
     t_thrd.proc->fpLocalTransactionId = InvalidLocalTransactionId;
-    t_thrd.proc->fpLockBits = 0;
+    for (uint32 group = 0; group < procglobal->fpLockGroupsPerBackend; group++)
+        t_thrd.proc->fpLockBits[group].bits = 0;
     t_thrd.proc->commitCSN = 0;
     t_thrd.pgxact->handle = InvalidTransactionHandle;
     t_thrd.pgxact->xid = InvalidTransactionId;
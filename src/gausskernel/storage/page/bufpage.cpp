@@ -269,15 +269,20 @@ void PageLocalUpgrade(Page page)
 static inline void AllocPageCopyMem()
 {
     if (t_thrd.storage_cxt.pageCopy == NULL) {
-        ADIO_RUN()
+        /*
+         * The copy lives as long as the thread, so it cannot come from
+         * AlignMemoryContext, which is reset when a transaction aborts.
+         */
+        DIO_RUN()
         {
-            t_thrd.storage_cxt.pageCopy = (char*)adio_align_alloc(BLCKSZ);
+            char* mem = (char*)MemoryContextAlloc(t_thrd.top_mem_cxt, BLCKSZ + ALIGNOF_BUFFER);
+            t_thrd.storage_cxt.pageCopy = (char*)BUFFERALIGN(mem);
         }
-        ADIO_ELSE()
+        DIO_ELSE()
         {
             t_thrd.storage_cxt.pageCopy = (char*)MemoryContextAlloc(t_thrd.top_mem_cxt, BLCKSZ);
         }
-        ADIO_END();
+        DIO_END();
     }
 }
 
@@ -134,15 +134,15 @@ void createBCMFile(Relation rel, int col)
 {
     Page bcmHeader;
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         bcmHeader = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         bcmHeader = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     PageInit(bcmHeader, BLCKSZ, 0);
     BCMHeader* hd = NULL;
@@ -170,16 +170,16 @@ void createBCMFile(Relation rel, int col)
     /* Now extend the file */
     smgrextend(rel->rd_smgr, forknum, 0, (char*)bcmHeader, false);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         adio_align_free(bcmHeader);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree(bcmHeader);
         bcmHeader = NULL;
     }
-    ADIO_END();
+    DIO_END();
 }
 
 void BCMLogCU(Relation rel, uint64 offset, int col, BCMBitStatus status, int count)
@@ -628,15 +628,15 @@ static void BCM_extend(Relation rel, BlockNumber bcm_nblocks, int col)
     Page pg;
     ForkNumber forknum = BCM_FORKNUM;
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         pg = (Page)adio_align_alloc(BLCKSZ);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pg = (Page)palloc(BLCKSZ);
     }
-    ADIO_END();
+    DIO_END();
 
     PageInit(pg, BLCKSZ, 0);
 
@@ -697,16 +697,16 @@ static void BCM_extend(Relation rel, BlockNumber bcm_nblocks, int col)
 
     UnlockRelationForExtension(rel, ExclusiveLock);
 
-    ADIO_RUN();
+    DIO_RUN();
     {
         adio_align_free(pg);
     }
-    ADIO_ELSE()
+    DIO_ELSE()
     {
         pfree(pg);
         pg = NULL;
     }
-    ADIO_END();
+    DIO_END();
 }
 
 /* Read bcm page */
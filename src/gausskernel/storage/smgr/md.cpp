@@ -19,6 +19,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/file.h>
+#include <limits.h>
 
 #include "miscadmin.h"
 #include "access/transam.h"
@@ -254,11 +255,11 @@ void mdcreate(SMgrRelation reln, ForkNumber forkNum, bool isRedo)
 
     filenode = RelFileNodeForkNumFill(reln->smgr_rnode, forkNum, 0);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         flags |= O_DIRECT;
     }
-    ADIO_END();
+    DIO_END();
 
     fd = DataFileIdOpenFile(path, filenode, (int)flags, 0600);
     if (fd < 0) {
@@ -277,15 +278,15 @@ void mdcreate(SMgrRelation reln, ForkNumber forkNum, bool isRedo)
          */
         if (isRedo || IsBootstrapProcessingMode() ||
             (u_sess->attr.attr_common.IsInplaceUpgrade && filenode.rnode.node.relNode < FirstNormalObjectId)) {
-            ADIO_RUN()
+            DIO_RUN()
             {
                 flags = O_RDWR | PG_BINARY | O_DIRECT | (u_sess->attr.attr_common.IsInplaceUpgrade ? O_TRUNC : 0);
             }
-            ADIO_ELSE()
+            DIO_ELSE()
             {
                 flags = O_RDWR | PG_BINARY | (u_sess->attr.attr_common.IsInplaceUpgrade ? O_TRUNC : 0);
             }
-            ADIO_END();
+            DIO_END();
 
             fd = DataFileIdOpenFile(path, filenode, (int)flags, 0600);
         }
@@ -383,6 +384,9 @@ static void mdunlinkfork(const RelFileNodeBackend& rnode, ForkNumber forkNum, bo
 
     path = relpath(rnode, forkNum);
 
+    /* don't let an idle cached fd keep the file's space allocated */
+    ForgetDataFileIdCache(RelFileNodeForkNumFill(rnode, forkNum, 0));
+
     /*
      * Delete or truncate the first segment.
      */
@@ -429,6 +433,7 @@ static void mdunlinkfork(const RelFileNodeBackend& rnode, ForkNumber forkNum, bo
         for (segno = 1;; segno++) {
             rc = sprintf_s(segpath, strlen(path) + 12, "%s.%u", path, segno);
             securec_check_ss(rc, "", "");
+            ForgetDataFileIdCache(RelFileNodeForkNumFill(rnode, forkNum, segno));
             if (unlink(segpath) < 0) {
                 /* ENOENT is expected after the last segment... */
                 if (errno != ENOENT) {
@@ -545,11 +550,11 @@ static MdfdVec* mdopen(SMgrRelation reln, ForkNumber forknum, ExtensionBehavior
 
     filenode = RelFileNodeForkNumFill(reln->smgr_rnode, forknum, 0);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         flags |= O_DIRECT;
     }
-    ADIO_END();
+    DIO_END();
 
     fd = DataFileIdOpenFile(path, filenode, (int)flags, 0600);
     if (fd < 0) {
@@ -961,6 +966,78 @@ do {\
     (c) = (value);\
 } while (0)
 
+/*
+ * Complain about a read of the given block that returned nbytes, unless it
+ * read the whole block.
+ */
+static void md_check_read(File vfd, BlockNumber blocknum, char* buffer, int nbytes)
+{
+    if (nbytes != BLCKSZ) {
+        if (nbytes < 0) {
+            ereport(ERROR,
+                (errcode_for_file_access(),
+                    errmsg("could not read block %u in file \"%s\": %m", blocknum, FilePathName(vfd))));
+        }
+        /*
+         * Short read: we are at or past EOF, or we read a partial block at
+         * EOF.  Normally this is an error; upper levels should never try to
+         * read a nonexistent block.  However, if zero_damaged_pages is ON or
+         * we are InRecovery, we should instead return zeroes without
+         * complaining.  This allows, for example, the case of trying to
+         * update a block that was later truncated away.
+         */
+        if (u_sess->attr.attr_security.zero_damaged_pages || t_thrd.xlog_cxt.InRecovery) {
+            MemSet(buffer, 0, BLCKSZ);
+        } else {
+            check_file_stat(FilePathName(vfd));
+            force_backtrace_messages = true;
+            ereport(ERROR,
+                (errcode(ERRCODE_DATA_CORRUPTED),
+                    errmsg("could not read block %u in file \"%s\": read only %d of %d bytes",
+                        blocknum,
+                        FilePathName(vfd),
+                        nbytes,
+                        BLCKSZ)));
+        }
+    }
+}
+
+/*
+ * Complain about a write of the given block that returned nbytes, unless it
+ * wrote the whole block.
+ */
+static void md_check_write(File vfd, BlockNumber blocknum, int nbytes)
+{
+    if (nbytes != BLCKSZ) {
+        if (nbytes < 0) {
+            ereport(ERROR,
+                (errcode_for_file_access(),
+                    errmsg("could not write block %u in file \"%s\": %m",
+                        blocknum, FilePathName(vfd))));
+        }
+        /* short write: complain appropriately */
+        ereport(ERROR,
+            (errcode(ERRCODE_DISK_FULL),
+                errmsg("could not write block %u in file \"%s\": wrote only %d of %d bytes",
+                    blocknum, FilePathName(vfd), nbytes, BLCKSZ),
+                errhint("Check free disk space.")));
+    }
+}
+
+/* Fill in the parts of an asynchronous block request common to reads and writes. */
+static void md_prepare_io(SMgrAioRequest* req, SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, MdfdVec* v)
+{
+    errno_t rc = memset_s(req, sizeof(SMgrAioRequest), 0, sizeof(SMgrAioRequest));
+    securec_check(rc, "", "");
+
+    req->reln = reln;
+    req->forknum = forknum;
+    req->blocknum = blocknum;
+    req->io.file = v->mdfd_vfd;
+    req->io.amount = BLCKSZ;
+    req->io.offset = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
+}
+
 /*
  *  mdread() -- Read the specified block from a relation.
  */
@@ -1053,34 +1130,7 @@ void mdread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* b
         max_time = time_diff;
     }
 
-    if (nbytes != BLCKSZ) {
-        if (nbytes < 0) {
-            ereport(ERROR,
-                (errcode_for_file_access(),
-                    errmsg("could not read block %u in file \"%s\": %m", blocknum, FilePathName(v->mdfd_vfd))));
-        }
-        /*
-         * Short read: we are at or past EOF, or we read a partial block at
-         * EOF.  Normally this is an error; upper levels should never try to
-         * read a nonexistent block.  However, if zero_damaged_pages is ON or
-         * we are InRecovery, we should instead return zeroes without
-         * complaining.  This allows, for example, the case of trying to
-         * update a block that was later truncated away.
-         */
-        if (u_sess->attr.attr_security.zero_damaged_pages || t_thrd.xlog_cxt.InRecovery) {
-            MemSet(buffer, 0, BLCKSZ);
-        } else {
-            check_file_stat(FilePathName(v->mdfd_vfd));
-            force_backtrace_messages = true;
-            ereport(ERROR,
-                (errcode(ERRCODE_DATA_CORRUPTED),
-                    errmsg("could not read block %u in file \"%s\": read only %d of %d bytes",
-                        blocknum,
-                        FilePathName(v->mdfd_vfd),
-                        nbytes,
-                        BLCKSZ)));
-        }
-    }
+    md_check_read(v->mdfd_vfd, blocknum, buffer, nbytes);
 }
 
 /*
@@ -1182,23 +1232,111 @@ void mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const
         max_time = time_diff;
     }
 
-    if (nbytes != BLCKSZ) {
+    md_check_write(v->mdfd_vfd, blocknum, nbytes);
+
+    if (!skipFsync && !SmgrIsTemp(reln)) {
+        register_dirty_segment(reln, forknum, v);
+    }
+}
+
+/*
+ *  mdreadv() -- Read consecutive blocks of a relation into the supplied
+ *  buffers, with one preadv() per segment.
+ *
+ *  Returns how many of the leading blocks were read in full.  Unlike mdread()
+ *  nothing is reported here: the caller leaves the other blocks for mdread()
+ *  to read again and complain about.
+ */
+int mdreadv(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char** buffers, int nblocks)
+{
+    struct iovec* iov = (struct iovec*)palloc(sizeof(struct iovec) * Min(nblocks, IOV_MAX));
+    int done = 0;
+
+    while (done < nblocks) {
+        BlockNumber blkno = blocknum + (BlockNumber)done;
+        MdfdVec* v = _mdfd_getseg(reln, forknum, blkno, false, EXTENSION_RETURN_NULL);
+        int count = Min(nblocks - done, (int)(RELSEG_SIZE - blkno % ((BlockNumber)RELSEG_SIZE)));
+        int nbytes;
+
+        if (v == NULL) {
+            break;
+        }
+
+        count = Min(count, IOV_MAX);
+        for (int i = 0; i < count; i++) {
+            iov[i].iov_base = buffers[done + i];
+            iov[i].iov_len = BLCKSZ;
+        }
+
+        nbytes = FilePReadV(v->mdfd_vfd, iov, count, (off_t)BLCKSZ * (blkno % ((BlockNumber)RELSEG_SIZE)),
+            WAIT_EVENT_DATA_FILE_READ);
         if (nbytes < 0) {
-            ereport(ERROR,
-                (errcode_for_file_access(),
-                    errmsg("could not write block %u in file \"%s\": %m",
-                        blocknum, FilePathName(v->mdfd_vfd))));
+            break;
+        }
+        done += nbytes / BLCKSZ;
+        if (nbytes < count * BLCKSZ) {
+            break;
         }
-        /* short write: complain appropriately */
-        ereport(ERROR,
-            (errcode(ERRCODE_DISK_FULL),
-                errmsg("could not write block %u in file \"%s\": wrote only %d of %d bytes",
-                    blocknum, FilePathName(v->mdfd_vfd), nbytes, BLCKSZ),
-                errhint("Check free disk space.")));
     }
 
-    if (!skipFsync && !SmgrIsTemp(reln)) {
-        register_dirty_segment(reln, forknum, v);
+    pfree(iov);
+    return done;
+}
+
+/*
+ *  mdstartread() -- Start reading the specified block of a relation.
+ */
+void mdstartread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer, SMgrAioRequest* req)
+{
+    MdfdVec* v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+
+    md_prepare_io(req, reln, forknum, blocknum, v);
+    req->io.op = FILE_AIO_READ;
+    req->io.buffer = buffer;
+    req->io.wait_event_info = WAIT_EVENT_DATA_FILE_READ;
+    FileAioSubmit(&req->io);
+}
+
+/*
+ *  mdstartwrite() -- Start writing the supplied block at the appropriate
+ *  location; see mdwrite().
+ */
+void mdstartwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync,
+    SMgrAioRequest* req)
+{
+    MdfdVec* v = _mdfd_getseg(reln, forknum, blocknum, skipFsync, EXTENSION_FAIL);
+
+    md_prepare_io(req, reln, forknum, blocknum, v);
+    req->skipFsync = skipFsync;
+    req->io.op = FILE_AIO_WRITE;
+    req->io.buffer = (char*)buffer;
+    req->io.wait_event_info = WAIT_EVENT_DATA_FILE_WRITE;
+    FileAioSubmit(&req->io);
+}
+
+/*
+ *  mdfinishio() -- Check the outcome of a completed mdstartread() or
+ *  mdstartwrite() just as mdread() and mdwrite() do.
+ */
+void mdfinishio(SMgrAioRequest* req)
+{
+    FileAioRequest* io = &req->io;
+
+    errno = io->error;
+    if (io->op == FILE_AIO_READ) {
+        md_check_read(io->file, req->blocknum, io->buffer, io->result);
+        return;
+    }
+
+    md_check_write(io->file, req->blocknum, io->result);
+
+    /*
+     * Remember the segment only now that the data is written, since if the
+     * request cannot be forwarded the segment is fsynced right away.
+     */
+    if (!req->skipFsync && !SmgrIsTemp(req->reln)) {
+        MdfdVec* v = _mdfd_getseg(req->reln, req->forknum, req->blocknum, true, EXTENSION_FAIL);
+        register_dirty_segment(req->reln, req->forknum, v);
     }
 }
 
@@ -1367,6 +1505,9 @@ void mdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
 void mdimmedsync(SMgrRelation reln, ForkNumber forknum)
 {
     MdfdVec* v = NULL;
+    FileAioRequest* reqs = NULL;
+    int nsegs = 0;
+    int i;
 
     /*
      * NOTE: mdnblocks makes sure we have opened all active segments, so that
@@ -1376,13 +1517,29 @@ void mdimmedsync(SMgrRelation reln, ForkNumber forknum)
 
     v = mdopen(reln, forknum, EXTENSION_FAIL);
 
-    while (v != NULL) {
-        if (FileSync(v->mdfd_vfd, WAIT_EVENT_DATA_FILE_IMMEDIATE_SYNC) < 0) {
+    for (MdfdVec* seg = v; seg != NULL; seg = seg->mdfd_chain) {
+        nsegs++;
+    }
+
+    /* start all the fsyncs first, so a multi-segment relation is flushed in parallel */
+    reqs = (FileAioRequest*)palloc0(nsegs * sizeof(FileAioRequest));
+    for (i = 0; v != NULL; v = v->mdfd_chain, i++) {
+        reqs[i].op = FILE_AIO_FSYNC;
+        reqs[i].file = v->mdfd_vfd;
+        reqs[i].wait_event_info = WAIT_EVENT_DATA_FILE_IMMEDIATE_SYNC;
+        FileAioSubmit(&reqs[i]);
+    }
+
+    for (i = 0; i < nsegs; i++) {
+        FileAioWait(&reqs[i]);
+        if (reqs[i].result < 0) {
+            errno = reqs[i].error;
             ereport(data_sync_elevel(ERROR),
-                (errcode_for_file_access(), errmsg("could not fsync file \"%s\": %m", FilePathName(v->mdfd_vfd))));
+                (errcode_for_file_access(), errmsg("could not fsync file \"%s\": %m", FilePathName(reqs[i].file))));
         }
-        v = v->mdfd_chain;
     }
+
+    pfree(reqs);
 }
 
 /*
@@ -1710,6 +1867,11 @@ void mdpostckpt(void)
         }
         
         /* Unlink the file */
+        RelFileNodeBackend rnode;
+        rnode.node = entry->rnode;
+        rnode.backend = InvalidBackendId;
+        ForgetDataFileIdCache(RelFileNodeForkNumFill(rnode, MAIN_FORKNUM, 0));
+
         path = relpathperm(entry->rnode, MAIN_FORKNUM);
         if (unlink(path) < 0) {
             /*
@@ -2086,11 +2248,11 @@ static MdfdVec* _mdfd_openseg(SMgrRelation reln, ForkNumber forknum, BlockNumber
 
     filenode = RelFileNodeForkNumFill(reln->smgr_rnode, forknum, segno);
 
-    ADIO_RUN()
+    DIO_RUN()
     {
         oflags |= O_DIRECT;
     }
-    ADIO_END();
+    DIO_END();
 
     /* open the file */
     fd = DataFileIdOpenFile(fullpath, filenode, O_RDWR | PG_BINARY | oflags, 0600);
@@ -2157,29 +2319,29 @@ static MdfdVec* _mdfd_getseg(
             if (behavior == EXTENSION_CREATE || t_thrd.xlog_cxt.InRecovery) {
                 if (_mdnblocks(reln, forknum, v) < RELSEG_SIZE) {
                     char* zerobuf = NULL;
-                    ADIO_RUN()
+                    DIO_RUN()
                     {
                         zerobuf = (char*)adio_align_alloc(BLCKSZ);
                         errorno = memset_s(zerobuf, BLCKSZ, 0, BLCKSZ);
                         securec_check_c(errorno, "", "");
                     }
-                    ADIO_ELSE()
+                    DIO_ELSE()
                     {
                         zerobuf = (char*)palloc0(BLCKSZ);
                     }
-                    ADIO_END();
+                    DIO_END();
 
                     mdextend(reln, forknum, nextsegno * ((BlockNumber)RELSEG_SIZE) - 1, zerobuf, skipFsync);
 
-                    ADIO_RUN()
+                    DIO_RUN()
                     {
                         adio_align_free(zerobuf);
                     }
-                    ADIO_ELSE()
+                    DIO_ELSE()
                     {
                         pfree(zerobuf);
                     }
-                    ADIO_END();
+                    DIO_END();
                 }
                 v->mdfd_chain = _mdfd_openseg(reln, forknum, +nextsegno, O_CREAT);
             } else {
@@ -61,6 +61,12 @@ typedef struct f_smgr {
     void (*smgr_post_ckpt)(void); /* may be NULL */
     void (*smgr_async_read)(SMgrRelation reln, ForkNumber forknum, AioDispatchDesc_t** dList, int32 dn);
     void (*smgr_async_write)(SMgrRelation reln, ForkNumber forknum, AioDispatchDesc_t** dList, int32 dn);
+    int (*smgr_readv)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char** buffers, int nblocks);
+    void (*smgr_start_read)(
+        SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer, SMgrAioRequest* req);
+    void (*smgr_start_write)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer,
+        bool skipFsync, SMgrAioRequest* req);
+    void (*smgr_finish_io)(SMgrAioRequest* req);
 } f_smgr;
 
 static const f_smgr g_smgrsw[] = {
@@ -83,7 +89,11 @@ static const f_smgr g_smgrsw[] = {
         mdsync,
         mdpostckpt,
         mdasyncread,
-        mdasyncwrite}};
+        mdasyncwrite,
+        mdreadv,
+        mdstartread,
+        mdstartwrite,
+        mdfinishio}};
 
 static const int SMGRSW_LENGTH = lengthof(g_smgrsw);
 
@@ -546,6 +556,72 @@ void smgrasyncwrite(SMgrRelation reln, ForkNumber forknum, AioDispatchDesc_t** d
     (*(g_smgrsw[reln->smgr_which].smgr_async_write))(reln, forknum, dList, dn);
 }
 
+/*
+ *  smgrreadv() -- Read nblocks consecutive blocks of a relation, starting
+ *  at blocknum, into the supplied buffers.
+ *
+ *  Returns how many of the leading blocks were read in full.  Read errors
+ *  are not reported; the remaining buffers are simply not filled.
+ */
+int smgrreadv(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char** buffers, int nblocks)
+{
+    return (*(g_smgrsw[reln->smgr_which].smgr_readv))(reln, forknum, blocknum, buffers, nblocks);
+}
+
+/*
+ *  smgrstartread() -- Start reading a block of a relation into the
+ *  supplied buffer.
+ *
+ *  The read is complete, and checked as smgrread() would, once
+ *  smgrpollio() returns true or smgrwaitio() returns.
+ */
+void smgrstartread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer, SMgrAioRequest* req)
+{
+    req->finished = false;
+    (*(g_smgrsw[reln->smgr_which].smgr_start_read))(reln, forknum, blocknum, buffer, req);
+}
+
+/*
+ *  smgrstartwrite() -- Start writing the supplied buffer to a block of a
+ *  relation, as smgrwrite() does.
+ */
+void smgrstartwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer,
+    bool skipFsync, SMgrAioRequest* req)
+{
+    req->finished = false;
+    (*(g_smgrsw[reln->smgr_which].smgr_start_write))(reln, forknum, blocknum, buffer, skipFsync, req);
+}
+
+static void smgrfinishio(SMgrAioRequest* req)
+{
+    if (!req->finished) {
+        req->finished = true;
+        (*(g_smgrsw[req->reln->smgr_which].smgr_finish_io))(req);
+    }
+}
+
+/*
+ *  smgrpollio() -- Return true if a started read or write has completed,
+ *  without blocking.  Errors are reported the first time it does.
+ */
+bool smgrpollio(SMgrAioRequest* req)
+{
+    if (!FileAioPoll(&req->io)) {
+        return false;
+    }
+    smgrfinishio(req);
+    return true;
+}
+
+/*
+ *  smgrwaitio() -- Wait for a started read or write to complete.
+ */
+void smgrwaitio(SMgrAioRequest* req)
+{
+    FileAioWait(&req->io);
+    smgrfinishio(req);
+}
+
 /*
  * smgrread() -- read a particular block from a relation into the supplied buffer.
  * 
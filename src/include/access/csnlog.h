@@ -22,6 +22,7 @@
 #define CSNBufMappingPartitionLockByIndex(i) (&t_thrd.shemem_ptr_cxt.mainLWLockArray[FirstCSNBufMappingLock + i].lock)
 
 extern void CSNLogSetCommitSeqNo(TransactionId xid, int nsubxids, TransactionId* subxids, CommitSeqNo csn);
+extern void CSNLogSetCommitSeqNoBatch(int nxids, const TransactionId* xids, const CommitSeqNo* csns);
 extern CommitSeqNo CSNLogGetCommitSeqNo(TransactionId xid);
 extern CommitSeqNo CSNLogGetNestCommitSeqNo(TransactionId xid);
 extern TransactionId CSNLogGetNextInProgressXid(TransactionId start, TransactionId end);
@@ -77,7 +77,9 @@ void hbkt_tbl_getpage(AbsTblScanDesc scan, BlockNumber page);
 
 void hbkt_tbl_init_parallel_seqscan(AbsTblScanDesc scan, int32 dop, ScanDirection dir);
 
-List *hbkt_load_buckets(Relation relation, BucketInfo *bktInfo);
+List *hbkt_load_buckets(Relation relation, BucketInfo *bktInfo, ScanState *state = NULL, bool rescan = false);
+
+bool hbkt_reload_pruned_buckets(Relation relation, ScanState *state, List **bucketList);
 
 bool hbkt_tbl_tid_nextbucket(HBktTblScanDesc hpScan);
 
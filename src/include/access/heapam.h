@@ -32,6 +32,7 @@
 #define HEAP_INSERT_SPECULATIVE 0x0008
 
 typedef struct BulkInsertStateData* BulkInsertState;
+typedef struct HeapDirectLoadData* HeapDirectLoad;
 
 typedef enum { LockTupleShared, LockTupleExclusive } LockTupleMode;
 
@@ -137,6 +138,10 @@ extern void heap_inplace_update(Relation relation, HeapTuple tuple);
 extern bool heap_freeze_tuple(HeapTuple tuple, TransactionId cutoff_xid);
 extern bool heap_tuple_needs_freeze(HeapTuple tuple, TransactionId cutoff_xid, Buffer buf);
 
+extern HeapDirectLoad heap_begin_direct_load(Relation relation, CommandId cid, int options);
+extern void heap_direct_load_insert(HeapDirectLoad state, HeapTuple tup);
+extern void heap_end_direct_load(HeapDirectLoad state);
+
 extern Oid simple_heap_insert(Relation relation, HeapTuple tup);
 extern void simple_heap_delete(Relation relation, ItemPointer tid);
 extern void simple_heap_update(Relation relation, ItemPointer otid, HeapTuple tup);
@@ -18,6 +18,7 @@
 #include "access/htup.h"
 #include "utils/relcache.h"
 #include "storage/buf.h"
+#include "storage/bufpage.h"
 
 /*
  * state for bulk inserts --- private to heapam.c and hio.c
@@ -32,6 +33,23 @@ typedef struct BulkInsertStateData {
     Buffer current_buf;            /* current insertion target page */
 } BulkInsertStateData;
 
+/*
+ * state for heap_direct_load_insert()
+ *
+ * "typedef struct HeapDirectLoadData *HeapDirectLoad" is in heapam.h
+ */
+typedef struct HeapDirectLoadData {
+    Relation rel;           /* target relation, with a relfilenode new in this xact */
+    CommandId cid;          /* command id stamped on the loaded tuples */
+    int options;            /* HEAP_INSERT_xxx options for heap_prepare_insert */
+    bool use_wal;           /* log each finished page as a full-page image? */
+    TransactionId xid;      /* inserting transaction */
+    Size save_free_space;   /* free space to leave per page due to fillfactor */
+    Page page;              /* private page being filled */
+    bool page_valid;        /* page holds at least an initialized header */
+    BlockNumber blockno;    /* block number page will be written to */
+} HeapDirectLoadData;
+
 extern void RelationPutHeapTuple(Relation relation, Buffer buffer, HeapTuple tuple, TransactionId xid);
 extern Buffer RelationGetBufferForTuple(Relation relation, Size len, Buffer otherBuffer, int options,
     BulkInsertState bistate, Buffer* vmbuffer, Buffer* vmbuffer_other, BlockNumber end_rel_block);
@@ -33,6 +33,8 @@ extern void spi_printtup(TupleTableSlot* slot, DestReceiver* self);
 
 extern void printBatch(VectorBatch* batch, DestReceiver* self);
 extern void printtup(TupleTableSlot* slot, DestReceiver* self);
+extern bool printtupCanSendColumns(DestReceiver* self, TupleDesc typeinfo);
+extern void printtupColumns(DestReceiver* self, TupleDesc typeinfo, const Datum* values, const bool* isnull, int nrows);
 extern void printbatchStream(VectorBatch* batch, DestReceiver* self);
 extern void printtupStream(TupleTableSlot* slot, DestReceiver* self);
 extern void assembleStreamMessage(TupleTableSlot* slot, DestReceiver* self, StringInfo buf);
@@ -55,6 +57,7 @@ typedef struct {
     int nattrs;
     PrinttupAttrInfo* myinfo; /* Cached info about each attr */
     int16* formats;     /* format code for each column */
+    StringInfoData rowbuf; /* complete DataRow messages not yet handed to libpq */
 } DR_printtup;
 
 typedef struct {
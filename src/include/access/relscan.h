@@ -78,6 +78,7 @@ typedef struct HeapScanDescData {
     /* scan current state */
     bool rs_inited;        /* false = scan not init'd yet */
     BlockNumber rs_cblock; /* current block # in scan, if any */
+    BlockNumber rs_readahead_end; /* end of the blocks read ahead with direct I/O */
     TupleDesc rs_tupdesc;  /* heap tuple descriptor for rs_ctup */
     Buffer rs_cbuf;        /* current buffer in scan, if any */
     /* NB: if rs_cbuf is not InvalidBuffer, we hold a pin on that buffer */
@@ -112,6 +113,7 @@ typedef struct HBktTblScanDescData {
 	int      curr_slot;
 	Relation currBktRel;
 	HeapScanDescData* currBktScan;
+	int      bktDop;   /* SMP threads splitting hBktList by bucket, 0 if buckets are split by blocks */
 } HBktTblScanDescData;
 
 typedef HBktTblScanDescData* HBktTblScanDesc;
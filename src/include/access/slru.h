@@ -31,6 +31,14 @@
 /* Maximum length of an SLRU name */
 #define SLRU_MAX_NAME_LENGTH 64
 
+/*
+ * Buffer slots are divided into banks of SLRU_BANK_SIZE slots.  A page can
+ * only be cached in the bank its page number hashes to, so lookups and
+ * victim selection scan a single bank no matter how many slots the SLRU
+ * has.  SLRUs with no more than SLRU_BANK_SIZE slots use a single bank.
+ */
+#define SLRU_BANK_SIZE 16
+
 /*
  * Page status codes.  Note that these do not include the "dirty" bit.
  * page_dirty can be TRUE only in the VALID or WRITE_IN_PROGRESS states;
@@ -64,6 +72,10 @@ typedef struct SlruSharedData {
     /* Number of buffers managed by this SLRU structure */
     int num_slots;
 
+    /* Bank layout, see SLRU_BANK_SIZE; num_slots == num_banks * bank_size */
+    int num_banks;
+    int bank_size;
+
     /*
      * Arrays holding info for each buffer slot.  Page number is undefined
      * when status is EMPTY, as is page_lru_count.
@@ -87,15 +99,16 @@ typedef struct SlruSharedData {
     int lsn_groups_per_page;
 
     /* ----------
-     * We mark a page "most recently used" by setting
-     *		page_lru_count[slotno] = ++cur_lru_count;
-     * The oldest page is therefore the one with the highest value of
-     *		cur_lru_count - page_lru_count[slotno]
+     * Each bank keeps its own LRU clock.  We mark a page "most recently used"
+     * by setting
+     *		page_lru_count[slotno] = ++bank_cur_lru_count[bankno];
+     * The oldest page of a bank is therefore the one with the highest value of
+     *		bank_cur_lru_count[bankno] - page_lru_count[slotno]
      * The counts will eventually wrap around, but this calculation still
      * works as long as no page's age exceeds INT_MAX counts.
      * ----------
      */
-    int cur_lru_count;
+    int* bank_cur_lru_count;
 
     /*
      * latest_page_number is the page number of the current end of the log in PG,
@@ -215,13 +215,55 @@ extern HeapTuple toast_flatten_tuple(HeapTuple tup, TupleDesc tupleDesc);
  */
 extern Datum toast_flatten_tuple_attribute(Datum value, Oid typeId, int32 typeMod);
 
+/*
+ * TOAST compression methods.  The method of a compressed datum is kept in
+ * its header (see VARCMETHOD_4B_C), so these values are on-disk format and
+ * must never be renumbered.
+ */
+typedef enum ToastCompressionId {
+    TOAST_PGLZ_COMPRESSION_ID = 0,
+    TOAST_LZ4_COMPRESSION_ID = 1
+} ToastCompressionId;
+
+/* Size of the header of a compressed-in-line datum: varlena header and rawsize */
+#define TOAST_COMPRESS_HDRSZ ((int32)(VARHDRSZ + sizeof(uint32)))
+
 /* ----------
  * toast_compress_datum -
  *
- *	Create a compressed version of a varlena datum, if possible
+ *	Create a compressed version of a varlena datum with the given
+ *	ToastCompressionId, if possible
+ * ----------
+ */
+extern Datum toast_compress_datum(Datum value, int cmethod);
+
+/* ----------
+ * toast_decompress_datum -
+ *
+ *	Decompress a compressed-in-line datum, whatever its method
+ * ----------
+ */
+extern struct varlena* toast_decompress_datum(struct varlena* attr);
+
+/* ----------
+ * toast_get_compression_method -
+ *
+ *	The compression method for new values of attribute attnum of rel
+ * ----------
+ */
+extern int toast_get_compression_method(Relation rel, int attnum);
+extern int toast_get_attr_compression_method(Oid relid, int attnum);
+
+/* ----------
+ * toast_get_index_compression_method -
+ *
+ *	The compression method for in-line values of an index attribute,
+ *	taken from the table column it indexes
  * ----------
  */
-extern Datum toast_compress_datum(Datum value);
+extern int toast_get_index_compression_method(Form_pg_attribute att);
+
+extern int toast_compression_method_from_name(const char* name);
 
 /* ----------
  * toast_raw_datum_size -
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * simd_scan.h
+ *        Vectorized structural character scanning for text/csv loaders.
+ *
+ * COPY, the bulkload parser and the dfs text/csv readers only care about a
+ * handful of "structural" bytes in their input: EOL characters, quote,
+ * escape, backslash and, for some client encodings, multibyte lead bytes.
+ * Everything else is copied through untouched.  These helpers classify
+ * 64 input bytes at a time into a bitmap of structural positions (one bit
+ * per byte, bit i for byte i) so that callers can jump straight to the next
+ * byte that needs the per-character state machine.
+ *
+ * SSE2 is used on x86-64 and NEON on aarch64; other platforms use a scalar
+ * loop with identical results.  This header is self-contained because it is
+ * also built into gds.
+ *
+ * IDENTIFICATION
+ *        src/include/bulkload/simd_scan.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMD_SCAN_USE_NEON
+#elif defined(__x86_64__)
+#include <emmintrin.h>
+#define SIMD_SCAN_USE_SSE2
+#endif
+
+#define SIMD_SCAN_BLOCK 64   /* bytes classified by one SimdScanBlock() call */
+#define SIMD_SCAN_MAX_CHARS 8 /* structural characters per set */
+
+typedef struct SimdScanSet {
+    int nchars;
+    unsigned char chars[SIMD_SCAN_MAX_CHARS];
+    bool highbit; /* treat every byte with the high bit set as structural */
+} SimdScanSet;
+
+static inline void SimdScanSetInit(SimdScanSet* set)
+{
+    set->nchars = 0;
+    set->highbit = false;
+}
+
+/* Add c to the set; duplicates and '\0' are ignored */
+static inline void SimdScanSetAdd(SimdScanSet* set, char c)
+{
+    if (c == '\0')
+        return;
+    for (int i = 0; i < set->nchars; i++) {
+        if (set->chars[i] == (unsigned char)c)
+            return;
+    }
+    if (set->nchars < SIMD_SCAN_MAX_CHARS)
+        set->chars[set->nchars++] = (unsigned char)c;
+}
+
+static inline bool SimdScanIsStructural(const SimdScanSet* set, unsigned char c)
+{
+    if (set->highbit && (c & 0x80))
+        return true;
+    for (int i = 0; i < set->nchars; i++) {
+        if (set->chars[i] == c)
+            return true;
+    }
+    return false;
+}
+
+#ifdef SIMD_SCAN_USE_SSE2
+static inline uint64_t SimdScanLane(const SimdScanSet* set, const char* p)
+{
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i hit = _mm_setzero_si128();
+    int bits;
+
+    for (int i = 0; i < set->nchars; i++)
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, _mm_set1_epi8((char)set->chars[i])));
+    bits = _mm_movemask_epi8(hit);
+    if (set->highbit)
+        bits |= _mm_movemask_epi8(v);
+    return (uint64_t)(uint32_t)bits;
+}
+#endif
+
+#ifdef SIMD_SCAN_USE_NEON
+static inline uint8x16_t SimdScanLane(const SimdScanSet* set, const char* p)
+{
+    uint8x16_t v = vld1q_u8((const uint8_t*)p);
+    uint8x16_t hit = vdupq_n_u8(0);
+
+    for (int i = 0; i < set->nchars; i++)
+        hit = vorrq_u8(hit, vceqq_u8(v, vdupq_n_u8(set->chars[i])));
+    if (set->highbit)
+        hit = vorrq_u8(hit, vcgeq_u8(v, vdupq_n_u8(0x80)));
+    return hit;
+}
+#endif
+
+/*
+ * SimdScanBlock - bitmap of structural bytes in p[0 .. SIMD_SCAN_BLOCK - 1]
+ *
+ * The caller guarantees that SIMD_SCAN_BLOCK bytes are readable.
+ */
+static inline uint64_t SimdScanBlock(const SimdScanSet* set, const char* p)
+{
+#if defined(SIMD_SCAN_USE_SSE2)
+    return SimdScanLane(set, p) | (SimdScanLane(set, p + 16) << 16) | (SimdScanLane(set, p + 32) << 32) |
+           (SimdScanLane(set, p + 48) << 48);
+#elif defined(SIMD_SCAN_USE_NEON)
+    /* NEON has no movemask: weight each lane by its bit and add pairwise */
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t w = vld1q_u8(weights);
+    uint8x16_t t0 = vandq_u8(SimdScanLane(set, p), w);
+    uint8x16_t t1 = vandq_u8(SimdScanLane(set, p + 16), w);
+    uint8x16_t t2 = vandq_u8(SimdScanLane(set, p + 32), w);
+    uint8x16_t t3 = vandq_u8(SimdScanLane(set, p + 48), w);
+    uint8x16_t sum0 = vpaddq_u8(t0, t1);
+    uint8x16_t sum1 = vpaddq_u8(t2, t3);
+
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+#else
+    uint64_t bits = 0;
+
+    for (int i = 0; i < SIMD_SCAN_BLOCK; i++) {
+        if (SimdScanIsStructural(set, (unsigned char)p[i]))
+            bits |= ((uint64_t)1) << i;
+    }
+    return bits;
+#endif
+}
+
+static inline int SimdScanFirstBit(uint64_t bits)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    int pos = 0;
+
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+/*
+ * SimdScanFind - offset of the first structural byte in s[0 .. len - 1]
+ *
+ * Returns len if there is none.  Never reads past s + len.
+ */
+static inline size_t SimdScanFind(const SimdScanSet* set, const char* s, size_t len)
+{
+    size_t pos = 0;
+
+    for (; pos + SIMD_SCAN_BLOCK <= len; pos += SIMD_SCAN_BLOCK) {
+        uint64_t bits = SimdScanBlock(set, s + pos);
+
+        if (bits != 0)
+            return pos + SimdScanFirstBit(bits);
+    }
+    for (; pos < len; pos++) {
+        if (SimdScanIsStructural(set, (unsigned char)s[pos]))
+            break;
+    }
+    return pos;
+}
+
+#endif /* SIMD_SCAN_H */
@@ -135,7 +135,7 @@ DATA(insert ( 2110	float4pl		float4pl		-				0	700		_null_ _null_ 	n	0));
 DATA(insert ( 2111	float8pl		float8pl		-				0	701		_null_ _null_ 	n	0));
 DATA(insert ( 2112	cash_pl			cash_pl			-				0	790		_null_ _null_ 	n	0));
 DATA(insert ( 2113	interval_pl		interval_pl		-				0	1186	_null_ _null_ 	n	0));
-DATA(insert ( 2114	numeric_add		numeric_add		-				0	1700	_null_ _null_ 	n	0));
+DATA(insert ( 2114	numeric_sum_accum	numeric_add		numeric_sum		0	1700	_null_ _null_ 	n	0));
 #define NUMERICSUMFUNCOID 2114
 #endif
 
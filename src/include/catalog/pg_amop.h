@@ -518,6 +518,15 @@ DATA(insert (	2968  2950 2950 3 s 2972	403 0 ));
 DATA(insert (	2968  2950 2950 4 s 2977	403 0 ));
 DATA(insert (	2968  2950 2950 5 s 2975	403 0 ));
 
+/*
+ * btree jsonb_ops
+ */
+DATA(insert (	3417  3360 3360 1 s 3413	403 0 ));
+DATA(insert (	3417  3360 3360 2 s 3415	403 0 ));
+DATA(insert (	3417  3360 3360 3 s 3401	403 0 ));
+DATA(insert (	3417  3360 3360 4 s 3416	403 0 ));
+DATA(insert (	3417  3360 3360 5 s 3414	403 0 ));
+
 /*
  *	hash index _ops
  */
@@ -592,6 +601,8 @@ DATA(insert (	2231   1042 1042 1 s 1054 405 0 ));
 DATA(insert (	2235   1033 1033 1 s  974 405 0 ));
 /* uuid_ops */
 DATA(insert (	2969   2950 2950 1 s 2972 405 0 ));
+/* jsonb_ops */
+DATA(insert (	3418   3360 3360 1 s 3401 405 0 ));
 /* numeric_ops */
 DATA(insert (	1998   1700 1700 1 s 1752 405 0 ));
 /* array_ops */
@@ -729,6 +740,19 @@ DATA(insert (	3659   3614 3615 2 s	3660 2742 0 ));
 DATA(insert (	4446   3614 3615 1 s	3636 4444 0 ));
 DATA(insert (	4446   3614 3615 2 s	3660 4444 0 ));
 
+/*
+ * GIN jsonb_ops
+ */
+DATA(insert (	3403   3360 3360 7 s	3399 2742 0 ));
+DATA(insert (	3403   3360 25 9 s	3396 2742 0 ));
+DATA(insert (	3403   3360 1009 10 s	3397 2742 0 ));
+DATA(insert (	3403   3360 1009 11 s	3398 2742 0 ));
+
+/*
+ * GIN jsonb_path_ops
+ */
+DATA(insert (	3404   3360 3360 7 s	3399 2742 0 ));
+
 /*
  * btree tsquery_ops
  */
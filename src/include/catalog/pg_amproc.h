@@ -138,6 +138,7 @@ DATA(insert (	2233   703 703 1  380 ));
 DATA(insert (	2234   704 704 1  381 ));
 DATA(insert (	2789   27 27 1 2794 ));
 DATA(insert (	2968   2950 2950 1 2960 ));
+DATA(insert (	3417   3360 3360 1 3411 ));
 DATA(insert (	3522   3500 3500 1 3514 ));
 
 DATA(insert (	3806   86 86 1 3475 ));
@@ -178,6 +179,7 @@ DATA(insert (	2231   1042 1042 1 1080 ));
 DATA(insert (	2232   31 31 1 450 ));
 DATA(insert (	2235   1033 1033 1 329 ));
 DATA(insert (	2969   2950 2950 1 2963 ));
+DATA(insert (	3418   3360 3360 1 3412 ));
 DATA(insert (	3523   3500 3500 1 3515 ));
 
 
@@ -384,6 +386,16 @@ DATA(insert (	3659   3614 3614 3 3657 ));
 DATA(insert (	3659   3614 3614 4 3658 ));
 DATA(insert (	3659   3614 3614 5 2700 ));
 DATA(insert (	3659   3614 3614 6 3921 ));
+DATA(insert (	3403   3360 3360 1 3381 ));
+DATA(insert (	3403   3360 3360 2 3382 ));
+DATA(insert (	3403   3360 3360 3 3383 ));
+DATA(insert (	3403   3360 3360 4 3384 ));
+DATA(insert (	3403   3360 3360 6 3385 ));
+DATA(insert (	3404   3360 3360 1 351 ));
+DATA(insert (	3404   3360 3360 2 3386 ));
+DATA(insert (	3404   3360 3360 3 3387 ));
+DATA(insert (	3404   3360 3360 4 3388 ));
+DATA(insert (	3404   3360 3360 6 3389 ));
 DATA(insert (	3626   3614 3614 1 3622 ));
 DATA(insert (	3683   3615 3615 1 3668 ));
 DATA(insert (	3901   3831 3831 1 3870 ));
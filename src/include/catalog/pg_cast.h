@@ -373,6 +373,12 @@ DATA(insert (	23 1560 1683 e f ));
 DATA(insert ( 1560	 20 2076 e f ));
 DATA(insert ( 1560	 23 1684 e f ));
 
+/*
+ * json and jsonb
+ */
+DATA(insert (  114 3360 3366 a f ));
+DATA(insert ( 3360	114 3367 a f ));
+
 /*
  * Cross-category casts to and from TEXT
  *
@@ -252,6 +252,10 @@ DATA(insert ( 403        tsvector_ops        PGNSP PGUID 3626  3614 t 0 ));
 DATA(insert ( 783        tsvector_ops        PGNSP PGUID 3655  3614 t 3642 ));
 DATA(insert ( 2742       tsvector_ops        PGNSP PGUID 3659  3614 t 25 ));
 DATA(insert ( 4444       tsvector_ops        PGNSP PGUID 4446  3614 t 25 ));
+DATA(insert ( 2742       jsonb_ops           PGNSP PGUID 3403  3360 t 25 ));
+DATA(insert ( 2742       jsonb_path_ops      PGNSP PGUID 3404  3360 f 23 ));
+DATA(insert ( 403        jsonb_ops           PGNSP PGUID 3417  3360 t 0 ));
+DATA(insert ( 405        jsonb_ops           PGNSP PGUID 3418  3360 t 0 ));
 DATA(insert ( 403        tsquery_ops         PGNSP PGUID 3683  3615 t 0 ));
 DATA(insert ( 783        tsquery_ops         PGNSP PGUID 3702  3615 t 20 ));
 DATA(insert ( 403        range_ops           PGNSP PGUID 3901  3831 t 0 ));
@@ -1844,6 +1844,42 @@ DESCR("text search match");
 DATA(insert OID = 3763 ("@@"       PGNSP PGUID b f f 25         3615     16    0    0     ts_match_tq contsel contjoinsel));
 DESCR("text search match");
 
+/* jsonb operators */
+DATA(insert OID = 3390 ("->"       PGNSP PGUID b f f 3360     25       3360    0    0     jsonb_object_field - -));
+DESCR("get jsonb object field");
+DATA(insert OID = 3391 ("->>"      PGNSP PGUID b f f 3360     25       25      0    0     jsonb_object_field_text - -));
+DESCR("get jsonb object field as text");
+DATA(insert OID = 3392 ("->"       PGNSP PGUID b f f 3360     23       3360    0    0     jsonb_array_element - -));
+DESCR("get jsonb array element");
+DATA(insert OID = 3393 ("->>"      PGNSP PGUID b f f 3360     23       25      0    0     jsonb_array_element_text - -));
+DESCR("get jsonb array element as text");
+DATA(insert OID = 3394 ("#>"       PGNSP PGUID b f f 3360     1009     3360    0    0     jsonb_extract_path - -));
+DESCR("get value from jsonb with path elements");
+DATA(insert OID = 3395 ("#>>"      PGNSP PGUID b f f 3360     1009     25      0    0     jsonb_extract_path_text - -));
+DESCR("get value from jsonb as text with path elements");
+DATA(insert OID = 3396 ("?"        PGNSP PGUID b f f 3360     25       16      0    0     jsonb_exists contsel contjoinsel));
+DESCR("key exists");
+DATA(insert OID = 3397 ("?|"       PGNSP PGUID b f f 3360     1009     16      0    0     jsonb_exists_any contsel contjoinsel));
+DESCR("any key exists");
+DATA(insert OID = 3398 ("?&"       PGNSP PGUID b f f 3360     1009     16      0    0     jsonb_exists_all contsel contjoinsel));
+DESCR("all keys exist");
+DATA(insert OID = 3399 ("@>"       PGNSP PGUID b f f 3360     3360     16   3400    0     jsonb_contains contsel contjoinsel));
+DESCR("contains");
+DATA(insert OID = 3400 ("<@"       PGNSP PGUID b f f 3360     3360     16   3399    0     jsonb_contained contsel contjoinsel));
+DESCR("is contained by");
+DATA(insert OID = 3401 ("="        PGNSP PGUID b t t 3360     3360     16   3401 3402     jsonb_eq eqsel eqjoinsel));
+DESCR("equal");
+DATA(insert OID = 3402 ("<>"       PGNSP PGUID b f f 3360     3360     16   3402 3401     jsonb_ne neqsel neqjoinsel));
+DESCR("not equal");
+DATA(insert OID = 3413 ("<"        PGNSP PGUID b f f 3360     3360     16   3414 3416     jsonb_lt scalarltsel scalarltjoinsel));
+DESCR("less than");
+DATA(insert OID = 3414 (">"        PGNSP PGUID b f f 3360     3360     16   3413 3415     jsonb_gt scalargtsel scalargtjoinsel));
+DESCR("greater than");
+DATA(insert OID = 3415 ("<="       PGNSP PGUID b f f 3360     3360     16   3416 3414     jsonb_le scalarltsel scalarltjoinsel));
+DESCR("less than or equal");
+DATA(insert OID = 3416 (">="       PGNSP PGUID b f f 3360     3360     16   3415 3413     jsonb_ge scalargtsel scalargtjoinsel));
+DESCR("greater than or equal");
+
 /* generic record comparison operators */
 DATA(insert OID = 2988 ("="       PGNSP PGUID b t f 2249 2249 16 2988 2989 record_eq eqsel eqjoinsel));
 DESCR("equal");
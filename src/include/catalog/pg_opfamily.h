@@ -139,6 +139,10 @@ DATA(insert OID = 3626 (403        tsvector_ops    PGNSP PGUID));
 DATA(insert OID = 3655 (783        tsvector_ops    PGNSP PGUID));
 DATA(insert OID = 3659 (2742    tsvector_ops    PGNSP PGUID));
 DATA(insert OID = 4446 (4444    tsvector_ops    PGNSP PGUID));
+DATA(insert OID = 3403 (2742    jsonb_ops       PGNSP PGUID));
+DATA(insert OID = 3404 (2742    jsonb_path_ops  PGNSP PGUID));
+DATA(insert OID = 3417 (403     jsonb_ops       PGNSP PGUID));
+DATA(insert OID = 3418 (405     jsonb_ops       PGNSP PGUID));
 DATA(insert OID = 3683 (403        tsquery_ops        PGNSP PGUID));
 DATA(insert OID = 3702 (783        tsquery_ops        PGNSP PGUID));
 DATA(insert OID = 3901 (403        range_ops        PGNSP PGUID));
@@ -0,0 +1,7 @@
+-- sum(numeric) goes back to accumulating with numeric_add
+UPDATE pg_catalog.pg_aggregate
+    SET aggtransfn = 'pg_catalog.numeric_add'::regproc, aggfinalfn = 0
+    WHERE aggfnoid = 2114;
+
+DROP FUNCTION IF EXISTS pg_catalog.numeric_sum(numeric) CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.numeric_sum_accum(numeric, numeric) CASCADE;
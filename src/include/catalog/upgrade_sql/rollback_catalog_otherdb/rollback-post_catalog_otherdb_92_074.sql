@@ -0,0 +1,11 @@
+-- drop jsonb and everything built on it; rows inserted directly have no dependencies
+DELETE FROM pg_catalog.pg_amproc WHERE amprocfamily IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_amop WHERE amopfamily IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_opclass WHERE opcfamily IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_opfamily WHERE oid IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_cast WHERE (castsource = 114 AND casttarget = 3360) OR (castsource = 3360 AND casttarget = 114);
+DELETE FROM pg_catalog.pg_operator WHERE oid IN (3390, 3391, 3392, 3393, 3394, 3395, 3396, 3397, 3398, 3399, 3400, 3401, 3402,
+    3413, 3414, 3415, 3416);
+-- the functions all go with the type, except this one
+DROP FUNCTION IF EXISTS pg_catalog.gin_compare_jsonb(text, text) CASCADE;
+DROP TYPE IF EXISTS pg_catalog.jsonb CASCADE;
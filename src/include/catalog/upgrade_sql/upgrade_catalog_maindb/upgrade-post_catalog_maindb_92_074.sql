@@ -0,0 +1,237 @@
+-- jsonb, a binary JSON type with B-tree, hash and GIN operator classes
+-- start from scratch if a previous attempt left anything behind
+DELETE FROM pg_catalog.pg_amproc WHERE amprocfamily IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_amop WHERE amopfamily IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_opclass WHERE opcfamily IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_opfamily WHERE oid IN (3403, 3404, 3417, 3418);
+DELETE FROM pg_catalog.pg_cast WHERE (castsource = 114 AND casttarget = 3360) OR (castsource = 3360 AND casttarget = 114);
+DELETE FROM pg_catalog.pg_operator WHERE oid IN (3390, 3391, 3392, 3393, 3394, 3395, 3396, 3397, 3398, 3399, 3400, 3401, 3402,
+    3413, 3414, 3415, 3416);
+-- the functions all go with the type, except this one
+DROP FUNCTION IF EXISTS pg_catalog.gin_compare_jsonb(text, text) CASCADE;
+DROP TYPE IF EXISTS pg_catalog.jsonb CASCADE;
+
+-- the type and its I/O functions
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_TYPE, 3360, 3361, b;
+CREATE TYPE pg_catalog.jsonb;
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3362;
+CREATE FUNCTION pg_catalog.jsonb_in(cstring) RETURNS pg_catalog.jsonb LANGUAGE INTERNAL STABLE STRICT AS 'jsonb_in';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3363;
+CREATE FUNCTION pg_catalog.jsonb_out(pg_catalog.jsonb) RETURNS cstring LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_out';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3364;
+CREATE FUNCTION pg_catalog.jsonb_recv(internal) RETURNS pg_catalog.jsonb LANGUAGE INTERNAL STABLE STRICT AS 'jsonb_recv';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3365;
+CREATE FUNCTION pg_catalog.jsonb_send(pg_catalog.jsonb) RETURNS bytea LANGUAGE INTERNAL STABLE STRICT AS 'jsonb_send';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_TYPE, 3360, 3361, b;
+CREATE TYPE pg_catalog.jsonb (INPUT = jsonb_in, OUTPUT = jsonb_out, RECEIVE = jsonb_recv, SEND = jsonb_send,
+    INTERNALLENGTH = VARIABLE, ALIGNMENT = int4, STORAGE = extended, CATEGORY = 'U');
+COMMENT ON TYPE pg_catalog.jsonb IS 'Binary JSON';
+
+-- functions
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3366;
+CREATE FUNCTION pg_catalog.jsonb(json) RETURNS pg_catalog.jsonb LANGUAGE INTERNAL IMMUTABLE STRICT AS 'json_to_jsonb';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3367;
+CREATE FUNCTION pg_catalog.json(pg_catalog.jsonb) RETURNS json LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_to_json';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3368;
+CREATE FUNCTION pg_catalog.jsonb_object_field(pg_catalog.jsonb, text) RETURNS pg_catalog.jsonb LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_object_field';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3369;
+CREATE FUNCTION pg_catalog.jsonb_object_field_text(pg_catalog.jsonb, text) RETURNS text LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_object_field_text';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3370;
+CREATE FUNCTION pg_catalog.jsonb_array_element(pg_catalog.jsonb, integer) RETURNS pg_catalog.jsonb LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_array_element';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3371;
+CREATE FUNCTION pg_catalog.jsonb_array_element_text(pg_catalog.jsonb, integer) RETURNS text LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_array_element_text';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3372;
+CREATE FUNCTION pg_catalog.jsonb_extract_path(pg_catalog.jsonb, text[]) RETURNS pg_catalog.jsonb LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_extract_path';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3373;
+CREATE FUNCTION pg_catalog.jsonb_extract_path_text(pg_catalog.jsonb, text[]) RETURNS text LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_extract_path_text';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3374;
+CREATE FUNCTION pg_catalog.jsonb_exists(pg_catalog.jsonb, text) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_exists';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3375;
+CREATE FUNCTION pg_catalog.jsonb_exists_any(pg_catalog.jsonb, text[]) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_exists_any';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3376;
+CREATE FUNCTION pg_catalog.jsonb_exists_all(pg_catalog.jsonb, text[]) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_exists_all';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3377;
+CREATE FUNCTION pg_catalog.jsonb_contains(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_contains';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3378;
+CREATE FUNCTION pg_catalog.jsonb_contained(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_contained';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3379;
+CREATE FUNCTION pg_catalog.jsonb_eq(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_eq';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3380;
+CREATE FUNCTION pg_catalog.jsonb_ne(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_ne';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3381;
+CREATE FUNCTION pg_catalog.gin_compare_jsonb(text, text) RETURNS integer LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_compare_jsonb';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3382;
+CREATE FUNCTION pg_catalog.gin_extract_jsonb(pg_catalog.jsonb, internal, internal) RETURNS internal LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_extract_jsonb';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3383;
+CREATE FUNCTION pg_catalog.gin_extract_jsonb_query(pg_catalog.jsonb, internal, smallint, internal, internal, internal, internal) RETURNS internal LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_extract_jsonb_query';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3384;
+CREATE FUNCTION pg_catalog.gin_consistent_jsonb(internal, smallint, pg_catalog.jsonb, integer, internal, internal, internal, internal) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_consistent_jsonb';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3385;
+CREATE FUNCTION pg_catalog.gin_triconsistent_jsonb(internal, smallint, pg_catalog.jsonb, integer, internal, internal, internal) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_triconsistent_jsonb';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3386;
+CREATE FUNCTION pg_catalog.gin_extract_jsonb_path(pg_catalog.jsonb, internal, internal) RETURNS internal LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_extract_jsonb_path';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3387;
+CREATE FUNCTION pg_catalog.gin_extract_jsonb_query_path(pg_catalog.jsonb, internal, smallint, internal, internal, internal, internal) RETURNS internal LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_extract_jsonb_query_path';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3388;
+CREATE FUNCTION pg_catalog.gin_consistent_jsonb_path(internal, smallint, pg_catalog.jsonb, integer, internal, internal, internal, internal) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_consistent_jsonb_path';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3389;
+CREATE FUNCTION pg_catalog.gin_triconsistent_jsonb_path(internal, smallint, pg_catalog.jsonb, integer, internal, internal, internal) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'gin_triconsistent_jsonb_path';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3407;
+CREATE FUNCTION pg_catalog.jsonb_lt(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_lt';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3408;
+CREATE FUNCTION pg_catalog.jsonb_gt(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_gt';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3409;
+CREATE FUNCTION pg_catalog.jsonb_le(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_le';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3410;
+CREATE FUNCTION pg_catalog.jsonb_ge(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS boolean LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_ge';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3411;
+CREATE FUNCTION pg_catalog.jsonb_cmp(pg_catalog.jsonb, pg_catalog.jsonb) RETURNS integer LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_cmp';
+
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3412;
+CREATE FUNCTION pg_catalog.jsonb_hash(pg_catalog.jsonb) RETURNS integer LANGUAGE INTERNAL IMMUTABLE STRICT AS 'jsonb_hash';
+
+-- casts between json and jsonb
+INSERT INTO pg_catalog.pg_cast VALUES (114, 3360, 3366, 'a', 'f');
+INSERT INTO pg_catalog.pg_cast VALUES (3360, 114, 3367, 'a', 'f');
+
+-- operators
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3390;
+INSERT INTO pg_catalog.pg_operator VALUES ('->', 11, 10, 'b', 'f', 'f', 3360, 25, 3360, 0, 0,
+    'pg_catalog.jsonb_object_field'::regproc, 0, 0);
+COMMENT ON OPERATOR pg_catalog.->(pg_catalog.jsonb, text) IS 'get jsonb object field';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3391;
+INSERT INTO pg_catalog.pg_operator VALUES ('->>', 11, 10, 'b', 'f', 'f', 3360, 25, 25, 0, 0,
+    'pg_catalog.jsonb_object_field_text'::regproc, 0, 0);
+COMMENT ON OPERATOR pg_catalog.->>(pg_catalog.jsonb, text) IS 'get jsonb object field as text';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3392;
+INSERT INTO pg_catalog.pg_operator VALUES ('->', 11, 10, 'b', 'f', 'f', 3360, 23, 3360, 0, 0,
+    'pg_catalog.jsonb_array_element'::regproc, 0, 0);
+COMMENT ON OPERATOR pg_catalog.->(pg_catalog.jsonb, integer) IS 'get jsonb array element';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3393;
+INSERT INTO pg_catalog.pg_operator VALUES ('->>', 11, 10, 'b', 'f', 'f', 3360, 23, 25, 0, 0,
+    'pg_catalog.jsonb_array_element_text'::regproc, 0, 0);
+COMMENT ON OPERATOR pg_catalog.->>(pg_catalog.jsonb, integer) IS 'get jsonb array element as text';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3394;
+INSERT INTO pg_catalog.pg_operator VALUES ('#>', 11, 10, 'b', 'f', 'f', 3360, 1009, 3360, 0, 0,
+    'pg_catalog.jsonb_extract_path'::regproc, 0, 0);
+COMMENT ON OPERATOR pg_catalog.#>(pg_catalog.jsonb, text[]) IS 'get value from jsonb with path elements';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3395;
+INSERT INTO pg_catalog.pg_operator VALUES ('#>>', 11, 10, 'b', 'f', 'f', 3360, 1009, 25, 0, 0,
+    'pg_catalog.jsonb_extract_path_text'::regproc, 0, 0);
+COMMENT ON OPERATOR pg_catalog.#>>(pg_catalog.jsonb, text[]) IS 'get value from jsonb as text with path elements';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3396;
+INSERT INTO pg_catalog.pg_operator VALUES ('?', 11, 10, 'b', 'f', 'f', 3360, 25, 16, 0, 0,
+    'pg_catalog.jsonb_exists'::regproc, 'pg_catalog.contsel'::regproc, 'pg_catalog.contjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.?(pg_catalog.jsonb, text) IS 'key exists';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3397;
+INSERT INTO pg_catalog.pg_operator VALUES ('?|', 11, 10, 'b', 'f', 'f', 3360, 1009, 16, 0, 0,
+    'pg_catalog.jsonb_exists_any'::regproc, 'pg_catalog.contsel'::regproc, 'pg_catalog.contjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.?|(pg_catalog.jsonb, text[]) IS 'any key exists';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3398;
+INSERT INTO pg_catalog.pg_operator VALUES ('?&', 11, 10, 'b', 'f', 'f', 3360, 1009, 16, 0, 0,
+    'pg_catalog.jsonb_exists_all'::regproc, 'pg_catalog.contsel'::regproc, 'pg_catalog.contjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.?&(pg_catalog.jsonb, text[]) IS 'all keys exist';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3399;
+INSERT INTO pg_catalog.pg_operator VALUES ('@>', 11, 10, 'b', 'f', 'f', 3360, 3360, 16, 3400, 0,
+    'pg_catalog.jsonb_contains'::regproc, 'pg_catalog.contsel'::regproc, 'pg_catalog.contjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.@>(pg_catalog.jsonb, pg_catalog.jsonb) IS 'contains';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3400;
+INSERT INTO pg_catalog.pg_operator VALUES ('<@', 11, 10, 'b', 'f', 'f', 3360, 3360, 16, 3399, 0,
+    'pg_catalog.jsonb_contained'::regproc, 'pg_catalog.contsel'::regproc, 'pg_catalog.contjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.<@(pg_catalog.jsonb, pg_catalog.jsonb) IS 'is contained by';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3401;
+INSERT INTO pg_catalog.pg_operator VALUES ('=', 11, 10, 'b', 't', 't', 3360, 3360, 16, 3401, 3402,
+    'pg_catalog.jsonb_eq'::regproc, 'pg_catalog.eqsel'::regproc, 'pg_catalog.eqjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.=(pg_catalog.jsonb, pg_catalog.jsonb) IS 'equal';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3402;
+INSERT INTO pg_catalog.pg_operator VALUES ('<>', 11, 10, 'b', 'f', 'f', 3360, 3360, 16, 3402, 3401,
+    'pg_catalog.jsonb_ne'::regproc, 'pg_catalog.neqsel'::regproc, 'pg_catalog.neqjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.<>(pg_catalog.jsonb, pg_catalog.jsonb) IS 'not equal';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3413;
+INSERT INTO pg_catalog.pg_operator VALUES ('<', 11, 10, 'b', 'f', 'f', 3360, 3360, 16, 3414, 3416,
+    'pg_catalog.jsonb_lt'::regproc, 'pg_catalog.scalarltsel'::regproc, 'pg_catalog.scalarltjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.<(pg_catalog.jsonb, pg_catalog.jsonb) IS 'less than';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3414;
+INSERT INTO pg_catalog.pg_operator VALUES ('>', 11, 10, 'b', 'f', 'f', 3360, 3360, 16, 3413, 3415,
+    'pg_catalog.jsonb_gt'::regproc, 'pg_catalog.scalargtsel'::regproc, 'pg_catalog.scalargtjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.>(pg_catalog.jsonb, pg_catalog.jsonb) IS 'greater than';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3415;
+INSERT INTO pg_catalog.pg_operator VALUES ('<=', 11, 10, 'b', 'f', 'f', 3360, 3360, 16, 3416, 3414,
+    'pg_catalog.jsonb_le'::regproc, 'pg_catalog.scalarltsel'::regproc, 'pg_catalog.scalarltjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.<=(pg_catalog.jsonb, pg_catalog.jsonb) IS 'less than or equal';
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3416;
+INSERT INTO pg_catalog.pg_operator VALUES ('>=', 11, 10, 'b', 'f', 'f', 3360, 3360, 16, 3415, 3413,
+    'pg_catalog.jsonb_ge'::regproc, 'pg_catalog.scalargtsel'::regproc, 'pg_catalog.scalargtjoinsel'::regproc);
+COMMENT ON OPERATOR pg_catalog.>=(pg_catalog.jsonb, pg_catalog.jsonb) IS 'greater than or equal';
+
+-- operator families and classes
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3403;
+INSERT INTO pg_catalog.pg_opfamily VALUES (2742, 'jsonb_ops', 11, 10);
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3404;
+INSERT INTO pg_catalog.pg_opfamily VALUES (2742, 'jsonb_path_ops', 11, 10);
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3417;
+INSERT INTO pg_catalog.pg_opfamily VALUES (403, 'jsonb_ops', 11, 10);
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_GENERAL, 3418;
+INSERT INTO pg_catalog.pg_opfamily VALUES (405, 'jsonb_ops', 11, 10);
+INSERT INTO pg_catalog.pg_opclass VALUES (2742, 'jsonb_ops', 11, 10, 3403, 3360, 't', 25);
+INSERT INTO pg_catalog.pg_opclass VALUES (2742, 'jsonb_path_ops', 11, 10, 3404, 3360, 'f', 23);
+INSERT INTO pg_catalog.pg_opclass VALUES (403, 'jsonb_ops', 11, 10, 3417, 3360, 't', 0);
+INSERT INTO pg_catalog.pg_opclass VALUES (405, 'jsonb_ops', 11, 10, 3418, 3360, 't', 0);
+
+INSERT INTO pg_catalog.pg_amop VALUES (3417, 3360, 3360, 1, 's', 3413, 403, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3417, 3360, 3360, 2, 's', 3415, 403, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3417, 3360, 3360, 3, 's', 3401, 403, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3417, 3360, 3360, 4, 's', 3416, 403, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3417, 3360, 3360, 5, 's', 3414, 403, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3418, 3360, 3360, 1, 's', 3401, 405, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3403, 3360, 3360, 7, 's', 3399, 2742, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3403, 3360, 25, 9, 's', 3396, 2742, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3403, 3360, 1009, 10, 's', 3397, 2742, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3403, 3360, 1009, 11, 's', 3398, 2742, 0);
+INSERT INTO pg_catalog.pg_amop VALUES (3404, 3360, 3360, 7, 's', 3399, 2742, 0);
+
+INSERT INTO pg_catalog.pg_amproc VALUES (3417, 3360, 3360, 1, 3411);
+INSERT INTO pg_catalog.pg_amproc VALUES (3418, 3360, 3360, 1, 3412);
+INSERT INTO pg_catalog.pg_amproc VALUES (3403, 3360, 3360, 1, 3381);
+INSERT INTO pg_catalog.pg_amproc VALUES (3403, 3360, 3360, 2, 3382);
+INSERT INTO pg_catalog.pg_amproc VALUES (3403, 3360, 3360, 3, 3383);
+INSERT INTO pg_catalog.pg_amproc VALUES (3403, 3360, 3360, 4, 3384);
+INSERT INTO pg_catalog.pg_amproc VALUES (3403, 3360, 3360, 6, 3385);
+INSERT INTO pg_catalog.pg_amproc VALUES (3404, 3360, 3360, 1, 351);
+INSERT INTO pg_catalog.pg_amproc VALUES (3404, 3360, 3360, 2, 3386);
+INSERT INTO pg_catalog.pg_amproc VALUES (3404, 3360, 3360, 3, 3387);
+INSERT INTO pg_catalog.pg_amproc VALUES (3404, 3360, 3360, 4, 3388);
+INSERT INTO pg_catalog.pg_amproc VALUES (3404, 3360, 3360, 6, 3389);
@@ -0,0 +1,13 @@
+-- sum(numeric) keeps its transition value as a scaled integer and
+-- normalizes it in a final function
+DROP FUNCTION IF EXISTS pg_catalog.numeric_sum_accum(numeric, numeric) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3406;
+CREATE FUNCTION pg_catalog.numeric_sum_accum(numeric, numeric) RETURNS numeric LANGUAGE INTERNAL IMMUTABLE STRICT AS 'numeric_sum_accum';
+
+DROP FUNCTION IF EXISTS pg_catalog.numeric_sum(numeric) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3405;
+CREATE FUNCTION pg_catalog.numeric_sum(numeric) RETURNS numeric LANGUAGE INTERNAL IMMUTABLE STRICT AS 'numeric_sum';
+
+UPDATE pg_catalog.pg_aggregate
+    SET aggtransfn = 'pg_catalog.numeric_sum_accum'::regproc, aggfinalfn = 'pg_catalog.numeric_sum'::regproc
+    WHERE aggfnoid = 2114;
@@ -33,6 +33,7 @@
 #endif
 
 struct Formatter;
+struct CopyReaderState;
 
 /* CopyStateData is private in commands/copy.c */
 struct CopyStateData;
@@ -316,6 +317,9 @@ typedef struct CopyStateData {
 
     /* adaptive memory assigned for the stmt */
     AdaptMem memUsage;
+
+    /* read-ahead thread for COPY FROM a server file, NULL if not used */
+    struct CopyReaderState* reader;
 } CopyStateData;
 
 #define IS_CSV(cstate) ((cstate)->fileformat == FORMAT_CSV)
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * copy_reader.h
+ *        Read-ahead reader stage for COPY FROM a server file.
+ *
+ * The reader runs in a helper thread and fills a small ring of large chunks
+ * from the COPY source file, so that file I/O overlaps with line splitting,
+ * attribute parsing and tuple insertion done by the backend.
+ *
+ * IDENTIFICATION
+ *        src/include/commands/copy_reader.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef COPY_READER_H
+#define COPY_READER_H
+
+#include <pthread.h>
+
+#include "gs_thread.h"
+#include "commands/copy.h"
+
+#define COPY_READER_CHUNK_SIZE (4 * 1024 * 1024) /* bytes read by one fread() of the reader */
+#define COPY_READER_NUM_CHUNKS 4                 /* chunks in the ring, >= 2 for double buffering */
+
+typedef struct CopyReaderChunk {
+    char* data;
+    int len;    /* valid bytes in data, 0 means EOF when the chunk is ready */
+    int cursor; /* bytes already handed to the consumer */
+} CopyReaderChunk;
+
+/*
+ * Everything the reader thread touches is malloc'd, not palloc'd: a thread
+ * stopped while it is blocked in fread() is left to finish on its own and
+ * frees the state itself, after the backend's memory contexts are gone.
+ */
+typedef struct CopyReaderState {
+    FILE* file; /* private dup of copy_file, owned by the reader thread */
+    gs_thread_t thread;
+    ThreadArg thread_arg;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    CopyReaderChunk chunks[COPY_READER_NUM_CHUNKS];
+    int head;   /* next chunk the backend consumes */
+    int tail;   /* next chunk the reader fills */
+    int nready; /* chunks filled but not yet fully consumed */
+
+    bool stop;     /* set by the backend to terminate the reader */
+    bool orphaned; /* backend has let go, the reader frees the state */
+    bool exited;   /* reader thread is about to return */
+    bool eof;      /* reader hit end of file */
+    int read_err;  /* errno of a failed fread(), 0 if none */
+} CopyReaderState;
+
+extern void CopyReaderStart(CopyState cstate);
+extern void CopyReaderStop(CopyState cstate);
+extern int CopyReaderGetData(CopyState cstate, void* databuf, int minread, int maxread);
+
+#endif /* COPY_READER_H */
@@ -48,6 +48,7 @@ typedef struct knl_instance_attr_storage {
     bool enable_gtm_free;
     bool comm_cn_dn_logic_conn;
     bool enable_adio_function;
+    bool enable_direct_io;
     bool enable_access_server_directory;
     bool enableIncrementalCheckpoint;
     bool enable_double_write;
@@ -58,6 +59,8 @@ typedef struct knl_instance_attr_storage {
     int DataQueueBufSize;
     int NBuffers;
     int cstore_buffers;
+    int clog_buffers;
+    int csnlog_buffers;
     int MaxSendSize;
     int max_prepared_xacts;
     int max_locks_per_xact;
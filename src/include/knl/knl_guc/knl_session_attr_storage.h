@@ -165,10 +165,15 @@ typedef struct knl_session_attr_storage {
     int sync_method;
     int autovacuum_mode;
     int cstore_insert_mode;
+    int default_toast_compression;
     int pageWriterSleep;
     int pagewriter_threshold;
     bool enable_cbm_tracking;
     bool enable_copy_server_files;
+    bool enable_copy_read_ahead;
+    bool enable_copy_direct_load;
+    bool enable_io_uring;
+    int direct_io_read_ahead;
     int target_rto;
     bool enable_twophase_commit;
     /*
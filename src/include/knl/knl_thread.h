@@ -1848,6 +1848,8 @@ typedef struct knl_t_libpq_context {
     /* Message status */
     bool PqCommBusy;
     bool DoingCopyOut;
+    /* DataRows batched by printtup, sent ahead of any other message */
+    struct StringInfoData* PqPendingRows;
 #ifdef HAVE_SIGPROCMASK
     sigset_t UnBlockSig, BlockSig, StartupBlockSig;
 #else
@@ -2236,6 +2238,9 @@ typedef struct knl_t_storage_context {
     int InProgressAioDispatchCount;
     struct BufferDesc* InProgressAioBuf;
     int InProgressAioType;
+    /* this thread's io_uring for storage/fileaio.h, created on first use */
+    struct FileAioRing* FileAioUring;
+    bool FileAioUringFailed;
     /*
      * When btree split, it will record two xlog:
      * 1. page split
@@ -2352,12 +2357,13 @@ typedef struct knl_t_storage_context {
     ThreadId conflicting_lock_thread_id;
     bool conflicting_lock_by_holdlock;
     /*
-     * Count of the number of fast path lock slots we believe to be used.  This
-     * might be higher than the real number if another backend has transferred
-     * our locks to the primary lock table, but it can never be lower than the
-     * real value, since only we can acquire locks on our own behalf.
+     * Count of the number of fast path lock slots we believe to be used, for
+     * each group of slots.  This might be higher than the real number if
+     * another backend has transferred our locks to the primary lock table,
+     * but it can never be lower than the real value, since only we can
+     * acquire locks on our own behalf.
      */
-    int FastPathLocalUseCount;
+    uint16 FastPathLocalUseCounts[FP_LOCK_GROUPS_PER_BACKEND_MAX];
     volatile struct FastPathStrongRelationLockData* FastPathStrongRelationLocks;
     /*
      * Pointers to hash tables containing lock state
@@ -2432,6 +2438,7 @@ typedef struct knl_t_storage_context {
 
     /* Thread share file id cache */
     struct HTAB* DataFileIdCache;
+    struct DataFileIdCacheControl* DataFileIdCacheCtl;
 
     /*
      * Maximum number of file descriptors to open for either VFD entries or
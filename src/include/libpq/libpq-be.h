@@ -150,6 +150,7 @@ typedef struct Port {
      * number as the remote end for compatibility.
      */
     uint32 SessionVersionNum;
+    bool columnar_result; /* client asked for ColumnarData messages, see _pq_.columnar_result */
 
     /*
      * TCP keepalive settings.
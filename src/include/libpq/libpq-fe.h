@@ -328,6 +328,7 @@ extern ConnStatusType PQstatus(const PGconn* conn);
 extern PGTransactionStatusType PQtransactionStatus(const PGconn* conn);
 extern const char* PQparameterStatus(const PGconn* conn, const char* paramName);
 extern int PQprotocolVersion(const PGconn* conn);
+extern int PQcolumnarResult(const PGconn* conn);
 extern int PQserverVersion(const PGconn* conn);
 extern char* PQerrorMessage(const PGconn* conn);
 extern int PQsocket(const PGconn* conn);
@@ -310,6 +310,7 @@ struct pg_conn {
     char* keepalives_count;    /* maximum number of TCP keepalive
                                 * retransmits */
     char* rw_timeout;          /* read-write timeout during idle connection.*/
+    char* columnar_result;     /* ask for ColumnarData messages? */
     char* sslmode;             /* SSL mode (require,prefer,allow,disable) */
     char* sslcompression;      /* SSL compression (0 or 1) */
     char* sslkey;              /* client key filename */
@@ -16,6 +16,7 @@
 
 #include <sys/types.h>
 #include <netinet/in.h>
+#include <sys/uio.h>
 
 #include "lib/stringinfo.h"
 #include "libpq/libpq-be.h"
@@ -63,6 +64,9 @@ extern void pq_flush_timedwait(int timeout);
 extern bool pq_is_send_pending(void);
 extern int pq_putmessage(char msgtype, const char* s, size_t len);
 extern int pq_putmessage_noblock(char msgtype, const char* s, size_t len);
+extern int pq_putmessages(const char* s, size_t len);
+extern void pq_register_pending_rows(StringInfo rows);
+extern void pq_unregister_pending_rows(StringInfo rows);
 extern void pq_startcopyout(void);
 extern void pq_endcopyout(bool errorAbort);
 extern bool pq_select(int timeout_ms);
@@ -83,6 +87,7 @@ extern int secure_open_server(Port* port);
 extern void secure_close(Port* port);
 extern ssize_t secure_read(Port* port, void* ptr, size_t len);
 extern ssize_t secure_write(Port* port, void* ptr, size_t len);
+extern ssize_t secure_writev(Port* port, struct iovec* iov, int iovcnt);
 
 /*
  * interface for flushing sendbuffer to disk
@@ -34,6 +34,8 @@
 typedef struct BucketInfo {
     NodeTag type;
     List* buckets; /* bukect ids to be scanned, NULL means all buckets */
+    Expr* pruningExpr; /* value of "bucket key = value" known only at run time,
+                        * its bucket is the only one to scan; NULL if none */
 } BucketInfo;
 
 extern char* bucketInfoToString(BucketInfo* bucket_info);
@@ -29,4 +29,6 @@
 
 extern void set_rel_bucketinfo(PlannerInfo* root, RelOptInfo* rel, RangeTblEntry* rte);
 extern double getBucketPruningRatio(BucketInfo* bucket_info);
+extern Expr* GetBucketPruningExpr(PlannerInfo* root, RelOptInfo* rel, List* scanClauses);
+extern int GetBucketIdByValue(Oid type, Datum value, bool isnull);
 #endif
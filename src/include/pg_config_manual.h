@@ -60,6 +60,13 @@
  */
 #define NUM_USER_DEFINED_LWLOCKS 4
 
+/*
+ * Maximum number of fast-path lock slot groups per backend.  The number
+ * actually used is derived from max_locks_per_transaction at startup; see
+ * InitProcGlobal.
+ */
+#define FP_LOCK_GROUPS_PER_BACKEND_MAX 64
+
 /*
  * Define this if you want to allow the lo_import and lo_export SQL
  * functions to be executed by ordinary users.	By default these
@@ -314,7 +314,19 @@ typedef enum {
 #define VARDATA_1B(PTR) (((varattrib_1b*)(PTR))->va_data)
 #define VARDATA_1B_E(PTR) (((varattrib_1b_e*)(PTR))->va_data)
 
-#define VARRAWSIZE_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize)
+/*
+ * va_rawsize of a compressed-in-line datum keeps the compression method in
+ * its top two bits; raw sizes are below 1GB so they are never needed for the
+ * size.  Method 0 is pglz, so values written before methods existed decode
+ * unchanged.
+ */
+#define VARLENA_RAWSIZE_MASK 0x3FFFFFFF
+#define VARLENA_CMETHOD_SHIFT 30
+
+#define VARRAWSIZE_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize & VARLENA_RAWSIZE_MASK)
+#define VARCMETHOD_4B_C(PTR) (((varattrib_4b*)(PTR))->va_compressed.va_rawsize >> VARLENA_CMETHOD_SHIFT)
+#define SET_VARRAWSIZE_4B_C(PTR, len, cmethod) \
+    (((varattrib_4b*)(PTR))->va_compressed.va_rawsize = ((uint32)(len)) | (((uint32)(cmethod)) << VARLENA_CMETHOD_SHIFT))
 
 /* Externally visible macros */
 
@@ -40,6 +40,8 @@
 #define FD_H
 
 #include <dirent.h>
+#include <sys/uio.h>
+#include "lib/dllist.h"
 #include "utils/hsearch.h"
 #include "storage/relfilenode.h"
 #include "postmaster/aiocompleter.h"
@@ -60,6 +62,8 @@ typedef struct DataFileIdCacheEntry {
     /* the following are setted in runtime */
     int fd;
     int refcount;
+    bool dropped;      /* file was unlinked while referenced, close at refcount 0 */
+    Dlelem idle_elem;  /* link in the partition's idle list while refcount is 0 */
 } DataFileIdCacheEntry;
 
 enum FileExistStatus { FILE_EXIST, FILE_NOT_EXIST, FILE_NOT_REG };
@@ -93,6 +97,7 @@ extern int FileWrite(File file, const char* buffer, int amount, off_t offset);
 //
 extern int FilePRead(File file, char* buffer, int amount, off_t offset, uint32 wait_event_info = 0);
 extern int FilePWrite(File file, const char* buffer, int amount, off_t offset, uint32 wait_event_info = 0);
+extern int FilePReadV(File file, const struct iovec* iov, int iovcnt, off_t offset, uint32 wait_event_info = 0);
 
 extern int AllocateSocket(const char* ipaddr, int port);
 extern int FreeSocket(int sockfd);
@@ -128,6 +133,7 @@ extern void RemovePgTempFiles(void);
 
 extern void RemoveErrorCacheFiles();
 extern int FileFd(File file);
+extern int FileAccessFd(File file);
 
 extern int pg_fsync(int fd);
 extern int pg_fsync_no_writethrough(int fd);
@@ -141,6 +147,9 @@ extern Size DataFileIdCacheSize(void);
 extern File DataFileIdOpenFile(
     FileName fileName, const RelFileNodeForkNum& fileNode, int fileFlags, int fileMode, File file = FILE_INVALID);
 
+extern void ForgetDataFileIdCache(const RelFileNodeForkNum& fileNode);
+extern void ForgetDatabaseDataFileIdCache(Oid dbid);
+
 extern RelFileNodeForkNum RelFileNodeForkNumFill(
     const RelFileNodeBackend& rnode, ForkNumber forkNum, BlockNumber segno);
 
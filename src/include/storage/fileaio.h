@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * fileaio.h
+ *     Submit/complete style asynchronous I/O on virtual file descriptors.
+ *
+ * A caller fills in a FileAioRequest, hands it to FileAioSubmit(), and later
+ * collects the result with FileAioPoll() or FileAioWait().  When
+ * enable_io_uring is on and the kernel supports it, requests go to a
+ * per-thread io_uring and several of them can be in flight at once;
+ * otherwise FileAioSubmit() performs the I/O synchronously and the request
+ * is already complete when it returns.  Either way the caller sees the same
+ * results as from FilePRead(), FilePWrite() and FileSync().
+ *
+ * The request and its buffer must stay valid until the request completes,
+ * so neither may live on the stack of a function that can error out while
+ * the request is in flight.  Requests still in flight at transaction end
+ * are waited for and their results discarded.
+ *
+ * IDENTIFICATION
+ *        src/include/storage/fileaio.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef FILEAIO_H
+#define FILEAIO_H
+
+#include <sys/uio.h>
+
+/*
+ * storage/fd.h reaches this header through smgr.h, so it cannot be included
+ * from here; requests therefore carry the File as a plain int.
+ */
+
+typedef enum FileAioOp { FILE_AIO_READ, FILE_AIO_WRITE, FILE_AIO_FSYNC } FileAioOp;
+
+typedef struct FileAioRequest {
+    /* filled in by the caller */
+    FileAioOp op;
+    int file; /* a File from storage/fd.h */
+    char* buffer;
+    int amount;
+    off_t offset;
+    uint32 wait_event_info;
+
+    /* set by the I/O layer */
+    bool inflight;
+    int result; /* bytes transferred, 0 for fsync, or -1 */
+    int error;  /* errno when result is -1 */
+    struct iovec iov;
+} FileAioRequest;
+
+extern bool FileAioIsAsync(void);
+extern void FileAioSubmit(FileAioRequest* req);
+extern bool FileAioPoll(FileAioRequest* req);
+extern void FileAioWait(FileAioRequest* req);
+extern void AtEOXact_FileAio(void);
+
+#endif /* FILEAIO_H */
@@ -78,7 +78,6 @@ extern void on_exit_reset(void);
 
 /* ipci.c */
 extern pthread_mutex_t gLocaleMutex;
-extern pthread_mutex_t gVfdMutex;
 
 extern void CreateSharedMemoryAndSemaphores(bool makePrivate, int port);
 
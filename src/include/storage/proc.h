@@ -73,8 +73,24 @@ struct XidCache {
  * RowShareLock, RowExclusiveLock) to be recorded in the PGPROC structure
  * rather than the main lock table.  This eases contention on the lock
  * manager LWLocks.  See storage/lmgr/README for additional details.
+ *
+ * The slots are organized in groups of FP_LOCK_SLOTS_PER_GROUP, and a lock
+ * tag may only use a slot of the group it hashes to, so a lookup scans one
+ * group instead of the whole array.  The number of groups is derived from
+ * max_locks_per_transaction by InitProcGlobal, which lets queries touching
+ * many partitions and indexes stay on the fast path.
+ */
+#define FP_LOCK_SLOTS_PER_GROUP 16 /* 3 bits per slot, must fit in uint64 */
+
+/*
+ * Lock modes held in one group of fast-path slots.  Every group gets a cache
+ * line of its own: the owning backend and backends transferring its locks
+ * to the main lock table update different groups at the same time.
  */
-#define FP_LOCK_SLOTS_PER_BACKEND 20
+typedef union FastPathGroupBits {
+    uint64 bits;
+    char pad[PG_CACHE_LINE_SIZE];
+} FastPathGroupBits;
 
 typedef struct FastPathTag {
     uint32 dbid;
@@ -237,11 +253,11 @@ struct PGPROC {
     LWLock* backendLock; /* protects the fields below */
 
     /* Lock manager data, recording fast-path locks taken by this backend. */
-    uint64 fpLockBits;                              /* lock modes held for each fast-path slot */
-    FastPathTag fpRelId[FP_LOCK_SLOTS_PER_BACKEND]; /* slots for rel oids */
-    bool fpVXIDLock;                                /* are we holding a fast-path VXID lock? */
-    LocalTransactionId fpLocalTransactionId;        /* lxid for fast-path VXID
-                                                     * lock */
+    FastPathGroupBits* fpLockBits;           /* lock modes held for each fast-path slot, one line per group */
+    FastPathTag* fpRelId;                    /* slots for rel oids */
+    bool fpVXIDLock;                         /* are we holding a fast-path VXID lock? */
+    LocalTransactionId fpLocalTransactionId; /* lxid for fast-path VXID
+                                              * lock */
 };
 
 /* NOTE: "typedef struct PGPROC PGPROC" appears in storage/lock.h. */
@@ -322,6 +338,8 @@ typedef struct PROC_HDR {
     ThreadId startupProcPid;
     /* Buffer id of the buffer that Startup process waits for pin on, or -1 */
     int startupBufferPinWaitBufId;
+    /* Number of fast-path lock groups in every PGPROC */
+    uint32 fpLockGroupsPerBackend;
 #ifdef __aarch64__
     char pad[PG_CACHE_LINE_SIZE - PROC_HDR_PAD_OFFSET];
 #endif
@@ -72,6 +72,7 @@ extern bool SHMQueueIsDetached(const SHM_QUEUE* queue);
 // Heap memory allocation
 //
 extern void* HeapMemAlloc(Size size);
+extern void* HeapmemInitStruct(const char* name, Size size, bool* foundPtr);
 extern HTAB* HeapMemInitHash(const char* name, long init_size, long max_size, HASHCTL* infoP, int hash_flags);
 extern void HeapMemResetHash(HTAB* hashtbl, const char* tabname);
 
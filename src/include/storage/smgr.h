@@ -17,6 +17,7 @@
 #include "fmgr.h"
 #include "lib/ilist.h"
 #include "storage/block.h"
+#include "storage/fileaio.h"
 #include "storage/relfilenode.h"
 
 #include "utils/rel.h"
@@ -82,6 +83,20 @@ typedef SMgrRelationData* SMgrRelation;
 
 #define SmgrIsTemp(smgr) RelFileNodeBackendIsTemp((smgr)->smgr_rnode)
 
+/*
+ * A block read or write started with smgrstartread()/smgrstartwrite() and
+ * finished with smgrpollio()/smgrwaitio().  The same lifetime rules as for
+ * FileAioRequest apply to it and to the buffer.
+ */
+typedef struct SMgrAioRequest {
+    FileAioRequest io;
+    SMgrRelation reln;
+    ForkNumber forknum;
+    BlockNumber blocknum;
+    bool skipFsync;
+    bool finished;
+} SMgrAioRequest;
+
 extern void smgrinit(void);
 extern SMgrRelation smgropen(const RelFileNode& rnode, BackendId backend, int col = 0);
 extern bool smgrexists(SMgrRelation reln, ForkNumber forknum);
@@ -97,6 +112,13 @@ extern void smgrextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blockn
 extern void smgrprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
 extern void smgrread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void smgrwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
+extern int smgrreadv(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char** buffers, int nblocks);
+extern void smgrstartread(
+    SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer, SMgrAioRequest* req);
+extern void smgrstartwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer,
+    bool skipFsync, SMgrAioRequest* req);
+extern bool smgrpollio(SMgrAioRequest* req);
+extern void smgrwaitio(SMgrAioRequest* req);
 extern void smgrwriteback(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks);
 extern BlockNumber smgrnblocks(SMgrRelation reln, ForkNumber forknum);
 extern void smgrtruncatefunc(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks);
@@ -119,6 +141,12 @@ extern void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum
 extern void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
 extern void mdread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
+extern int mdreadv(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char** buffers, int nblocks);
+extern void mdstartread(
+    SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer, SMgrAioRequest* req);
+extern void mdstartwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer,
+    bool skipFsync, SMgrAioRequest* req);
+extern void mdfinishio(SMgrAioRequest* req);
 extern void mdwriteback(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks);
 extern BlockNumber mdnblocks(SMgrRelation reln, ForkNumber forknum);
 extern void mdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks);
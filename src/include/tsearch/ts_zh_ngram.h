@@ -44,8 +44,8 @@ typedef struct {
 
     char* cache;        /* pointe to parsed but not returned token */
     int max_cached_num; /* cached char number */
-    uint8* char_width;  /* array record each char length */
-    uint8* char_flag;   /* array record each char type */
+    uint8 char_width[MAX_CACHED_CHAR + 1]; /* array record each char length */
+    uint8 char_flag[MAX_CACHED_CHAR + 1];  /* array record each char type */
     int cached_size;    /* already dealt bytes in cache  */
     int cached_counter; /* already dealt chars in cache  */
     bool cached;        /* if cahced tokens */
@@ -79,17 +79,17 @@ const char* const zh_tok_alias[] = {"", "zh_words", "en_word", "numeric", "alnum
 const char* const zh_lex_descr[] = {
     "", "chinese words", "english word", "numeric data", "alnum string", "graphic symbol", "multiple symbol"};
 
-extern uint8 ascii_matrix[8][16];
+extern const uint8 ascii_matrix[8][16];
 
-extern uint8 gbk_high_byte_matrix[8][16];
+extern const uint8 gbk_high_byte_matrix[8][16];
 
-extern uint8 gbk_zh_word_matrix[3][16][16];
+extern const uint8 gbk_zh_word_matrix[3][16][16];
 
-extern uint8 gbk_grap_symbol_matrix[10][16][16];
+extern const uint8 gbk_grap_symbol_matrix[10][16][16];
 
-extern uint8 utf8_symbols_punctuation_matrix[4][16];
+extern const uint8 utf8_symbols_punctuation_matrix[4][16];
 
-extern uint8 fullwidth_ascii_variants_matrix[4][4][16];
+extern const uint8 fullwidth_ascii_variants_matrix[4][4][16];
 
 #define to_unsigned(ch) ((unsigned char)(*(ch)))
 #define HFB(ch) ((to_unsigned(ch) & 0x00F0) >> 4) /* hight 4-bit value in a byte */
@@ -1023,6 +1023,11 @@ extern Datum byteanlike(PG_FUNCTION_ARGS);
 extern Datum like_escape(PG_FUNCTION_ARGS);
 extern Datum like_escape_bytea(PG_FUNCTION_ARGS);
 extern int GenericMatchText(char* s, int slen, char* p, int plen);
+typedef struct LikeMatcher LikeMatcher;
+extern LikeMatcher* CompileLikePattern(const char* p, int plen, MemoryContext cxt);
+extern bool LikeMatcherIsFor(const LikeMatcher* m, const char* p, int plen);
+extern int LikeMatcherMatchText(const LikeMatcher* m, char* s, int slen);
+extern LikeMatcher* GetCachedLikeMatcher(FunctionCallInfo fcinfo, const char* p, int plen);
 
 /* a_compat.c */
 extern Datum lower(PG_FUNCTION_ARGS);
@@ -1170,6 +1175,8 @@ extern Datum float4_numeric(PG_FUNCTION_ARGS);
 extern Datum numeric_float4(PG_FUNCTION_ARGS);
 extern Datum numeric_accum(PG_FUNCTION_ARGS);
 extern Datum numeric_avg_accum(PG_FUNCTION_ARGS);
+extern Datum numeric_sum_accum(PG_FUNCTION_ARGS);
+extern Datum numeric_sum(PG_FUNCTION_ARGS);
 extern Datum int2_accum(PG_FUNCTION_ARGS);
 extern Datum int4_accum(PG_FUNCTION_ARGS);
 extern Datum int8_accum(PG_FUNCTION_ARGS);
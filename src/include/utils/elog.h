@@ -424,6 +424,19 @@ typedef struct ErrorContextCallback {
 
 #define BFIO_END() }
 
+// DIO means the data files are opened with O_DIRECT, either for adio or for plain direct io
+#define DIO_ENABLED() \
+    (g_instance.attr.attr_storage.enable_adio_function || g_instance.attr.attr_storage.enable_direct_io)
+
+#define DIO_RUN() if (DIO_ENABLED()) {
+
+#define DIO_ELSE() \
+    }              \
+    else           \
+    {
+
+#define DIO_END() }
+
 #define ADIO_LOG_DB(A)                                     \
     do {                                                   \
         if (u_sess->attr.attr_storage.enable_adio_debug) { \
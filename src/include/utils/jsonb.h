@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * jsonb.h
+ *        Declarations for the binary JSON data type jsonb.
+ *
+ * A jsonb value is a varlena holding a tree of containers.  A container
+ * starts with a uint32 header giving the number of elements (or key/value
+ * pairs) and the container kind, followed by one JEntry per child and then
+ * the children's data.  An object has its npairs key JEntries first, sorted
+ * by key length and then bytewise with duplicates removed, followed by the
+ * npairs value JEntries in the same order, so a key is found by binary
+ * search.  A JEntry holds the type of the child and the end offset of its
+ * data relative to the start of the data area, which makes every child
+ * reachable without looking at its siblings.
+ *
+ * Strings are stored without a terminator, numbers as numeric, booleans
+ * and null in the JEntry alone.  Numerics and nested containers start on an
+ * int boundary; the padding in front of them is counted as part of their
+ * length.  A top-level scalar is stored as a one-element array marked
+ * JB_FSCALAR.
+ *
+ * IDENTIFICATION
+ *        src/include/utils/jsonb.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef JSONB_H
+#define JSONB_H
+
+#include "fmgr.h"
+#include "lib/stringinfo.h"
+#include "utils/numeric.h"
+
+typedef uint32 JEntry;
+
+#define JENTRY_OFFMASK 0x0FFFFFFF
+#define JENTRY_TYPEMASK 0x70000000
+
+#define JENTRY_ISSTRING 0x00000000
+#define JENTRY_ISNUMERIC 0x10000000
+#define JENTRY_ISBOOL_FALSE 0x20000000
+#define JENTRY_ISBOOL_TRUE 0x30000000
+#define JENTRY_ISNULL 0x40000000
+#define JENTRY_ISCONTAINER 0x50000000
+
+#define JBE_ENDPOS(je_) ((je_)&JENTRY_OFFMASK)
+#define JBE_TYPE(je_) ((je_)&JENTRY_TYPEMASK)
+
+typedef struct JsonbContainer {
+    uint32 header; /* number of elements or pairs, and flags */
+    JEntry children[FLEXIBLE_ARRAY_MEMBER];
+    /* the data of the children follows */
+} JsonbContainer;
+
+#define JB_CMASK 0x0FFFFFFF
+#define JB_FSCALAR 0x10000000
+#define JB_FOBJECT 0x20000000
+#define JB_FARRAY 0x40000000
+
+#define JsonbContainerSize(jc_) ((jc_)->header & JB_CMASK)
+#define JsonbContainerIsScalar(jc_) (((jc_)->header & JB_FSCALAR) != 0)
+#define JsonbContainerIsObject(jc_) (((jc_)->header & JB_FOBJECT) != 0)
+#define JsonbContainerIsArray(jc_) (((jc_)->header & JB_FARRAY) != 0)
+
+/* the maximum number of elements or pairs in one container */
+#define JSONB_MAX_ELEMS JB_CMASK
+#define JSONB_MAX_PAIRS (JB_CMASK / 2)
+
+typedef struct Jsonb {
+    int32 vl_len_; /* varlena header (do not touch directly!) */
+    JsonbContainer root;
+} Jsonb;
+
+#define DatumGetJsonb(d_) ((Jsonb*)PG_DETOAST_DATUM(d_))
+#define JsonbGetDatum(p_) PointerGetDatum(p_)
+#define PG_GETARG_JSONB(n_) DatumGetJsonb(PG_GETARG_DATUM(n_))
+#define PG_RETURN_JSONB(x_) PG_RETURN_POINTER(x_)
+
+/* GIN strategies */
+#define JsonbContainsStrategyNumber 7
+#define JsonbExistsStrategyNumber 9
+#define JsonbExistsAnyStrategyNumber 10
+#define JsonbExistsAllStrategyNumber 11
+
+/*
+ * In-memory representation of a JSON value, used while building a jsonb
+ * and to hand out the children of a container.  jbvBinary points at a
+ * container inside an existing jsonb.
+ */
+typedef enum JsonbValueType {
+    jbvNull,
+    jbvString,
+    jbvNumeric,
+    jbvBool,
+    jbvArray,
+    jbvObject,
+    jbvBinary
+} JsonbValueType;
+
+typedef struct JsonbPair JsonbPair;
+
+typedef struct JsonbValue {
+    JsonbValueType type;
+    union {
+        Numeric numeric;
+        bool boolean;
+        struct {
+            int len;
+            char* val; /* not null-terminated */
+        } string;
+        struct {
+            int nelems;
+            struct JsonbValue* elems;
+            bool rawScalar; /* top-level scalar wrapped in an array */
+        } array;
+        struct {
+            int npairs;
+            JsonbPair* pairs;
+        } object;
+        struct {
+            int len;
+            JsonbContainer* data;
+        } binary;
+    } val;
+} JsonbValue;
+
+struct JsonbPair {
+    JsonbValue key;   /* always a jbvString */
+    JsonbValue value;
+    uint32 order;     /* position in the input, to keep the last duplicate */
+};
+
+#define IsAJsonbScalar(jbv_) ((jbv_)->type >= jbvNull && (jbv_)->type <= jbvBool)
+
+/* jsonb_util.cpp */
+extern Jsonb* JsonbValueToJsonb(JsonbValue* val);
+extern Jsonb* JsonbContainerToJsonb(const JsonbContainer* container, int len);
+extern void JsonbUniquifyObject(JsonbValue* object);
+extern void JsonbGetIthValue(const JsonbContainer* container, uint32 i, JsonbValue* result);
+extern void JsonbGetIthKey(const JsonbContainer* container, uint32 i, JsonbValue* result);
+extern bool JsonbFindKey(const JsonbContainer* container, const char* key, int keylen, JsonbValue* result);
+extern bool JsonbFindStringElement(const JsonbContainer* container, const char* str, int len);
+extern bool JsonbScalarEquals(const JsonbValue* a, const JsonbValue* b);
+extern bool JsonbContainerEquals(const JsonbContainer* a, const JsonbContainer* b);
+extern bool JsonbDeepContains(const JsonbContainer* val, const JsonbContainer* tmpl);
+extern int JsonbContainerCompare(const JsonbContainer* a, const JsonbContainer* b);
+extern uint32 JsonbContainerHash(const JsonbContainer* container);
+
+/* jsonb.cpp */
+extern Jsonb* JsonbFromCString(char* str, int len);
+extern void JsonbToCString(StringInfo out, const JsonbContainer* container);
+extern void JsonbValueToCString(StringInfo out, const JsonbValue* val);
+
+extern Datum jsonb_in(PG_FUNCTION_ARGS);
+extern Datum jsonb_out(PG_FUNCTION_ARGS);
+extern Datum jsonb_recv(PG_FUNCTION_ARGS);
+extern Datum jsonb_send(PG_FUNCTION_ARGS);
+extern Datum json_to_jsonb(PG_FUNCTION_ARGS);
+extern Datum jsonb_to_json(PG_FUNCTION_ARGS);
+
+/* jsonb_op.cpp */
+extern Datum jsonb_object_field(PG_FUNCTION_ARGS);
+extern Datum jsonb_object_field_text(PG_FUNCTION_ARGS);
+extern Datum jsonb_array_element(PG_FUNCTION_ARGS);
+extern Datum jsonb_array_element_text(PG_FUNCTION_ARGS);
+extern Datum jsonb_extract_path(PG_FUNCTION_ARGS);
+extern Datum jsonb_extract_path_text(PG_FUNCTION_ARGS);
+extern Datum jsonb_exists(PG_FUNCTION_ARGS);
+extern Datum jsonb_exists_any(PG_FUNCTION_ARGS);
+extern Datum jsonb_exists_all(PG_FUNCTION_ARGS);
+extern Datum jsonb_contains(PG_FUNCTION_ARGS);
+extern Datum jsonb_contained(PG_FUNCTION_ARGS);
+extern Datum jsonb_eq(PG_FUNCTION_ARGS);
+extern Datum jsonb_ne(PG_FUNCTION_ARGS);
+extern Datum jsonb_lt(PG_FUNCTION_ARGS);
+extern Datum jsonb_gt(PG_FUNCTION_ARGS);
+extern Datum jsonb_le(PG_FUNCTION_ARGS);
+extern Datum jsonb_ge(PG_FUNCTION_ARGS);
+extern Datum jsonb_cmp(PG_FUNCTION_ARGS);
+extern Datum jsonb_hash(PG_FUNCTION_ARGS);
+
+/* jsonb_gin.cpp */
+extern Datum gin_compare_jsonb(PG_FUNCTION_ARGS);
+extern Datum gin_extract_jsonb(PG_FUNCTION_ARGS);
+extern Datum gin_extract_jsonb_query(PG_FUNCTION_ARGS);
+extern Datum gin_consistent_jsonb(PG_FUNCTION_ARGS);
+extern Datum gin_triconsistent_jsonb(PG_FUNCTION_ARGS);
+extern Datum gin_extract_jsonb_path(PG_FUNCTION_ARGS);
+extern Datum gin_extract_jsonb_query_path(PG_FUNCTION_ARGS);
+extern Datum gin_consistent_jsonb_path(PG_FUNCTION_ARGS);
+extern Datum gin_triconsistent_jsonb_path(PG_FUNCTION_ARGS);
+
+#endif /* JSONB_H */
@@ -182,6 +182,31 @@ typedef struct { /* Scalar or composite variable */
     int lineno;
 } PLpgSQL_variable;
 
+/*
+ * Direct evaluator for the most trivial simple expressions: a variable, a
+ * constant, or one strict immutable built-in function of one or two of
+ * those, e.g. "i + 1" or "n < lim".  It is built from the generic plan of the
+ * expression and bypasses the executor as well as the plan cache lookup.
+ */
+#define PLPGSQL_FAST_EXPR_MAX_ARGS 2
+
+typedef struct PLpgSQL_fast_arg {
+    int dno;        /* variable's datum number, or -1 for a constant */
+    Oid paramtype;  /* type the variable had when the plan was made */
+    Datum constvalue;
+    bool constisnull;
+    bool constbyval;
+} PLpgSQL_fast_arg;
+
+typedef struct PLpgSQL_fast_expr {
+    bool valid;                            /* false if the current plan has no fast form */
+    struct CachedPlanSource* plansource;   /* plan the fast form was built from */
+    int nargs;                             /* 0 means the result is just args[0] */
+    FmgrInfo flinfo;                       /* function to call, if nargs > 0 */
+    Oid inputcollid;                       /* collation the function is called with */
+    PLpgSQL_fast_arg args[PLPGSQL_FAST_EXPR_MAX_ARGS];
+} PLpgSQL_fast_expr;
+
 typedef struct PLpgSQL_expr { /* SQL Query to plan and execute	*/
     int dtype;
     int dno;
@@ -210,6 +235,7 @@ typedef struct PLpgSQL_expr { /* SQL Query to plan and execute	*/
     ExprState* expr_simple_state; /* eval tree for expr_simple_expr */
     bool expr_simple_in_use;      /* true if eval tree is active */
     LocalTransactionId expr_simple_lxid;
+    PLpgSQL_fast_expr* expr_fast; /* direct evaluator, or NULL if never built */
     bool isouttype; /*the parameter will output*/
 } PLpgSQL_expr;
 
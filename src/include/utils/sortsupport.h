@@ -48,6 +48,7 @@
 #define SORTSUPPORT_H
 
 #include "access/attnum.h"
+#include "utils/relcache.h"
 
 typedef struct SortSupportData* SortSupport;
 
@@ -224,5 +225,6 @@ extern int ApplySortComparator(Datum datum1, bool isNull1, Datum datum2, bool is
 /* Other functions in utils/sort/sortsupport.c */
 extern void PrepareSortSupportComparisonShim(Oid cmpFunc, SortSupport ssup);
 extern void PrepareSortSupportFromOrderingOp(Oid orderingOp, SortSupport ssup);
+extern void PrepareSortSupportFromIndexRel(Relation indexRel, int16 strategy, SortSupport ssup);
 
 #endif /* SORTSUPPORT_H */
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * vechashfunc.h
+ *     Column-at-a-time hash kernels for fixed-width join and grouping keys.
+ *
+ * The vectorized hash operators hash one key column of a batch at a time.
+ * For the integer-like types the per-value work is tiny, so calling the
+ * hash support function through fmgr for each value dominates.  The
+ * kernels here recognise those support functions by address and hash the
+ * whole column inline instead.  They produce exactly the values the fmgr
+ * path would, so they can be mixed freely with it (for instance between
+ * the build and probe side of a cross-type hash join, or when spilled rows
+ * are rehashed from cells).
+ *
+ * The loops are written without branches on the data path so that the
+ * compiler can vectorize them.
+ *
+ * IDENTIFICATION
+ *        src/include/vecexecutor/vechashfunc.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef VECHASHFUNC_H_
+#define VECHASHFUNC_H_
+
+#include "access/hash.h"
+#include "utils/date.h"
+#include "utils/timestamp.h"
+#include "vecexecutor/vectorbatch.h"
+
+/*
+ * hash_uint32() in a form the compiler can inline; must give exactly the
+ * same result.
+ */
+static inline uint32 vec_hash_uint32(uint32 k)
+{
+#define VEC_HASH_ROT(x, k) (((x) << (k)) | ((x) >> (32 - (k))))
+    uint32 a;
+    uint32 b;
+    uint32 c;
+
+    a = b = c = 0x9e3779b9 + (uint32)sizeof(uint32) + 3923095;
+    a += k;
+
+    c ^= b;
+    c -= VEC_HASH_ROT(b, 14);
+    a ^= c;
+    a -= VEC_HASH_ROT(c, 11);
+    b ^= a;
+    b -= VEC_HASH_ROT(a, 25);
+    c ^= b;
+    c -= VEC_HASH_ROT(b, 16);
+    a ^= c;
+    a -= VEC_HASH_ROT(c, 4);
+    b ^= a;
+    b -= VEC_HASH_ROT(a, 14);
+    c ^= b;
+    c -= VEC_HASH_ROT(b, 24);
+#undef VEC_HASH_ROT
+
+    return c;
+}
+
+/* the uint32 that each fixed-width hash function passes to hash_uint32() */
+typedef uint32 (*VecHashKeyFunc)(Datum value);
+
+static inline uint32 VecHashKeyInt1(Datum value)
+{
+    return (uint32)(int32)DatumGetUInt8(value);
+}
+
+static inline uint32 VecHashKeyInt2(Datum value)
+{
+    return (uint32)(int32)DatumGetInt16(value);
+}
+
+static inline uint32 VecHashKeyInt4(Datum value)
+{
+    return DatumGetUInt32(value);
+}
+
+static inline uint32 VecHashKeyChar(Datum value)
+{
+    return (uint32)(int32)DatumGetChar(value);
+}
+
+/* see hashint8() for why the high half is folded in this way */
+static inline uint32 VecHashKeyInt8(Datum value)
+{
+    int64 val = DatumGetInt64(value);
+    uint32 lohalf = (uint32)val;
+    uint32 hihalf = (uint32)((uint64)val >> 32);
+
+    lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+    return lohalf;
+}
+
+/*
+ * Hash a column of nval values into res.  For the first key column
+ * (rehash false) a NULL hashes to 0; for later ones the previous value is
+ * rotated left one bit and xor'ed with the new hash, and a NULL leaves it
+ * alone.  This is the combination hashColT and hashGeneralFunc use.
+ */
+template <bool rehash, VecHashKeyFunc keyfn, typename valType, typename resType>
+static inline void VecHashFixedColumn(const valType* vals, const uint8* flags, int nval, resType* res)
+{
+    for (int i = 0; i < nval; i++) {
+        uint32 hashval = vec_hash_uint32(keyfn((Datum)vals[i]));
+        bool notnull = NOT_NULL(flags[i]);
+
+        if (rehash) {
+            uint32 old = (uint32)res[i];
+            res[i] = notnull ? (resType)(((old << 1) | (old >> 31)) ^ hashval) : res[i];
+        } else {
+            res[i] = notnull ? (resType)hashval : 0;
+        }
+    }
+}
+
+/*
+ * Hash a column with the kernel matching hash support function hashfn.
+ * Returns false, doing nothing, if hashfn has no fixed-width kernel and
+ * the caller has to go through fmgr.
+ */
+template <bool rehash, typename valType, typename resType>
+static inline bool VecHashColumnByFunc(
+    PGFunction hashfn, const valType* vals, const uint8* flags, int nval, resType* res)
+{
+    if (hashfn == hashint4 || hashfn == hashoid || hashfn == hashenum) {
+        VecHashFixedColumn<rehash, VecHashKeyInt4>(vals, flags, nval, res);
+    } else if (hashfn == hashint8
+#ifdef HAVE_INT64_TIMESTAMP
+               || hashfn == timestamp_hash || hashfn == time_hash
+#endif
+    ) {
+        VecHashFixedColumn<rehash, VecHashKeyInt8>(vals, flags, nval, res);
+    } else if (hashfn == hashint2) {
+        VecHashFixedColumn<rehash, VecHashKeyInt2>(vals, flags, nval, res);
+    } else if (hashfn == hashint1) {
+        VecHashFixedColumn<rehash, VecHashKeyInt1>(vals, flags, nval, res);
+    } else if (hashfn == hashchar) {
+        VecHashFixedColumn<rehash, VecHashKeyChar>(vals, flags, nval, res);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+#endif /* VECHASHFUNC_H_ */
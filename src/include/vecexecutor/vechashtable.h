@@ -28,6 +28,7 @@
 #include "vecexecutor/vectorbatch.h"
 #include "nodes/execnodes.h"
 #include "access/hash.h"
+#include "vecexecutor/vechashfunc.h"
 #include "storage/buffile.h"
 #include "utils/memutils.h"
 #include "utils/batchsort.h"
@@ -622,10 +623,16 @@ inline void hashBasedOperator::hashBatch(
     ScalarVector* p_vector = batch->m_arr;
     AutoContextSwitch mem_guard(m_tmpContext);
 
-    hashColT<false>(&p_vector[keyIdx[0]], hash_funcs[0].fn_addr, nrows, hash_res);
+    /* fixed-width keys are hashed a column at a time without fmgr */
+    if (!VecHashColumnByFunc<false>(
+        hash_funcs[0].fn_addr, p_vector[keyIdx[0]].m_vals, p_vector[keyIdx[0]].m_flag, nrows, hash_res))
+        hashColT<false>(&p_vector[keyIdx[0]], hash_funcs[0].fn_addr, nrows, hash_res);
 
-    for (i = 1; i < m_key; i++)
-        hashColT<true>(&p_vector[keyIdx[i]], hash_funcs[i].fn_addr, nrows, hash_res);
+    for (i = 1; i < m_key; i++) {
+        if (!VecHashColumnByFunc<true>(
+            hash_funcs[i].fn_addr, p_vector[keyIdx[i]].m_vals, p_vector[keyIdx[i]].m_flag, nrows, hash_res))
+            hashColT<true>(&p_vector[keyIdx[i]], hash_funcs[i].fn_addr, nrows, hash_res);
+    }
 
     /* Rehash the hash value for avoiding the key and distribute key using the same hash function. */
     for (i = 0; i < nrows; i++) {
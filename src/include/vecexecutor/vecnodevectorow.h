@@ -30,6 +30,7 @@
 
 extern VecToRowState* ExecInitVecToRow(VecToRow* node, EState* estate, int eflags);
 extern TupleTableSlot* ExecVecToRow(VecToRowState* node);
+extern int ExecVecToRowBatch(VecToRowState* node);
 extern void ExecEndVecToRow(VecToRowState* node);
 extern void ExecReScanVecToRow(VecToRowState* node);
 
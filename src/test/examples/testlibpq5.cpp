@@ -0,0 +1,181 @@
+/*
+ * src/test/examples/testlibpq5.c
+ *
+ *
+ * testlibpq5.c
+ *		Test ColumnarData ('Y') result messages.
+ *
+ * A connection made with columnar_result=1 gets the binary result of a
+ * vectorized plan as ColumnarData messages, which libpq turns back into
+ * ordinary rows.  This program reads the same column-store table over such
+ * a connection and over a plain one, and checks that
+ *
+ *	- only the connection that asked for it has PQcolumnarResult() set,
+ *	- the server really sent 'Y' messages to it, and none to the other,
+ *	- both results are identical, value by value and NULL by NULL.
+ *
+ * The table spans several batches and has NULLs in every column, so the
+ * fixed-width, variable-width and null bitmap paths are all covered.
+ *
+ * The expected output is:
+ *
+ * columnar result: plain 0, columnar 1
+ * ColumnarData messages: plain no, columnar yes
+ * rows: 2500, columns: 5, results identical
+ */
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include "libpq-fe.h"
+
+#define TEST_QUERY "SELECT i, b, f, d, t FROM test_columnar ORDER BY i"
+
+static void exit_nicely(PGconn* conn1, PGconn* conn2)
+{
+    PQfinish(conn1);
+    PQfinish(conn2);
+    exit(1);
+}
+
+static void exec_command(PGconn* conn, PGconn* other, const char* sql)
+{
+    PGresult* res = PQexec(conn, sql);
+
+    if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+        fprintf(stderr, "%s failed: %s", sql, PQerrorMessage(conn));
+        PQclear(res);
+        exit_nicely(conn, other);
+    }
+    PQclear(res);
+}
+
+/*
+ * Run the test query with binary results, tracing the protocol traffic, and
+ * report whether any ColumnarData message came back.
+ */
+static PGresult* fetch_binary(PGconn* conn, PGconn* other, bool* sawColumnar)
+{
+    FILE* trace = tmpfile();
+    PGresult* res = NULL;
+    char line[256];
+
+    if (trace == NULL) {
+        fprintf(stderr, "could not create trace file\n");
+        exit_nicely(conn, other);
+    }
+
+    PQtrace(conn, trace);
+    res = PQexecParams(conn, TEST_QUERY, 0, NULL, NULL, NULL, NULL, 1);
+    PQuntrace(conn);
+
+    if (PQresultStatus(res) != PGRES_TUPLES_OK) {
+        fprintf(stderr, "SELECT failed: %s", PQerrorMessage(conn));
+        PQclear(res);
+        exit_nicely(conn, other);
+    }
+
+    *sawColumnar = false;
+    rewind(trace);
+    while (fgets(line, sizeof(line), trace) != NULL) {
+        if (strcmp(line, "From backend> Y\n") == 0) {
+            *sawColumnar = true;
+            break;
+        }
+    }
+    fclose(trace);
+
+    return res;
+}
+
+static bool results_identical(const PGresult* res1, const PGresult* res2)
+{
+    int i, j;
+
+    if (PQntuples(res1) != PQntuples(res2) || PQnfields(res1) != PQnfields(res2))
+        return false;
+
+    for (i = 0; i < PQntuples(res1); i++) {
+        for (j = 0; j < PQnfields(res1); j++) {
+            int len = PQgetlength(res1, i, j);
+
+            if (PQgetisnull(res1, i, j) != PQgetisnull(res2, i, j))
+                return false;
+            if (PQgetisnull(res1, i, j))
+                continue;
+            if (len != PQgetlength(res2, i, j) || memcmp(PQgetvalue(res1, i, j), PQgetvalue(res2, i, j), len) != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    const char* conninfo = NULL;
+    char columnarinfo[1024];
+    PGconn* plain = NULL;
+    PGconn* columnar = NULL;
+    PGresult* plainres = NULL;
+    PGresult* columnarres = NULL;
+    bool plainsaw = false;
+    bool columnarsaw = false;
+
+    /*
+     * If the user supplies a parameter on the command line, use it as the
+     * conninfo string; otherwise default to setting dbname=postgres and using
+     * environment variables or defaults for all other connection parameters.
+     */
+    if (argc > 1)
+        conninfo = argv[1];
+    else
+        conninfo = "dbname = postgres";
+    snprintf(columnarinfo, sizeof(columnarinfo), "%s columnar_result=1", conninfo);
+
+    plain = PQconnectdb(conninfo);
+    columnar = PQconnectdb(columnarinfo);
+    if (PQstatus(plain) != CONNECTION_OK || PQstatus(columnar) != CONNECTION_OK) {
+        fprintf(stderr, "Connection to database failed: %s%s", PQerrorMessage(plain), PQerrorMessage(columnar));
+        exit_nicely(plain, columnar);
+    }
+
+    printf("columnar result: plain %d, columnar %d\n", PQcolumnarResult(plain), PQcolumnarResult(columnar));
+
+    exec_command(plain, columnar, "DROP TABLE IF EXISTS test_columnar");
+    exec_command(plain,
+        columnar,
+        "CREATE TABLE test_columnar (i int4, b int8, f float8, d date, t text) WITH (orientation = column)");
+    exec_command(plain,
+        columnar,
+        "INSERT INTO test_columnar SELECT g,"
+        " CASE WHEN g % 7 = 0 THEN NULL ELSE g::int8 * 1000003 END,"
+        " CASE WHEN g % 11 = 0 THEN NULL ELSE g / 3.0 END,"
+        " CASE WHEN g % 13 = 0 THEN NULL ELSE date '2000-01-01' + g END,"
+        " CASE WHEN g % 5 = 0 THEN NULL ELSE repeat('x', g % 17) || g END"
+        " FROM generate_series(1, 2500) g");
+
+    plainres = fetch_binary(plain, columnar, &plainsaw);
+    columnarres = fetch_binary(columnar, plain, &columnarsaw);
+
+    printf("ColumnarData messages: plain %s, columnar %s\n", plainsaw ? "yes" : "no", columnarsaw ? "yes" : "no");
+    printf("rows: %d, columns: %d, results %s\n",
+        PQntuples(columnarres),
+        PQnfields(columnarres),
+        results_identical(plainres, columnarres) ? "identical" : "DIFFER");
+
+    PQclear(plainres);
+    PQclear(columnarres);
+
+    exec_command(plain, columnar, "DROP TABLE test_columnar");
+
+    /* close the connections to the database and cleanup */
+    PQfinish(plain);
+    PQfinish(columnar);
+
+    return 0;
+}
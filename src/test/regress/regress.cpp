@@ -26,9 +26,15 @@
 #include "commands/trigger.h"
 #include "executor/executor.h"
 #include "executor/spi.h"
+#include "port/pg_crc32c.h"
+#include "storage/checksum.h"
+#include "storage/checksum_impl.h"
+#include "storage/sinval.h"
 #include "utils/atomic.h"
 #include "utils/builtins.h"
 #include "utils/geo_decls.h"
+#include "utils/globalplancache.h"
+#include "utils/inval.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
 #include "utils/typcache.h"
@@ -61,6 +67,9 @@ extern "C" Datum vec_int4add_9(PG_FUNCTION_ARGS);
 extern "C" Datum vec_int4add_10(PG_FUNCTION_ARGS);
 extern "C" Datum vec_int4add_11(PG_FUNCTION_ARGS);
 extern Datum make_tuple_indirect(PG_FUNCTION_ARGS);
+extern "C" Datum test_crc32c(PG_FUNCTION_ARGS);
+extern "C" Datum test_checksum_block(PG_FUNCTION_ARGS);
+extern "C" Datum test_sinval_db_filter(PG_FUNCTION_ARGS);
 
 /************c function overload and v0&v1 support***********/
 extern "C" Datum funcA(PG_FUNCTION_ARGS);
@@ -2918,3 +2927,201 @@ Datum complex_send(PG_FUNCTION_ARGS)
     pq_sendfloat8(&buf, complex->y);
     PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
 }
+
+/*
+ * Fill buf with reproducible data that is not all zeroes.
+ */
+static void fill_test_buffer(unsigned char* buf, int len, uint32 seed)
+{
+    for (int i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (unsigned char)(seed >> 16);
+    }
+}
+
+/*
+ * Bit-at-a-time CRC-32C, the reference for whichever implementation
+ * COMP_CRC32C uses.
+ */
+static pg_crc32c crc32c_reference(const unsigned char* data, int len)
+{
+    pg_crc32c crc = 0xFFFFFFFF;
+
+    for (int i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0x82F63B78) : (crc >> 1);
+        }
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+/*
+ * test_crc32c(len) - check COMP_CRC32C over len bytes against the reference,
+ * at every alignment and when the input is fed in two pieces.
+ */
+PG_FUNCTION_INFO_V1(test_crc32c);
+Datum test_crc32c(PG_FUNCTION_ARGS)
+{
+    int32 len = PG_GETARG_INT32(0);
+    unsigned char* buf = NULL;
+    bool result = true;
+
+    if (len < 0)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("length must not be negative")));
+
+    buf = (unsigned char*)palloc(len + 8);
+    fill_test_buffer(buf, len + 8, (uint32)len);
+
+    for (int offset = 0; offset < 8 && result; offset++) {
+        pg_crc32c expected = crc32c_reference(buf + offset, len);
+        pg_crc32c crc;
+        int split = len / 3;
+
+        INIT_CRC32C(crc);
+        COMP_CRC32C(crc, buf + offset, len);
+        FIN_CRC32C(crc);
+        result = EQ_CRC32C(crc, expected);
+
+        INIT_CRC32C(crc);
+        COMP_CRC32C(crc, buf + offset, split);
+        COMP_CRC32C(crc, buf + offset + split, len - split);
+        FIN_CRC32C(crc);
+        result = result && EQ_CRC32C(crc, expected);
+    }
+
+    pfree(buf);
+    PG_RETURN_BOOL(result);
+}
+
+/*
+ * The portable form of pg_checksum_block(), the reference for the vectorized
+ * kernels.
+ */
+static uint32 checksum_block_reference(const uint32* data, uint32 size)
+{
+    uint32 sums[N_SUMS];
+    uint32 result = 0;
+    uint32 i, j;
+
+    for (j = 0; j < N_SUMS; j++)
+        sums[j] = g_checksumBaseOffsets[j];
+
+    for (i = 0; i < size / (sizeof(uint32) * N_SUMS); i++) {
+        for (j = 0; j < N_SUMS; j++)
+            CHECKSUM_COMP(sums[j], data[i * N_SUMS + j]);
+    }
+
+    for (j = 0; j < N_SUMS; j++) {
+        CHECKSUM_COMP(sums[j], 0);
+        CHECKSUM_COMP(sums[j], 0);
+        result ^= sums[j];
+    }
+    return result;
+}
+
+/*
+ * test_checksum_block(size) - check pg_checksum_block() over size bytes, and
+ * pg_checksum_page() when size is BLCKSZ, against the reference.
+ */
+PG_FUNCTION_INFO_V1(test_checksum_block);
+Datum test_checksum_block(PG_FUNCTION_ARGS)
+{
+    int32 size = PG_GETARG_INT32(0);
+    uint32* buf = NULL;
+    bool result = false;
+
+    if (size <= 0 || size % (sizeof(uint32) * N_SUMS) != 0)
+        ereport(ERROR,
+            (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                errmsg("size must be a positive multiple of %d", (int)(sizeof(uint32) * N_SUMS))));
+
+    buf = (uint32*)palloc(size);
+    fill_test_buffer((unsigned char*)buf, size, (uint32)size);
+
+    result = (pg_checksum_block((char*)buf, size) == checksum_block_reference(buf, size));
+
+    if (result && size == BLCKSZ) {
+        PageHeader phdr = (PageHeader)buf;
+        const BlockNumber blkno = 12345;
+        uint32 expected;
+
+        phdr->pd_upper = BLCKSZ;
+        phdr->pd_checksum = 0;
+        expected = (checksum_block_reference(buf, size) ^ blkno) % UINT16_MAX + 1;
+
+        /* the stored checksum must not affect the result */
+        phdr->pd_checksum = 0xFFFF;
+        result = (pg_checksum_page((char*)buf, blkno) == expected);
+    }
+
+    pfree(buf);
+    PG_RETURN_BOOL(result);
+}
+
+/*
+ * Relation OIDs no session can have cached, one per kind of relcache message
+ * test_sinval_db_filter() sends.
+ */
+#define SINVAL_TEST_OTHER_DB_REL ((Oid)0xFFFFFF01)
+#define SINVAL_TEST_MY_DB_REL ((Oid)0xFFFFFF02)
+#define SINVAL_TEST_SHARED_REL ((Oid)0xFFFFFF03)
+
+static THR_LOCAL int sinval_test_seen[3];
+static THR_LOCAL bool sinval_test_reset;
+
+static void sinval_test_inval(SharedInvalidationMessage* msg)
+{
+    if (msg->id == SHAREDINVALRELCACHE_ID && msg->rc.relId >= SINVAL_TEST_OTHER_DB_REL &&
+        msg->rc.relId <= SINVAL_TEST_SHARED_REL)
+        sinval_test_seen[msg->rc.relId - SINVAL_TEST_OTHER_DB_REL]++;
+    LocalExecuteInvalidationMessage(msg);
+}
+
+static void sinval_test_reset_caches(void)
+{
+    sinval_test_reset = true;
+    InvalidateSystemCaches();
+}
+
+/*
+ * test_sinval_db_filter() - queue relcache invalidations for another database,
+ * for this one and for a shared relation, and check that reading the queue
+ * hands this session only the last two.  The global plan cache reads every
+ * message, so nothing is filtered while it is enabled.
+ */
+PG_FUNCTION_INFO_V1(test_sinval_db_filter);
+Datum test_sinval_db_filter(PG_FUNCTION_ARGS)
+{
+    SharedInvalidationMessage msgs[3];
+    Oid myDatabaseId = u_sess->proc_cxt.MyDatabaseId;
+    int i;
+    errno_t rc;
+
+    rc = memset_s(msgs, sizeof(msgs), 0, sizeof(msgs));
+    securec_check(rc, "\0", "\0");
+    for (i = 0; i < 3; i++) {
+        msgs[i].rc.id = SHAREDINVALRELCACHE_ID;
+        msgs[i].rc.relId = SINVAL_TEST_OTHER_DB_REL + i;
+    }
+    msgs[0].rc.dbId = (myDatabaseId == (Oid)0xFFFFFFFE) ? (Oid)0xFFFFFFFD : (Oid)0xFFFFFFFE;
+    msgs[1].rc.dbId = myDatabaseId;
+    msgs[2].rc.dbId = InvalidOid;
+
+    /* get rid of anything already queued for us */
+    AcceptInvalidationMessages();
+
+    for (i = 0; i < 3; i++)
+        sinval_test_seen[i] = 0;
+    sinval_test_reset = false;
+
+    SendSharedInvalidMessages(msgs, 3);
+    ReceiveSharedInvalidMessages(sinval_test_inval, sinval_test_reset_caches);
+
+    /* a queue overflow throws away the messages; that is not a filtering failure */
+    if (sinval_test_reset)
+        PG_RETURN_BOOL(true);
+
+    PG_RETURN_BOOL(sinval_test_seen[0] == (ENABLE_DN_GPC ? 1 : 0) && sinval_test_seen[1] == 1 &&
+                   sinval_test_seen[2] == 1);
+}
@@ -0,0 +1,52 @@
+--
+-- B-tree index builds with abbreviated keys
+--
+-- text and numeric keys that mostly agree in their leading bytes, NULLs,
+-- and a share of values with distinct prefixes
+CREATE TABLE abk (id int, t text, n numeric, n2 numeric);
+INSERT INTO abk SELECT i, CASE WHEN i % 97 = 0 THEN NULL ELSE 'common prefix ' || (i % 7) || ' tail ' || (i * 7919 % 20000) END,
+    1234567.89 + (i % 50) * 0.000001, 123456789012345678 + i * 0.0000000001 FROM generate_series(1, 20000) i;
+INSERT INTO abk SELECT 20000 + i, md5(i::text), -i, -i FROM generate_series(1, 2000) i;
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SET enable_sort = off;
+
+-- each index must hand back its rows in the order the full comparator wants
+CREATE INDEX abk_t ON abk (t);
+EXPLAIN (COSTS OFF) SELECT id, t FROM abk ORDER BY t;
+SELECT count(*), count(t), sum(CASE WHEN (pt IS NULL AND pid IS NOT NULL AND t IS NOT NULL) OR pt > t THEN 1 ELSE 0 END) AS disorder
+FROM (SELECT id, t, lag(t) OVER () AS pt, lag(id) OVER () AS pid FROM (SELECT id, t FROM abk ORDER BY t) s) x;
+DROP INDEX abk_t;
+
+CREATE INDEX abk_t_desc ON abk (t DESC NULLS FIRST);
+EXPLAIN (COSTS OFF) SELECT id, t FROM abk ORDER BY t DESC NULLS FIRST;
+SELECT count(*), count(t), sum(CASE WHEN (t IS NULL AND pt IS NOT NULL) OR pt < t THEN 1 ELSE 0 END) AS disorder
+FROM (SELECT id, t, lag(t) OVER () AS pt FROM (SELECT id, t FROM abk ORDER BY t DESC NULLS FIRST) s) x;
+DROP INDEX abk_t_desc;
+
+CREATE INDEX abk_n ON abk (n DESC, id);
+EXPLAIN (COSTS OFF) SELECT id, n FROM abk ORDER BY n DESC, id;
+SELECT count(*), count(DISTINCT n), sum(CASE WHEN pn < n OR (pn = n AND pid > id) THEN 1 ELSE 0 END) AS disorder
+FROM (SELECT id, n, lag(n) OVER () AS pn, lag(id) OVER () AS pid FROM (SELECT id, n FROM abk ORDER BY n DESC, id) s) x;
+SELECT id, n FROM abk WHERE n = 1234567.890049 ORDER BY n DESC, id LIMIT 3;
+DROP INDEX abk_n;
+
+-- keys that are equal when abbreviated are not duplicates
+CREATE UNIQUE INDEX abk_u_t ON abk (t);
+CREATE UNIQUE INDEX abk_u_n2 ON abk (n2 DESC NULLS FIRST);
+\set VERBOSITY terse
+CREATE UNIQUE INDEX abk_u_n ON abk (n);
+\set VERBOSITY default
+-- a single duplicate among many near-duplicates is still found
+DROP INDEX abk_u_t;
+INSERT INTO abk SELECT 30000, t, 0, 0 FROM abk WHERE id = 4242;
+CREATE UNIQUE INDEX abk_u_t ON abk (t);
+CREATE UNIQUE INDEX abk_u_t ON abk (t DESC);
+DELETE FROM abk WHERE id = 30000;
+CREATE UNIQUE INDEX abk_u_t ON abk (t);
+SELECT id, t FROM abk WHERE t = 'common prefix 0 tail 12398';
+
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+RESET enable_sort;
+DROP TABLE abk;
@@ -0,0 +1,68 @@
+--
+-- Hash-bucket scans: buckets chosen at run time, and SMP scans split by bucket
+--
+CREATE TABLE hb_t (k int, v int) WITH (hashbucket = on) DISTRIBUTE BY HASH(k);
+CREATE INDEX hb_t_k ON hb_t (k);
+INSERT INTO hb_t SELECT i % 1000, i FROM generate_series(1, 20000) i;
+ANALYZE hb_t;
+-- outer keys: a repeated key, a change of bucket, keys with no rows and NULL
+CREATE TABLE hb_o (id int, k int) DISTRIBUTE BY REPLICATION;
+INSERT INTO hb_o VALUES (1, 5), (2, 5), (3, 17), (4, 999), (5, 123456), (6, NULL), (7, 5), (8, -1), (9, 0);
+ANALYZE hb_o;
+
+-- the bucket lines of a plan, whatever its shape
+CREATE FUNCTION hb_buckets(query text) RETURNS SETOF text LANGUAGE plpgsql AS $$
+DECLARE
+    ln text;
+BEGIN
+    FOR ln IN EXECUTE 'EXPLAIN (COSTS OFF) ' || query LOOP
+        IF ln LIKE '%Selected Buckets%' THEN
+            RETURN NEXT trim(ln);
+        END IF;
+    END LOOP;
+END;
+$$;
+
+-- nestloop inner scans rescanned with the bucket of each outer key
+SET enable_hashjoin = off;
+SET enable_mergejoin = off;
+SET enable_material = off;
+SELECT hb_buckets('SELECT * FROM hb_o o LEFT JOIN hb_t t ON t.k = o.k');
+SELECT o.id, count(t.v), sum(t.v) FROM hb_o o LEFT JOIN hb_t t ON t.k = o.k GROUP BY o.id ORDER BY o.id;
+SELECT o.id, count(t.k) FROM hb_o o LEFT JOIN hb_t t ON t.k = o.k AND t.k < 100 GROUP BY o.id ORDER BY o.id;
+SET enable_indexscan = off;
+SELECT o.id, count(t.k) FROM hb_o o LEFT JOIN hb_t t ON t.k = o.k GROUP BY o.id ORDER BY o.id;
+RESET enable_indexscan;
+RESET enable_hashjoin;
+RESET enable_mergejoin;
+RESET enable_material;
+
+-- an external parameter selects the bucket when the generic plan starts
+SET plan_cache_mode = force_generic_plan;
+PREPARE hb_q(int) AS SELECT count(*), sum(v) FROM hb_t WHERE k = $1;
+SELECT hb_buckets('EXECUTE hb_q(5)');
+EXECUTE hb_q(5);
+EXECUTE hb_q(17);
+EXECUTE hb_q(999);
+EXECUTE hb_q(123456);
+EXECUTE hb_q(NULL);
+SET enable_indexscan = off;
+SET enable_bitmapscan = off;
+EXECUTE hb_q(5);
+EXECUTE hb_q(0);
+RESET enable_indexscan;
+RESET enable_bitmapscan;
+DEALLOCATE hb_q;
+RESET plan_cache_mode;
+
+-- SMP threads split the buckets, and every row is read exactly once
+SET query_dop = 4;
+SELECT hb_buckets('SELECT * FROM hb_t');
+SELECT count(*), count(DISTINCT v), sum(v), min(v), max(v) FROM hb_t;
+SELECT k, count(*) FROM hb_t GROUP BY k HAVING count(*) <> 20;
+SELECT count(*) FROM (SELECT v FROM hb_t EXCEPT ALL SELECT generate_series(1, 20000)) d;
+RESET query_dop;
+
+DROP FUNCTION hb_buckets(text);
+DROP TABLE hb_o;
+DROP TABLE hb_t;
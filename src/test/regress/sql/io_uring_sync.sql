@@ -0,0 +1,50 @@
+--
+-- Immediate syncs of new relation files, with io_uring and without
+--
+CREATE TABLESPACE iou_ts RELATIVE LOCATION 'tablespace/iou_ts';
+CREATE TABLE iou_t (id int, t text);
+INSERT INTO iou_t SELECT i, md5(i::text) FROM generate_series(1, 50000) i;
+CREATE UNLOGGED TABLE iou_u (id int, t text);
+INSERT INTO iou_u SELECT * FROM iou_t;
+
+-- the reference results, from the heap
+SELECT count(*), sum(id) FROM iou_t WHERE t < '1';
+SELECT count(*), sum(id) FROM iou_t WHERE t >= 'ff' AND t < 'ff8';
+
+-- index builds sync the index before commit; an unlogged index syncs its init fork
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SET enable_io_uring = off;
+CREATE INDEX iou_t_t ON iou_t (t);
+CREATE INDEX iou_u_t ON iou_u (t);
+SELECT count(*), sum(id) FROM iou_t WHERE t < '1';
+SELECT count(*), sum(id) FROM iou_u WHERE t >= 'ff' AND t < 'ff8';
+DROP INDEX iou_t_t;
+DROP INDEX iou_u_t;
+SET enable_io_uring = on;
+CREATE INDEX iou_t_t ON iou_t (t);
+CREATE INDEX iou_u_t ON iou_u (t);
+SELECT count(*), sum(id) FROM iou_t WHERE t < '1';
+SELECT count(*), sum(id) FROM iou_u WHERE t >= 'ff' AND t < 'ff8';
+
+-- SET TABLESPACE copies every fork and syncs the copies
+ALTER TABLE iou_t SET TABLESPACE iou_ts;
+ALTER INDEX iou_t_t SET TABLESPACE iou_ts;
+ALTER TABLE iou_u SET TABLESPACE iou_ts;
+SELECT count(*), sum(id) FROM iou_t WHERE t < '1';
+SELECT count(*), sum(id) FROM iou_u WHERE t >= 'ff' AND t < 'ff8';
+SET enable_io_uring = off;
+ALTER TABLE iou_t SET TABLESPACE pg_default;
+ALTER INDEX iou_t_t SET TABLESPACE pg_default;
+ALTER TABLE iou_u SET TABLESPACE pg_default;
+SELECT count(*), sum(id) FROM iou_t WHERE t < '1';
+SELECT count(*), sum(id) FROM iou_u WHERE t >= 'ff' AND t < 'ff8';
+RESET enable_io_uring;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+SELECT count(*), sum(id) FROM iou_t WHERE t < '1';
+SELECT count(*), sum(id) FROM iou_u WHERE t >= 'ff' AND t < 'ff8';
+
+DROP TABLE iou_t;
+DROP TABLE iou_u;
+DROP TABLESPACE iou_ts;
@@ -0,0 +1,86 @@
+--
+-- JSONB
+--
+-- input and output
+SELECT '{"b": 1, "aa": [1, 2.50, "x"], "a": null}'::jsonb;
+SELECT '{"a": 1, "a": 2}'::jsonb;
+SELECT '  [true, false, null, "A\n"]  '::jsonb;
+SELECT '"scalar"'::jsonb, '-1.5'::jsonb, '{}'::jsonb, '[]'::jsonb;
+SELECT '{"a": 1,}'::jsonb;
+SELECT '{"b": [1, {"c": "d"}]}'::json::jsonb, '{"b": [1, {"c": "d"}]}'::jsonb::json;
+
+-- accessors
+SELECT '{"a": {"b": [1, 2]}}'::jsonb -> 'a', '{"a": {"b": [1, 2]}}'::jsonb ->> 'a';
+SELECT '[1, "two", null]'::jsonb -> 1, '[1, "two", null]'::jsonb ->> 1, ('[1, "two", null]'::jsonb ->> 2) IS NULL;
+SELECT '{"a": {"b": [1, 2]}}'::jsonb #> '{a,b,1}', '{"a": {"b": [1, 2]}}'::jsonb #>> '{a,b}';
+SELECT ('{"a": 1}'::jsonb -> 'z') IS NULL, ('[1]'::jsonb -> 5) IS NULL;
+
+-- existence and containment
+SELECT '{"a": 1, "b": 2}'::jsonb ? 'b', '["a", "b"]'::jsonb ?| '{x,a}', '{"a": 1}'::jsonb ?& '{a,b}';
+SELECT '{"a": 1, "b": [1, 2, 3]}'::jsonb @> '{"b": [3, 1]}', '{"a": 1}'::jsonb <@ '{"a": 1, "b": 2}',
+       '[1, [2, 3]]'::jsonb @> '[[3]]', '{"a": 1}'::jsonb @> '{"a": 2}';
+
+-- equality, ordering and hashing
+SELECT '{"a": 1, "b": 2}'::jsonb = '{"b": 2, "a": 1.00}', '[1, 2]'::jsonb = '[2, 1]', '"a"'::jsonb <> '["a"]';
+SELECT j FROM (VALUES ('{"a": 1}'::jsonb), ('[1, 2]'), ('null'), ('true'), ('"str"'), ('10'), ('{}'), ('[]'),
+       ('2.5'), ('{"a": 0, "b": 1}')) v(j) ORDER BY j;
+SELECT jsonb_hash('1'::jsonb) = jsonb_hash('1.00'::jsonb), jsonb_hash('{"a": [1, 2]}') = jsonb_hash('{"a": [1.0, 2]}');
+
+CREATE TABLE testjsonb (id int, j jsonb);
+INSERT INTO testjsonb VALUES
+    (1, '{"a": 1, "b": "x"}'),
+    (2, '{"a": 2, "tags": ["red", "blue"]}'),
+    (3, '{"a": 1, "c": {"d": true}}'),
+    (4, '["a", "b"]'),
+    (5, '{"b": "y"}'),
+    (6, '"a"'),
+    (7, '{"a": 1.0}');
+
+SET enable_sort = off;
+SELECT count(*) FROM (SELECT DISTINCT j FROM (SELECT j FROM testjsonb UNION ALL SELECT '{"a": 1}') u) s;
+RESET enable_sort;
+SET enable_mergejoin = off;
+SET enable_nestloop = off;
+SELECT count(*) FROM testjsonb a JOIN testjsonb b ON a.j = b.j;
+RESET enable_mergejoin;
+RESET enable_nestloop;
+
+-- btree
+CREATE INDEX testjsonb_btree ON testjsonb USING btree (j);
+SET enable_seqscan = off;
+SELECT id FROM testjsonb WHERE j = '{"a": 1}';
+SELECT id FROM testjsonb WHERE j > '{"a": 1}' ORDER BY id;
+RESET enable_seqscan;
+DROP INDEX testjsonb_btree;
+
+-- GIN jsonb_ops
+SELECT count(*) FROM testjsonb WHERE j @> '{"a": 1}';
+SELECT count(*) FROM testjsonb WHERE j ? 'a';
+SELECT count(*) FROM testjsonb WHERE j ?| '{b,tags}';
+SELECT count(*) FROM testjsonb WHERE j ?& '{a,b}';
+SELECT count(*) FROM testjsonb WHERE j @> '{"c": {"d": true}}';
+SELECT count(*) FROM testjsonb WHERE j @> '{"tags": ["blue"]}';
+SELECT count(*) FROM testjsonb WHERE j @> '["a"]';
+
+CREATE INDEX testjsonb_gin ON testjsonb USING gin (j);
+SET enable_seqscan = off;
+SELECT count(*) FROM testjsonb WHERE j @> '{"a": 1}';
+SELECT count(*) FROM testjsonb WHERE j ? 'a';
+SELECT count(*) FROM testjsonb WHERE j ?| '{b,tags}';
+SELECT count(*) FROM testjsonb WHERE j ?& '{a,b}';
+SELECT count(*) FROM testjsonb WHERE j @> '{"c": {"d": true}}';
+SELECT count(*) FROM testjsonb WHERE j @> '{"tags": ["blue"]}';
+SELECT count(*) FROM testjsonb WHERE j @> '["a"]';
+RESET enable_seqscan;
+DROP INDEX testjsonb_gin;
+
+-- GIN jsonb_path_ops
+CREATE INDEX testjsonb_gin_path ON testjsonb USING gin (j jsonb_path_ops);
+SET enable_seqscan = off;
+SELECT count(*) FROM testjsonb WHERE j @> '{"a": 1}';
+SELECT count(*) FROM testjsonb WHERE j @> '{"c": {"d": true}}';
+SELECT count(*) FROM testjsonb WHERE j @> '{"tags": ["blue"]}';
+SELECT count(*) FROM testjsonb WHERE j @> '["a"]';
+RESET enable_seqscan;
+
+DROP TABLE testjsonb;
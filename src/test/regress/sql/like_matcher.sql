@@ -0,0 +1,52 @@
+--
+-- LIKE with compiled literal patterns and with the interpreter
+--
+-- an empty string is not NULL here, so ESCAPE '' means no escape character
+CREATE DATABASE like_pg DBCOMPATIBILITY 'PG';
+\c like_pg
+CREATE TABLE like_t (id int, s text, p text, m bool);
+INSERT INTO like_t VALUES
+    (1, 'abc', 'abc', true), (2, 'abc', 'ab', false), (3, 'abcd', 'abc', false),
+    (4, 'abc', 'a%', true), (5, 'abc', '%c', true), (6, 'abc', '%b%', true),
+    (7, 'abc', '%d%', false), (8, 'abc', 'a%c', true), (9, 'ac', 'a%c', true),
+    (10, 'a', 'a%a', false), (11, 'aa', 'a%a', true), (12, 'abcabc', '%bc%bc', true),
+    (13, 'abcab', '%bc%bc', false), (14, 'xabcx', '%%abc%%', true), (15, '', '%', true),
+    (16, '', '', true), (17, 'x', '', false), (18, 'abc', '_b_', true),
+    (19, 'ab', '_b_', false), (20, 'äbc', '_bc', true), (21, 'äbc', '__bc', false),
+    (22, 'a€b', 'a_b', true), (23, 'a€b', '%€%', true), (24, 'a€b', '%€', false),
+    (25, 'a%b', 'a\%b', true), (26, 'axb', 'a\%b', false), (27, 'a_b', 'a\_b', true),
+    (28, 'axb', 'a\_b', false), (29, 'a\b', 'a\\b', true), (30, 'ab%', '%\%', true),
+    (31, 'abc', '%\%', false), (32, 'abc', 'abc%', true), (33, 'ab', 'abc%', false);
+
+-- the pattern changes from row to row, so the cached matcher is rebuilt
+SELECT id, s, p, s LIKE p AS "like", s NOT LIKE p AS not_like, upper(s) ILIKE p AS ilike
+FROM like_t ORDER BY id;
+SELECT id FROM like_t WHERE (s LIKE p) IS DISTINCT FROM m OR (s NOT LIKE p) IS DISTINCT FROM NOT m;
+-- the same pattern for every row
+SELECT id FROM like_t WHERE s LIKE '%b%' ORDER BY id;
+SELECT id FROM like_t WHERE s NOT LIKE 'a%' ORDER BY id;
+SELECT id FROM like_t WHERE s LIKE '%b' ORDER BY id;
+SELECT id FROM like_t WHERE s LIKE 'abc' ORDER BY id;
+SELECT id FROM like_t WHERE s ILIKE 'A%C' ORDER BY id;
+SELECT id FROM like_t WHERE s LIKE '_€_' ORDER BY id;
+
+-- the vector engine
+CREATE TABLE like_c (id int, s text, p text, m bool) WITH (orientation = column);
+INSERT INTO like_c SELECT * FROM like_t;
+SELECT id FROM like_c WHERE (s LIKE p) IS DISTINCT FROM m OR (s NOT LIKE p) IS DISTINCT FROM NOT m;
+SELECT id FROM like_c WHERE s LIKE '%b%' ORDER BY id;
+SELECT id FROM like_c WHERE s NOT LIKE 'a%' ORDER BY id;
+
+-- explicit escape characters
+SELECT 'a%b' LIKE 'a#%b' ESCAPE '#' AS t1, 'axb' LIKE 'a#%b' ESCAPE '#' AS f1,
+    'a#b' LIKE 'a##b' ESCAPE '#' AS t2, 'a\b' LIKE 'a\b' ESCAPE '' AS t3,
+    'a\xb' LIKE 'a\%' ESCAPE '' AS t4, 'a%' LIKE 'a\%' ESCAPE '' AS f2,
+    'a_b' LIKE 'a_b' ESCAPE '' AS t5, 'A%B' ILIKE 'a#%b' ESCAPE '#' AS t6;
+SELECT 'abcd' LIKE 'abc\';
+SELECT 'abc' LIKE 'ab#' ESCAPE '#';
+SELECT 'abc' LIKE 'abc' ESCAPE 'ab';
+
+DROP TABLE like_c;
+DROP TABLE like_t;
+\c regression
+DROP DATABASE like_pg;
@@ -0,0 +1,41 @@
+--
+-- sum() and avg() of numeric on the row and vector engines
+--
+CREATE TABLE numsum_row (id int, g int, x numeric);
+INSERT INTO numsum_row SELECT i, i % 3, i * 1.25 - 400 FROM generate_series(1, 1000) i;
+-- a NULL, a value too long for the scaled-integer path, a high scale and NaN
+INSERT INTO numsum_row VALUES (1001, 0, NULL), (1002, 1, 12345678901234567890.123),
+    (1003, 2, 0.000000000000000001), (1004, 3, 'NaN'), (1005, 3, 1);
+CREATE TABLE numsum_col (id int, g int, x numeric) WITH (orientation = column);
+INSERT INTO numsum_col SELECT * FROM numsum_row;
+
+-- row engine
+SELECT g, sum(x), avg(x), count(x) FROM numsum_row GROUP BY g ORDER BY g;
+SELECT sum(x), avg(x) FROM numsum_row WHERE g < 3;
+SELECT DISTINCT g, sum(x) OVER (PARTITION BY g) FROM numsum_row ORDER BY g;
+
+SET enable_fast_numeric = off;
+SELECT g, sum(x), avg(x), count(x) FROM numsum_row GROUP BY g ORDER BY g;
+RESET enable_fast_numeric;
+
+-- vector engine: sonic hash, hash and sort aggregation, plain and window
+SET enable_sonic_hashagg = on;
+SELECT g, sum(x), avg(x), count(x) FROM numsum_col GROUP BY g ORDER BY g;
+SET enable_sonic_hashagg = off;
+SELECT g, sum(x), avg(x), count(x) FROM numsum_col GROUP BY g ORDER BY g;
+RESET enable_sonic_hashagg;
+SET enable_hashagg = off;
+SELECT g, sum(x), avg(x), count(x) FROM numsum_col GROUP BY g ORDER BY g;
+RESET enable_hashagg;
+SELECT sum(x), avg(x) FROM numsum_col WHERE g < 3;
+SELECT DISTINCT g, sum(x) OVER (PARTITION BY g) FROM numsum_col ORDER BY g;
+
+-- a sum that overflows int128 on the way continues as a plain numeric
+CREATE TABLE numsum_big (id int, x numeric);
+INSERT INTO numsum_big SELECT i, 999999999999999999 FROM generate_series(1, 1000) i;
+INSERT INTO numsum_big VALUES (1001, 0.000000000000000001), (1002, -999999999999999999);
+SELECT sum(x ORDER BY id), avg(x ORDER BY id) FROM numsum_big;
+
+DROP TABLE numsum_row;
+DROP TABLE numsum_col;
+DROP TABLE numsum_big;
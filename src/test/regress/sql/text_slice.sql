@@ -0,0 +1,35 @@
+--
+-- left() and substr() on values fetched and decompressed only in part
+--
+CREATE TABLE text_slice (id int, c text, e text);
+ALTER TABLE text_slice ALTER COLUMN c SET (toast_compression = pglz);
+ALTER TABLE text_slice ALTER COLUMN e SET STORAGE EXTERNAL;
+-- compressed inline, compressed out of line, and the same with multibyte
+-- characters, down to a value made only of characters of the maximum length
+INSERT INTO text_slice SELECT 1, v, v FROM repeat('abcdefgh', 1000) v;
+INSERT INTO text_slice SELECT 2, v, v FROM (SELECT string_agg(repeat(md5(i::text), 4), '') v FROM generate_series(1, 500) i) s;
+INSERT INTO text_slice SELECT 3, v, v FROM repeat('äx€y𝄞z', 1500) v;
+INSERT INTO text_slice SELECT 4, v, v FROM (SELECT string_agg(repeat(md5(i::text) || 'ä€𝄞', 4), '') v FROM generate_series(1, 500) i) s;
+INSERT INTO text_slice SELECT 5, v, v FROM repeat('𝄞', 3000) v;
+SELECT id, pg_column_size(c) < octet_length(c) AS compressed, pg_column_size(e) = octet_length(e) AS plain_external
+FROM text_slice ORDER BY id;
+
+-- compare with the same values detoasted in full
+SELECT id, n FROM text_slice,
+    (VALUES (-100000), (-3001), (-1), (0), (1), (2), (3), (7), (1000), (2999), (3000), (3001), (8999), (9000), (9001), (100000)) v(n)
+WHERE left(c, n) IS DISTINCT FROM left(c || '', n) OR left(e, n) IS DISTINCT FROM left(e || '', n);
+SELECT id, s, n FROM text_slice,
+    (VALUES (-5), (0), (1), (2), (1000), (2999), (3000), (8999), (64000), (200000)) v1(s),
+    (VALUES (0), (1), (3), (1000), (3000), (100000)) v2(n)
+WHERE substr(c, s, n) IS DISTINCT FROM substr(c || '', s, n) OR substr(e, s, n) IS DISTINCT FROM substr(e || '', s, n);
+SELECT id, n FROM text_slice, (VALUES (1), (2), (3), (1000), (2999), (3000), (3001), (100000)) v(n)
+WHERE substr(c, 1 + n) IS DISTINCT FROM substr(c || '', 1 + n) OR substr(e, 1 + n) IS DISTINCT FROM substr(e || '', 1 + n);
+
+-- n characters fetched as n * max-encoding-length bytes are n characters
+SELECT id, length(left(c, 3000)) = least(3000, length(c)) AS c_ok, length(left(e, 3000)) = least(3000, length(e)) AS e_ok,
+    left(c, 3000) || substr(c, 3001) = c AS c_whole, left(e, 3000) || substr(e, 3001) = e AS e_whole
+FROM text_slice ORDER BY id;
+SELECT left(c, 4) = '𝄞𝄞𝄞𝄞' AS max_length, right(left(c, 3000), 1) = '𝄞' AS last FROM text_slice WHERE id = 5;
+SELECT left(c, 6) = 'äx€y𝄞z' AS mixed, substr(c, 5, 3) = '𝄞zä' AS inner_slice FROM text_slice WHERE id = 3;
+
+DROP TABLE text_slice;
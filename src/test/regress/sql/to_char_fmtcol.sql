@@ -0,0 +1,38 @@
+--
+-- to_char(), to_timestamp() and to_date() with a format that changes per row
+--
+CREATE TABLE tcf (id int, ts timestamp, fmt text);
+INSERT INTO tcf VALUES
+    (1, '2023-04-05 16:07:08.123456', 'YYYY-MM-DD'),
+    (2, '2023-04-05 16:07:08.123456', 'HH24:MI:SS'),
+    (3, '2023-04-05 16:07:08.123456', 'YYYY-MM-DD'),
+    (4, '2023-04-05 16:07:08.123456', 'DD/MM/YY HH12 AM'),
+    (5, '2023-04-05 16:07:08.123456', 'FMMonth DD, YYYY'),
+    (6, '2023-04-05 16:07:08.123456', 'Day'),
+    (7, '2023-04-05 16:07:08.123456', 'MS US'),
+    (8, '2023-04-05 16:07:08.123456', 'Q WW DDD'),
+    (9, '2023-04-05 16:07:08.123456', '"quoted" YYYY'),
+    (10, '1999-12-31 23:59:59', 'YYYY-MM-DD'),
+    (11, '1999-12-31 23:59:59', 'HH24:MI:SS'),
+    (12, '2023-04-05 16:07:08.123456', 'Mon DD YYYY HH24:MI:SS.MS'),
+    (13, '2023-04-05 16:07:08.123456', NULL),
+    (14, '2023-04-05 16:07:08.123456', 'YYYY-MM-DD');
+SELECT id, to_char(ts, fmt) FROM tcf ORDER BY id;
+-- the same format on every row, then the per-row one again
+SELECT id, to_char(ts, 'YYYY-MM-DD') FROM tcf WHERE id IN (1, 10) ORDER BY id;
+SELECT id, to_char(ts::timestamptz, fmt) FROM tcf WHERE id IN (1, 2, 10, 11) ORDER BY id;
+SELECT to_char(iv, f) FROM (VALUES (1, interval '1 day 02:03:04', 'HH24:MI:SS'), (2, interval '1 day 02:03:04', 'DD "days"'),
+    (3, interval '3 hours', 'HH24')) v(id, iv, f) ORDER BY id;
+
+CREATE TABLE tts (id int, s text, fmt text);
+INSERT INTO tts VALUES
+    (1, '2023-04-05 16:07:08', 'YYYY-MM-DD HH24:MI:SS'),
+    (2, '05/04/2023', 'DD/MM/YYYY'),
+    (3, '20230405', 'YYYYMMDD'),
+    (4, '16:07 2023-04-05', 'HH24:MI YYYY-MM-DD'),
+    (5, '2023-04-05 16:07:08', 'YYYY-MM-DD HH24:MI:SS');
+SELECT id, to_char(to_timestamp(s, fmt), 'YYYY-MM-DD HH24:MI:SS') FROM tts ORDER BY id;
+SELECT id, to_char(to_date(s, fmt), 'YYYY-MM-DD') FROM tts ORDER BY id;
+
+DROP TABLE tts;
+DROP TABLE tcf;
@@ -0,0 +1,38 @@
+--
+-- TOAST compression methods
+--
+CREATE TABLE toast_cmp (id int, t text);
+ALTER TABLE toast_cmp ALTER COLUMN t SET (toast_compression = zstd);
+
+-- one column holding values written with each method
+ALTER TABLE toast_cmp ALTER COLUMN t SET (toast_compression = lz4);
+INSERT INTO toast_cmp VALUES (1, repeat('lz4 data ', 2000));
+ALTER TABLE toast_cmp ALTER COLUMN t SET (toast_compression = pglz);
+INSERT INTO toast_cmp VALUES (2, repeat('pglz data ', 2000));
+ALTER TABLE toast_cmp ALTER COLUMN t RESET (toast_compression);
+SET default_toast_compression = lz4;
+INSERT INTO toast_cmp VALUES (3, repeat('default lz4 ', 2000));
+RESET default_toast_compression;
+INSERT INTO toast_cmp VALUES (4, repeat('default pglz ', 2000));
+SELECT id, length(t), pg_column_size(t) < length(t) AS compressed, substr(t, 1, 11) FROM toast_cmp ORDER BY id;
+SELECT id FROM toast_cmp WHERE t = repeat('lz4 data ', 2000) OR t = repeat('pglz data ', 2000) ORDER BY id;
+
+-- slices of lz4 values
+SELECT substr(t, 8992, 8) FROM toast_cmp WHERE id = 1;
+
+-- updated values are compressed again with the column's current method
+UPDATE toast_cmp SET t = t || 'x' WHERE id IN (1, 2);
+SELECT id, length(t), right(t, 3) FROM toast_cmp WHERE id IN (1, 2) ORDER BY id;
+
+-- index tuples compress with the method of the indexed column
+CREATE TABLE toast_idx (t text);
+ALTER TABLE toast_idx ALTER COLUMN t SET (toast_compression = lz4);
+CREATE INDEX toast_idx_t ON toast_idx (t);
+INSERT INTO toast_idx VALUES (repeat('abc', 500)), (repeat('xyz', 500));
+SET enable_seqscan = off;
+SELECT count(*) FROM toast_idx WHERE t = repeat('abc', 500);
+SELECT length(t) FROM toast_idx WHERE t > repeat('abc', 500);
+RESET enable_seqscan;
+
+DROP TABLE toast_idx;
+DROP TABLE toast_cmp;